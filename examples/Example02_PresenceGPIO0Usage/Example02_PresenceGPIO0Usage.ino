@@ -4,8 +4,9 @@
   Using the Acconeer XM125 A121 60GHz Pulsed Coherent Radar Sensor.
 
   This example shows how operate the XM125 when the device is in Presence Reading Mode.
-  The sensor is initialized, then the presence values will print out to the terminal
-  and trigger the GPIO0 pin high when there is a presence detected.
+  The sensor is initialized and drives the GPIO0 pin high while there is a presence detected.
+  The GPIO0 pin is wired to a host interrupt pin, and the presence values are only read
+  and printed out when the pin changes - the I2C bus stays idle while nothing changes.
 
   By: Madison Chodikov
   SparkFun Electronics
@@ -15,6 +16,7 @@
 
   Hardware Connections:
   QWIIC --> QWIIC
+  XM125 GPIO0 --> XM125_GPIO_PIN (an interrupt capable pin)
 
   Serial.print it out at 115200 baud to serial monitor.
 
@@ -29,18 +31,31 @@ SparkFunXM125Presence radarSensor;
 // I2C default address
 uint8_t i2cAddress = SFE_XM125_I2C_ADDRESS;
 
-// Presence distance values
-uint32_t distance = 0;
-uint32_t presenceDetected = 0;
-uint32_t presenceDetectedSticky = 0;
-uint32_t startVal = 0;
-uint32_t endVal = 0;
-uint32_t gpioUsage = 0;
+// Host pin wired to the XM125 GPIO0 pin - must support interrupts
+#define XM125_GPIO_PIN 2
 
-// Error statuses
-uint32_t errorStatus = 0;
-uint32_t busyError = 0;
-uint32_t presValError = 0;
+// Presence range in mm used
+#define MY_XM125_RANGE_START 500
+#define MY_XM125_RANGE_END 5000
+
+// Called by serviceEvents() each time the GPIO0 pin changes
+void onPresenceEvent(const sfe_xm125_presence_frame_t &frame, void *user)
+{
+    if (frame.detector_error)
+    {
+        Serial.println("Presence detector error");
+        return;
+    }
+
+    if (frame.detected)
+    {
+        Serial.print("Presence Detected: ");
+        Serial.print(frame.distance);
+        Serial.println("mm");
+    }
+    else
+        Serial.println("No Presence");
+}
 
 void setup()
 {
@@ -52,97 +67,41 @@ void setup()
     Wire.begin();
 
     // If begin is successful (0), then start example
-    int startErr = radarSensor.begin(i2cAddress, Wire);
-    if (startErr == 1)
+    if (radarSensor.begin(i2cAddress, Wire) == true)
     {
         Serial.println("Begin");
     }
     else // Otherwise, infinite loop
     {
-        Serial.print("Start Error Code: ");
-        Serial.println(startErr);
         Serial.println("Device failed to setup - Freezing code.");
         while (1)
             ; // Runs forever
     }
 
-    delay(200);
-
-    // Presence Sensor Setup
-    // Reset sensor configuration to reapply configuration registers
-    radarSensor.setCommand(SFE_XM125_PRESENCE_RESET_MODULE);
-
-    // Check error and busy bits
-    radarSensor.getDetectorErrorStatus(errorStatus);
-    if (errorStatus != 0)
+    // Start and calibrate the detector
+    int32_t setupError = radarSensor.detectorStart(MY_XM125_RANGE_START, MY_XM125_RANGE_END);
+    if (setupError != 0)
     {
-        Serial.print("Detector status error: ");
-        Serial.println(errorStatus);
+        Serial.print("Presence Detection Start Setup Error: ");
+        Serial.println(setupError);
     }
 
-    delay(100);
-
-    // Turn presence detection on GPIO0 on
-    if (radarSensor.setDetectionOnGPIO(1) != 0)
+    // Turn presence detection on GPIO0 on and report its changes
+    if (!radarSensor.beginGPIOEvents(XM125_GPIO_PIN, onPresenceEvent))
     {
         Serial.println("GPIO0 Pin Setup Error");
     }
-    radarSensor.getDetectionOnGPIO(gpioUsage);
-    Serial.print("GPIO0 Detection Status: ");
-    Serial.println(gpioUsage);
-
-    // Apply configuration
-    if (radarSensor.setCommand(SFE_XM125_PRESENCE_APPLY_CONFIGURATION) != 0)
-    {
-        // Check for errors
-        radarSensor.getDetectorErrorStatus(errorStatus);
-        if (errorStatus != 0)
-        {
-            Serial.print("Detector status error: ");
-            Serial.println(errorStatus);
-        }
-
-        Serial.println("Configuration application error");
-    }
-
-    // Poll detector status until busy bit is cleared
-    if (radarSensor.busyWait() != 0)
-    {
-        Serial.print("Busy wait error");
-    }
-
-    // Check detector status
-    radarSensor.getDetectorErrorStatus(errorStatus);
-    if (errorStatus != 0)
-    {
-        Serial.print("Detector status error: ");
-        Serial.println(errorStatus);
-    }
 
     Serial.println();
-
-    delay(1000);
 }
 
 void loop()
 {
-    // Busy wait loop until data is ready
-    radarSensor.busyWait();
-
-    // Get the presence distance value and print out if no errors
-    presValError = radarSensor.getDistanceValuemm(distance);
-
-    if (presValError == 0)
-    {
-        Serial.print("Presence Detected: ");
-        Serial.print(distance);
-        Serial.println("mm");
-    }
-    else
+    // Reads the presence values only when the GPIO0 pin has changed
+    if (radarSensor.serviceEvents() != 0)
     {
-        Serial.println("Error returning presence distance value");
+        Serial.println("Error returning presence values");
     }
 
-    // Delay 0.5 seconds between readings
-    delay(500);
+    // Other work can be done here - the sensor is not polled
 }
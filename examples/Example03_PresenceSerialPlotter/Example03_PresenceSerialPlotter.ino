@@ -7,6 +7,9 @@
   The sensor is initialized, then the presence values will print out to the terminal and
   the serial monitor.
 
+  The detector is started once in streaming mode, and a value is plotted each time
+  the detector completes a frame - at the full detector frame rate.
+
   By: Madison Chodikov
   SparkFun Electronics
   Date: 2024/1/22
@@ -29,17 +32,8 @@ SparkFunXM125Presence radarSensor;
 // I2C default address
 uint8_t i2cAddress = SFE_XM125_I2C_ADDRESS;
 
-// Presence distance values
-uint32_t distance = 0;
-uint32_t presenceDetected = 0;
-uint32_t presenceDetectedSticky = 0;
-uint32_t startVal = 0;
-uint32_t endVal = 0;
-
-// Error statuses
-uint32_t errorStatus = 0;
-uint32_t busyError = 0;
-uint32_t presValError = 0;
+// Presence frame values
+sfe_xm125_presence_frame_t frame;
 
 void setup()
 {
@@ -75,6 +69,12 @@ void setup()
         Serial.println(setupError);
     }
 
+    // Start continuous measurements - frames are collected in loop()
+    if (radarSensor.startStreaming() != ksfTkErrOk)
+    {
+        Serial.println("Presence Detection Streaming Start Error");
+    }
+
     // New line and delay for easier reading
     Serial.println();
     delay(500);
@@ -82,18 +82,14 @@ void setup()
 
 void loop()
 {
-    // Busy wait loop until data is ready
-    radarSensor.busyWait();
-
-    // Get the presence distance value and print out if no errors
-    presValError = radarSensor.getDistanceValuemm(distance);
-
-    if (presValError == 0)
-    {
-        radarSensor.getDistance(distance);
-        Serial.println(distance);
-    }
-
-    // Delay 0.5 seconds between readings
-    delay(500);
+    // Only plot when the detector has produced a new frame
+    bool newFrame = false;
+    if (radarSensor.readStream(frame, newFrame) != ksfTkErrOk || !newFrame)
+        return;
+
+    // Plot the presence distance, or zero if no presence is detected
+    if (frame.detected || frame.detected_sticky)
+        Serial.println(frame.distance);
+    else
+        Serial.println(0);
 }
@@ -99,17 +99,17 @@ void loop()
         Serial.println(numDistances);
     }
 
-    uint32_t distance = 0;
-    int32_t distanceStrength = 0;
+    // Read all the peak distances and strengths in one transaction
+    sfe_xm125_distance_peaks_t peaks;
+    if (numDistances > 0 && radarSensor.readPeaks(peaks) != ksfTkErrOk)
+    {
+        Serial.println("Error retrieving Distance Peaks");
+        numDistances = 0;
+    }
+
     for (uint32_t i = 0; i < numDistances; i++)
     {
-        if (radarSensor.getPeakDistance(i, distance) != ksfTkErrOk)
-        {
-            Serial.print("Error retrieving Distance Peak ");
-            Serial.print(i);
-            Serial.println();
-            continue;
-        }
+        uint32_t distance = peaks.distance[i];
         Serial.print("   Distance Peak ");
         Serial.print(i);
         Serial.print(": ");
@@ -129,17 +129,10 @@ void loop()
             Serial.print("m");
         }
 
-        if (radarSensor.getPeakStrength(i, distanceStrength) != ksfTkErrOk)
-        {
-            Serial.print("Error retrieving Distance Peak Strength");
-            Serial.print(i);
-            Serial.println();
-            continue;
-        }
         Serial.print("     Distance Peak Strength ");
         Serial.print(i);
         Serial.print(": ");
-        Serial.println(distanceStrength);
+        Serial.println(peaks.strength[i]);
     }
 
     // delay before next reading
@@ -6,6 +6,11 @@
   This example prints out the distance values of the 0 distance
   channels to the serial plotter tool in Arduino.
 
+  Each measurement is started, then checked with pollFrame(), which reads the
+  detector status and the result in as few I2C transactions as possible.
+  A calibration supervisor checks each frame and recalibrates the sensor
+  between measurements when it asks for it or the temperature drifts.
+
   By: Madison Chodikov
   SparkFun Electronics
   Date: 2024/1/22
@@ -28,8 +33,14 @@ SparkFunXM125Distance radarSensor;
 // I2C default address
 uint8_t i2cAddress = SFE_XM125_I2C_ADDRESS;
 
-// Error statuses
-uint32_t distanceSetupError = 0;
+// Measurement poll state - kept between measurements
+sfe_xm125_distance_poll_t poll = {};
+
+// Recalibrates the sensor when needed
+sfDevXM125CalibrationSupervisor calibration;
+
+// Longest time to wait for a measurement, in ms
+#define MY_XM125_MEASURE_TIMEOUT 1000
 
 // Distance Variables
 uint32_t distancePeak0 = 0;
@@ -62,6 +73,9 @@ void setup()
         Serial.println(setupError);
     }
 
+    // Supervise the calibration from the first frame on
+    calibration.begin(&radarSensor);
+
     // New-line and 0.5 second delay for easier reading
     Serial.println();
     delay(500);
@@ -69,20 +83,54 @@ void setup()
 
 void loop()
 {
-    distanceSetupError = radarSensor.detectorReadingSetup();
-    if (distanceSetupError != 0)
+    // Finish a scheduled recalibration before the next measurement
+    sfTkError_t calError = calibration.service();
+    if (calError == ksfTkErrXM125Busy)
+    {
+        delay(2);
+        return;
+    }
+    else if (calError != ksfTkErrOk)
     {
-        Serial.print("Distance Reading Setup Error: ");
-        Serial.println(distanceSetupError);
+        Serial.print("Recalibration Error: ");
+        Serial.println(calError);
+        delay(500);
+        return;
     }
 
-    // Read PeakX Distance and PeakX Strength registers for the number of distances detected
-    radarSensor.getPeak0Distance(distancePeak0);
+    // Start a measurement
+    if (radarSensor.start() != ksfTkErrOk)
+    {
+        Serial.println("Distance Start Error");
+        delay(500);
+        return;
+    }
+
+    // Wait for it to finish - each check reads the status, and the result once it is ready
+    uint32_t startMs = millis();
+    sfTkError_t retVal;
+    do
+    {
+        delay(2);
+        retVal = radarSensor.pollFrame(poll);
+    } while (retVal == ksfTkErrOk && !poll.ready && millis() - startMs < MY_XM125_MEASURE_TIMEOUT);
 
-    // If a peak distance was detected, then read out the distance and strength
-    if (distancePeak0 != 0)
+    if (retVal != ksfTkErrOk || !poll.ready)
+    {
+        Serial.print("Distance Reading Error: ");
+        Serial.println(retVal);
+    }
+    else
     {
-        Serial.println(distancePeak0);
+        // Check the calibration flag and temperature - a recalibration runs before the next measurement
+        calibration.update(poll);
+
+        // Read the Peak0 Distance register only when a valid peak was detected
+        if (!(poll.flags & SFE_XM125_DISTANCE_FRAME_CALIBRATION_NEEDED) && poll.num_distances > 0)
+        {
+            radarSensor.getPeak0Distance(distancePeak0);
+            Serial.println(distancePeak0);
+        }
     }
 
     // Half a second delay for easier readings
@@ -0,0 +1,241 @@
+/*
+  Example 10: Bus Benchmark
+
+  Using the Acconeer XM125 A121 60GHz Pulsed Coherent Radar Sensor.
+
+  This example measures the I2C bus cost of the standard library flows - distanceSetup(),
+  detectorReadingSetup(), the Example 6 and Example 9 peak loops and the presence
+  getDistanceValuemm() - and prints one CSV line per flow, so the bus cost can be compared
+  between library versions.
+
+  By default the flows run against the simulated XM125 in the library, so no module is needed.
+  The simulator runs twice: with realistic module timing ("sim"), and with all module delays set
+  to zero and status based waits ("sim-0"), where the wall time is the CPU time spent in the
+  library. Set BENCH_USE_SIMULATOR to 0 to measure a module connected to Wire instead.
+
+  Output columns, all per frame except frames and errors:
+    flow, mode, frames, transactions, bytes, wall_us, bus_us, max_bus_us, errors
+
+  SparkFun code, firmware, and software is released under the MIT License.
+    Please see LICENSE.md for further details.
+
+  Hardware Connections:
+  None when using the simulator, otherwise QWIIC --> QWIIC
+
+  Serial.print it out at 115200 baud to serial monitor.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/ - Qwiic XM125 Breakout
+*/
+#include "SparkFun_Qwiic_XM125_Arduino_Library.h"
+#include "sfTk/sfDevXM125Sim.h"
+#include <Arduino.h>
+
+// 1 - run against the simulated module, 0 - run against a module on Wire
+#define BENCH_USE_SIMULATOR 1
+
+// With a module connected, the application it runs - XM125_SIM_DISTANCE or XM125_SIM_PRESENCE
+#define BENCH_MODULE_APP XM125_SIM_DISTANCE
+
+// Measurements per flow - setup flows run fewer times
+#define BENCH_FRAMES 20
+#define BENCH_SETUP_FRAMES 3
+
+// How the library waits on the module - XM125_WAIT_FIXED_DELAY or XM125_WAIT_STATUS
+#define BENCH_WAIT_MODE XM125_WAIT_FIXED_DELAY
+
+// Objects seen by the simulated distance detector
+const uint32_t simDistances[] = {820, 1450, 2300};
+const int32_t simStrengths[] = {12000, 8000, 3000};
+
+sfDevXM125Sim distanceSim(XM125_SIM_DISTANCE);
+sfDevXM125Sim presenceSim(XM125_SIM_PRESENCE);
+sfTkArdI2C i2cBus;
+
+// All transfers go through the monitor, which counts them
+SparkFunXM125BusMonitor monitor;
+
+sfDevXM125Distance distanceSensor;
+sfDevXM125Presence presenceSensor;
+
+typedef int32_t (*benchFlow_t)(void);
+
+int32_t flowDistanceSetup()
+{
+    return distanceSensor.distanceSetup();
+}
+
+int32_t flowReadingSetup()
+{
+    return distanceSensor.detectorReadingSetup();
+}
+
+// The Example 6 loop - measure, then read all peaks in one transaction
+int32_t flowPeakBurst()
+{
+    int32_t retVal = distanceSensor.detectorReadingSetup();
+
+    uint32_t numDistances = 0;
+    distanceSensor.getNumberDistances(numDistances);
+
+    sfe_xm125_distance_peaks_t peaks;
+    if (numDistances > 0)
+        distanceSensor.readPeaks(peaks);
+
+    return retVal;
+}
+
+// The Example 9 loop - measure, then read each peak register on its own
+int32_t flowPeakSingle()
+{
+    int32_t retVal = distanceSensor.detectorReadingSetup();
+
+    uint32_t distance;
+    int32_t strength;
+    distanceSensor.getPeak0Distance(distance);
+    distanceSensor.getPeak0Strength(strength);
+    distanceSensor.getPeak1Distance(distance);
+    distanceSensor.getPeak1Strength(strength);
+    distanceSensor.getPeak2Distance(distance);
+    distanceSensor.getPeak2Strength(strength);
+    distanceSensor.getPeak3Distance(distance);
+    distanceSensor.getPeak3Strength(strength);
+    distanceSensor.getPeak4Distance(distance);
+    distanceSensor.getPeak4Strength(strength);
+    distanceSensor.getPeak5Distance(distance);
+    distanceSensor.getPeak5Strength(strength);
+    distanceSensor.getPeak6Distance(distance);
+    distanceSensor.getPeak6Strength(strength);
+    distanceSensor.getPeak7Distance(distance);
+    distanceSensor.getPeak7Strength(strength);
+    distanceSensor.getPeak8Distance(distance);
+    distanceSensor.getPeak8Strength(strength);
+    distanceSensor.getPeak9Distance(distance);
+    distanceSensor.getPeak9Strength(strength);
+
+    return retVal;
+}
+
+int32_t flowPresenceSetup()
+{
+    return presenceSensor.detectorStart();
+}
+
+int32_t flowPresenceDistance()
+{
+    uint32_t distance = 0;
+    return presenceSensor.getDistanceValuemm(distance);
+}
+
+// Runs a flow and prints its CSV line
+void runFlow(const char *name, const char *mode, benchFlow_t flow, uint32_t frames)
+{
+    uint32_t errors = 0;
+    sfe_xm125_bus_stats_t stats;
+
+    monitor.reset();
+
+    uint32_t startUs = micros();
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        if (flow() != 0)
+            errors++;
+    }
+    uint32_t wallUs = micros() - startUs;
+
+    monitor.snapshot(stats);
+
+    Serial.print(name);
+    Serial.print(",");
+    Serial.print(mode);
+    Serial.print(",");
+    Serial.print(frames);
+    Serial.print(",");
+    Serial.print((stats.reads + stats.writes) / frames);
+    Serial.print(",");
+    Serial.print((stats.bytesRead + stats.bytesWritten) / frames);
+    Serial.print(",");
+    Serial.print(wallUs / frames);
+    Serial.print(",");
+    Serial.print(stats.latency.totalUs / frames);
+    Serial.print(",");
+    Serial.print(stats.latency.maxUs);
+    Serial.print(",");
+    Serial.println(errors);
+}
+
+void runDistanceFlows(const char *mode, sfe_xm125_wait_mode_t waitMode)
+{
+    if (distanceSensor.begin(&monitor) != ksfTkErrOk)
+    {
+        Serial.println("# distance begin failed");
+        return;
+    }
+    distanceSensor.setWaitMode(waitMode);
+
+    runFlow("distanceSetup", mode, flowDistanceSetup, BENCH_SETUP_FRAMES);
+    runFlow("detectorReadingSetup", mode, flowReadingSetup, BENCH_FRAMES);
+    runFlow("peakLoopBurst", mode, flowPeakBurst, BENCH_FRAMES);
+    runFlow("peakLoopSingle", mode, flowPeakSingle, BENCH_FRAMES);
+}
+
+void runPresenceFlows(const char *mode, sfe_xm125_wait_mode_t waitMode)
+{
+    if (presenceSensor.begin(&monitor) != ksfTkErrOk)
+    {
+        Serial.println("# presence begin failed");
+        return;
+    }
+    presenceSensor.setWaitMode(waitMode);
+
+    runFlow("presenceDetectorStart", mode, flowPresenceSetup, BENCH_SETUP_FRAMES);
+    runFlow("getDistanceValuemm", mode, flowPresenceDistance, BENCH_FRAMES);
+}
+
+void runSimulator(const char *mode, const sfe_xm125_sim_timing_t &timing, sfe_xm125_wait_mode_t waitMode)
+{
+    distanceSim.powerOn();
+    distanceSim.setTiming(timing);
+    monitor.init(&distanceSim);
+    runDistanceFlows(mode, waitMode);
+
+    presenceSim.powerOn();
+    presenceSim.setTiming(timing);
+    monitor.init(&presenceSim);
+    runPresenceFlows(mode, waitMode);
+}
+
+void setup()
+{
+    // Start serial
+    Serial.begin(115200);
+    Serial.println("# XM125 Example 10: Bus Benchmark");
+    Serial.println("flow,mode,frames,transactions,bytes,wall_us,bus_us,max_bus_us,errors");
+
+#if BENCH_USE_SIMULATOR
+    distanceSim.setTargets(simDistances, simStrengths, sizeof(simDistances) / sizeof(simDistances[0]));
+    presenceSim.setPresence(true, 1200, 2500, 1800);
+
+    runSimulator("sim", SFE_XM125_SIM_TIMING_DEFAULT, BENCH_WAIT_MODE);
+
+    const sfe_xm125_sim_timing_t noDelay = {0, 0, 0, 0, 0, 0};
+    runSimulator("sim-0", noDelay, XM125_WAIT_STATUS);
+#else
+    Wire.begin();
+    i2cBus.init(Wire, SFE_XM125_I2C_ADDRESS);
+    monitor.init(&i2cBus);
+
+    if (BENCH_MODULE_APP == XM125_SIM_DISTANCE)
+        runDistanceFlows("module", BENCH_WAIT_MODE);
+    else
+        runPresenceFlows("module", BENCH_WAIT_MODE);
+#endif
+
+    Serial.println("# done");
+}
+
+void loop()
+{
+    // The benchmark runs once
+    delay(1000);
+}
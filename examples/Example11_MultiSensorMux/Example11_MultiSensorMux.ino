@@ -0,0 +1,135 @@
+/*
+  Example 11: Multi Sensor Mux
+
+  Using the Acconeer XM125 A121 60GHz Pulsed Coherent Radar Sensor.
+
+  This example runs several XM125 modules in Distance Reading Mode, all at the default I2C
+  address, behind a Qwiic Mux (TCA9548A). Each module is given the bus of its mux channel, which
+  switches the mux before each transfer. The manager keeps all modules measuring at the same time:
+  each module is read out and started again as soon as it has finished, while the others are still
+  measuring.
+
+  SparkFun code, firmware, and software is released under the MIT License.
+    Please see LICENSE.md for further details.
+
+  Hardware Connections:
+  QWIIC --> Qwiic Mux, one XM125 on each of the first NUM_SENSORS mux channels
+
+  Serial.print it out at 115200 baud to serial monitor.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/ - Qwiic XM125 Breakout
+*/
+#include "SparkFun_Qwiic_XM125_Arduino_Library.h"
+#include <Arduino.h>
+
+// Number of modules, on mux channels 0 to NUM_SENSORS - 1
+#define NUM_SENSORS 4
+
+// Distance range in mm used - 500mm to 5000mm (0.5 M to 5 M)
+#define MY_XM125_RANGE_START 500
+#define MY_XM125_RANGE_END 5000
+
+// Approximate time of one distance measurement - the manager does not poll a module before this
+#define MY_XM125_MEASURE_MS 20
+
+sfTkArdI2C muxBus;
+sfTkArdI2C sensorBus;
+
+sfDevXM125Mux mux;
+sfDevXM125MuxChannel channels[NUM_SENSORS];
+
+sfDevXM125Manager<SparkFunXM125Distance, NUM_SENSORS> radars;
+
+// Called by the manager for each module that has finished a measurement
+void printDistance(uint8_t index, SparkFunXM125Distance &radar, void *user)
+{
+    (void)user;
+
+    uint32_t numDistances = 0;
+    radar.getNumberDistances(numDistances);
+
+    Serial.print("Sensor ");
+    Serial.print(index);
+    Serial.print(": ");
+
+    if (numDistances == 0)
+    {
+        Serial.println("no object");
+        return;
+    }
+
+    uint32_t distance = 0;
+    radar.getPeak0Distance(distance);
+    Serial.print(distance);
+    Serial.println("mm");
+}
+
+void setup()
+{
+    // Start serial
+    Serial.begin(115200);
+    Serial.println("XM125 Example 11: Multi Sensor Mux");
+    Serial.println("");
+
+    Wire.begin();
+
+    // The mux and the modules share Wire, at their own addresses
+    muxBus.init(Wire, SFE_XM125_MUX_I2C_ADDRESS);
+    sensorBus.init(Wire, SFE_XM125_I2C_ADDRESS);
+
+    if (mux.init(&muxBus) != ksfTkErrOk)
+    {
+        Serial.println("Mux not found, check wiring. Freezing...");
+        while (1)
+            ;
+    }
+
+    for (uint8_t ch = 0; ch < NUM_SENSORS; ch++)
+    {
+        channels[ch].init(&mux, ch, &sensorBus);
+
+        uint8_t index;
+        if (radars.addSensor(&channels[ch], index) != ksfTkErrOk)
+        {
+            Serial.print("Sensor on mux channel ");
+            Serial.print(ch);
+            Serial.println(" not found, check wiring. Freezing...");
+            while (1)
+                ;
+        }
+
+        SparkFunXM125Distance &radar = radars.sensor(index);
+        radar.setWaitMode(XM125_WAIT_STATUS);
+
+        if (radar.distanceSetup(MY_XM125_RANGE_START, MY_XM125_RANGE_END) != 0)
+        {
+            Serial.print("Distance setup failed on sensor ");
+            Serial.print(index);
+            Serial.println(". Freezing...");
+            while (1)
+                ;
+        }
+    }
+
+    radars.startAll(MY_XM125_MEASURE_MS);
+}
+
+void loop()
+{
+    // Read out the modules that are done and start their next measurement
+    radars.service(printDistance);
+
+    // Restart any module whose measurement failed
+    for (uint8_t i = 0; i < radars.count(); i++)
+    {
+        if (!radars.running(i))
+        {
+            Serial.print("Sensor ");
+            Serial.print(i);
+            Serial.print(" error ");
+            Serial.println(radars.lastError(i));
+            radars.start(i, MY_XM125_MEASURE_MS);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/*
+  Example 12: Distance Binary Stream
+
+  Using the Acconeer XM125 A121 60GHz Pulsed Coherent Radar Sensor.
+
+  This example streams distance frames over the serial port as compact binary packets instead of
+  text. A frame with a few peaks takes around 15 - 30 bytes instead of a few hundred characters, so
+  the serial link keeps up with fast measurement rates. The packet format is described in
+  sfDevXM125Packet.h.
+
+  The output is not readable in the serial monitor - decode it on the host with the tool in
+  tools/xm125_decode, for example:
+
+      stty -F /dev/ttyACM0 921600 raw && xm125_decode < /dev/ttyACM0
+
+  SparkFun code, firmware, and software is released under the MIT License.
+    Please see LICENSE.md for further details.
+
+  Hardware Connections:
+  QWIIC --> QWIIC
+
+  Serial binary output at 921600 baud.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/ - Qwiic XM125 Breakout
+*/
+#include "SparkFun_Qwiic_XM125_Arduino_Library.h"
+#include <Arduino.h>
+
+SparkFunXM125Distance radarSensor;
+
+// I2C default address
+uint8_t i2cAddress = SFE_XM125_I2C_ADDRESS;
+
+// Distance range in mm used - 500mm to 5000mm (0.5 M to 5 M)
+#define MY_XM125_RANGE_START 500
+#define MY_XM125_RANGE_END 5000
+
+sfe_xm125_distance_frame_t frame;
+uint8_t packet[SFE_XM125_PACKET_DISTANCE_MAX_PACKET];
+
+void setup()
+{
+    // Start serial - no text is printed once streaming starts, so the host only sees packets
+    Serial.begin(921600);
+
+    Wire.begin();
+
+    if (radarSensor.begin(i2cAddress, Wire) == false)
+    {
+        Serial.println("Device failed to setup - Freezing code.");
+        while (1)
+            ; // Runs forever
+    }
+
+    // Start the sensor with the specified range values
+    if (radarSensor.distanceSetup(MY_XM125_RANGE_START, MY_XM125_RANGE_END) != 0)
+    {
+        Serial.println("Distance Detection Start Setup Error - Freezing code.");
+        while (1)
+            ; // Runs forever
+    }
+}
+
+void loop()
+{
+    // Measure, then read the whole result in one burst
+    if (radarSensor.detectorReadingSetup() != ksfTkErrOk)
+        return;
+
+    if (radarSensor.readFrame(frame) != ksfTkErrOk)
+        return;
+
+    size_t length = sfDevXM125PacketEncoder::encode(frame, packet, sizeof(packet));
+    if (length > 0)
+        Serial.write(packet, length);
+}
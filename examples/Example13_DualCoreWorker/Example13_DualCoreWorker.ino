@@ -0,0 +1,154 @@
+/*
+  Example 13: Dual Core Worker
+
+  Using the Acconeer XM125 A121 60GHz Pulsed Coherent Radar Sensor.
+
+  This example splits the work between the two cores of an ESP32 or RP2040. One core runs the
+  acquisition loop - it is the only one to use the I2C bus and spends most of its time waiting for
+  measurements. The other core runs the application in loop() and takes the frames from the worker
+  without locks or waiting, so a slow measurement never stalls it.
+
+  The application prints every frame from the queue, and once a second the newest frame from the
+  snapshot. On boards with a single core - including the ESP32-S2 and ESP32-C3 - the acquisition
+  runs from loop() instead.
+
+  SparkFun code, firmware, and software is released under the MIT License.
+    Please see LICENSE.md for further details.
+
+  Hardware Connections:
+  QWIIC --> QWIIC
+
+  Serial.print it out at 115200 baud to serial monitor.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/ - Qwiic XM125 Breakout
+*/
+#include "SparkFun_Qwiic_XM125_Arduino_Library.h"
+#include <Arduino.h>
+
+SparkFunXM125Distance radarSensor;
+
+// I2C default address
+uint8_t i2cAddress = SFE_XM125_I2C_ADDRESS;
+
+// Distance range in mm used - 500mm to 5000mm (0.5 M to 5 M)
+#define MY_XM125_RANGE_START 500
+#define MY_XM125_RANGE_END 5000
+
+// Publishes distance frames through a queue of 8 frames and a snapshot of the newest one
+sfDevXM125Worker<sfDevXM125Distance, sfe_xm125_distance_frame_t, 8> worker;
+
+// Set once the sensor is set up and the acquisition can run
+sfDevXM125Atomic<uint8_t> sensorReady;
+
+uint32_t lastSnapshotMs = 0;
+
+// ESP32 parts with two cores run the acquisition in a task on the core that does not run loop()
+#if defined(ARDUINO_ARCH_ESP32) && !CONFIG_FREERTOS_UNICORE
+#define ACQUIRE_IN_TASK 1
+#else
+#define ACQUIRE_IN_TASK 0
+#endif
+
+// Cleared once another core runs the acquisition
+bool acquireInLoop = true;
+
+#if ACQUIRE_IN_TASK
+// Acquisition task, on the core that does not run loop()
+void acquireTask(void *parameter)
+{
+    (void)parameter;
+
+    for (;;)
+        worker.acquire();
+}
+#endif
+
+#if defined(ARDUINO_ARCH_RP2040)
+// The second core of the RP2040 runs setup1() and loop1()
+void setup1()
+{
+    while (!sensorReady.load())
+        delay(1);
+}
+
+void loop1()
+{
+    worker.acquire();
+}
+#endif
+
+void setup()
+{
+    // Start serial
+    Serial.begin(115200);
+    Serial.println("XM125 Example 13: Dual Core Worker");
+    Serial.println("");
+
+    Wire.begin();
+
+    if (radarSensor.begin(i2cAddress, Wire) == false)
+    {
+        Serial.println("Device failed to setup - Freezing code.");
+        while (1)
+            ; // Runs forever
+    }
+
+    if (radarSensor.distanceSetup(MY_XM125_RANGE_START, MY_XM125_RANGE_END) != 0)
+    {
+        Serial.println("Distance Detection Start Setup Error - Freezing code.");
+        while (1)
+            ; // Runs forever
+    }
+
+    // From here on only the worker uses the sensor
+    worker.init(radarSensor);
+    sensorReady.store(1);
+
+#if ACQUIRE_IN_TASK
+    if (xTaskCreatePinnedToCore(acquireTask, "xm125", 4096, nullptr, 1, nullptr, 1 - ARDUINO_RUNNING_CORE) == pdPASS)
+        acquireInLoop = false;
+    else
+        Serial.println("Acquisition task not created - acquiring from loop()");
+#elif defined(ARDUINO_ARCH_RP2040)
+    acquireInLoop = false;
+#endif
+}
+
+void loop()
+{
+    // Single core - acquire here
+    if (acquireInLoop)
+        worker.acquire();
+
+    // Every frame, in order
+    sfe_xm125_distance_frame_t frame;
+    while (worker.pop(frame))
+    {
+        Serial.print("Frame ");
+        Serial.print(frame.measure_counter);
+        Serial.print(": ");
+        if (frame.num_peaks == 0)
+            Serial.println("no object");
+        else
+        {
+            Serial.print(frame.distance[0]);
+            Serial.println("mm");
+        }
+    }
+
+    // Only the newest frame, once a second
+    if (millis() - lastSnapshotMs >= 1000)
+    {
+        lastSnapshotMs = millis();
+        if (worker.latest(frame))
+        {
+            Serial.print("Newest frame ");
+            Serial.print(frame.measure_counter);
+            Serial.print(", frames dropped: ");
+            Serial.print(worker.dropped());
+            Serial.print(", errors: ");
+            Serial.println(worker.errors());
+        }
+    }
+}
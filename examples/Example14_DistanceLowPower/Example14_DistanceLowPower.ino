@@ -0,0 +1,137 @@
+/*
+  Example 14: Distance Low Power
+
+  Using the Acconeer XM125 A121 60GHz Pulsed Coherent Radar Sensor.
+
+  This example measures once every 10 seconds and keeps the sensor in hibernation in between. The
+  distance detector is set up once with measure on wakeup enabled; each cycle raises the WAKE_UP
+  pin, waits for the measurement on the MCU_INT pin, reads the frame in two I2C transfers and
+  lowers WAKE_UP again.
+
+  After each frame the example prints the awake time and the I2C transfers of the cycle. Replace
+  the delay in hostSleep() with the sleep mode of your board to save power on the host as well.
+
+  SparkFun code, firmware, and software is released under the MIT License.
+    Please see LICENSE.md for further details.
+
+  Hardware Connections:
+  QWIIC --> QWIIC
+  WAKE_UP --> MY_XM125_WAKE_UP_PIN
+  MCU_INT --> MY_XM125_MCU_INT_PIN
+
+  Serial.print it out at 115200 baud to serial monitor.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/ - Qwiic XM125 Breakout
+*/
+#include "SparkFun_Qwiic_XM125_Arduino_Library.h"
+#include <Arduino.h>
+
+SparkFunXM125Distance radarSensor;
+
+// I2C default address
+uint8_t i2cAddress = SFE_XM125_I2C_ADDRESS;
+
+// Pins connected to the WAKE_UP and MCU_INT pins of the sensor
+#define MY_XM125_WAKE_UP_PIN 2
+#define MY_XM125_MCU_INT_PIN 3
+
+// Distance range in mm used - 500mm to 5000mm (0.5 M to 5 M)
+#define MY_XM125_RANGE_START 500
+#define MY_XM125_RANGE_END 5000
+
+// Time between measurements in ms
+#define MY_XM125_PERIOD 10000
+
+// Runs the wake, read, hibernate cycles
+sfDevXM125LowPower lowPower;
+
+void setWakeUpPin(bool level, void *user)
+{
+    (void)user;
+    digitalWrite(MY_XM125_WAKE_UP_PIN, level ? HIGH : LOW);
+}
+
+bool readMcuIntPin(void *user)
+{
+    (void)user;
+    return digitalRead(MY_XM125_MCU_INT_PIN) == HIGH;
+}
+
+void hostSleep(uint32_t sleepMs, void *user)
+{
+    (void)user;
+    // Let the serial output finish, then wait - a board specific sleep mode goes here
+    Serial.flush();
+    delay(sleepMs);
+}
+
+void setup()
+{
+    // Start serial
+    Serial.begin(115200);
+    Serial.println("XM125 Example 14: Distance Low Power");
+    Serial.println("");
+
+    // The sensor answers on I2C only while WAKE_UP is high
+    pinMode(MY_XM125_WAKE_UP_PIN, OUTPUT);
+    pinMode(MY_XM125_MCU_INT_PIN, INPUT);
+    digitalWrite(MY_XM125_WAKE_UP_PIN, HIGH);
+    delay(100);
+
+    Wire.begin();
+
+    if (radarSensor.begin(i2cAddress, Wire) == false)
+    {
+        Serial.println("Device failed to setup - Freezing code.");
+        while (1)
+            ; // Runs forever
+    }
+
+    lowPower.begin(&radarSensor, setWakeUpPin, readMcuIntPin);
+    lowPower.setHostSleep(hostSleep);
+    lowPower.setPeriod(MY_XM125_PERIOD);
+
+    // Sets up the detector with measure on wakeup, then lets the sensor hibernate
+    if (lowPower.setup(MY_XM125_RANGE_START, MY_XM125_RANGE_END) != ksfTkErrOk)
+    {
+        Serial.println("Low Power Setup Error - Freezing code.");
+        while (1)
+            ; // Runs forever
+    }
+}
+
+void loop()
+{
+    sfe_xm125_distance_frame_t frame;
+
+    sfTkError_t retVal = lowPower.cycle(frame);
+    if (retVal != ksfTkErrOk)
+    {
+        Serial.print("Low Power Cycle Error: ");
+        Serial.println(retVal);
+    }
+    else
+    {
+        Serial.print("Frame ");
+        Serial.print(frame.measure_counter);
+        Serial.print(": ");
+        if (frame.num_peaks == 0)
+            Serial.print("no object");
+        else
+        {
+            Serial.print(frame.distance[0]);
+            Serial.print("mm");
+        }
+
+        // Energy of the cycle - the sensor hibernates for the rest of the period
+        const sfe_xm125_low_power_stats_t &stats = lowPower.stats();
+        Serial.print(", awake ");
+        Serial.print(stats.last_awake_ms);
+        Serial.print("ms, transfers ");
+        Serial.println(stats.last_transfers);
+    }
+
+    // Until the next cycle is due
+    lowPower.sleep();
+}
@@ -0,0 +1,100 @@
+/*
+  Example 15: Distance Tracking
+
+  Using the Acconeer XM125 A121 60GHz Pulsed Coherent Radar Sensor.
+
+  This example follows the objects in front of the sensor from frame to frame. The peaks of each
+  frame are associated with tracks, which keep their ID while the object is seen. Each confirmed
+  track is printed with its smoothed distance and its radial velocity - negative values move
+  towards the sensor.
+
+  SparkFun code, firmware, and software is released under the MIT License.
+    Please see LICENSE.md for further details.
+
+  Hardware Connections:
+  QWIIC --> QWIIC
+
+  Serial.print it out at 115200 baud to serial monitor.
+
+  Feel like supporting our work? Buy a board from SparkFun!
+  https://www.sparkfun.com/products/ - Qwiic XM125 Breakout
+*/
+#include "SparkFun_Qwiic_XM125_Arduino_Library.h"
+#include <Arduino.h>
+
+SparkFunXM125Distance radarSensor;
+
+// I2C default address
+uint8_t i2cAddress = SFE_XM125_I2C_ADDRESS;
+
+// Distance range in mm used - 500mm to 5000mm (0.5 M to 5 M)
+#define MY_XM125_RANGE_START 500
+#define MY_XM125_RANGE_END 5000
+
+// Associates the peaks of each frame with tracks
+sfDevXM125PeakTracker tracker;
+
+sfe_xm125_distance_frame_t frame;
+
+void setup()
+{
+    // Start serial
+    Serial.begin(115200);
+    Serial.println("XM125 Example 15: Distance Tracking");
+    Serial.println("");
+
+    Wire.begin();
+
+    if (radarSensor.begin(i2cAddress, Wire) == false)
+    {
+        Serial.println("Device failed to setup - Freezing code.");
+        while (1)
+            ; // Runs forever
+    }
+
+    // Start the sensor with the specified range values
+    if (radarSensor.distanceSetup(MY_XM125_RANGE_START, MY_XM125_RANGE_END) != 0)
+    {
+        Serial.println("Distance Detection Start Setup Error - Freezing code.");
+        while (1)
+            ; // Runs forever
+    }
+}
+
+void loop()
+{
+    // Measure, then read the whole result in one burst - the setup recalibrates the sensor when
+    // it asks for it, and the tracks coast over the lost frame
+    if (radarSensor.detectorReadingSetup() != ksfTkErrOk)
+    {
+        Serial.println("Distance Reading Error");
+        delay(100);
+        return;
+    }
+
+    if (radarSensor.readFrame(frame) != ksfTkErrOk)
+        return;
+
+    if (tracker.update(frame) == 0)
+        return;
+
+    Serial.print("Frame ");
+    Serial.print(frame.measure_counter);
+    Serial.print(":");
+
+    for (uint8_t i = 0; i < tracker.numTracks(); i++)
+    {
+        const sfe_xm125_track_t &track = tracker.track(i);
+        if (!track.confirmed)
+            continue;
+
+        Serial.print(" [");
+        Serial.print(track.id);
+        Serial.print("] ");
+        Serial.print(track.distance);
+        Serial.print("mm ");
+        Serial.print(track.velocity);
+        Serial.print("mm/s");
+    }
+    Serial.println();
+}
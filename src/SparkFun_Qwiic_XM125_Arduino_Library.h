@@ -22,6 +22,20 @@
 #include "sfTk/sfDevXM125Core.h"
 #include "sfTk/sfDevXM125Distance.h"
 #include "sfTk/sfDevXM125Presence.h"
+#include "sfTk/sfDevXM125BusMonitor.h"
+#include "sfTk/sfDevXM125Mux.h"
+#include "sfTk/sfDevXM125Manager.h"
+#include "sfTk/sfDevXM125Scheduler.h"
+#include "sfTk/sfDevXM125SetupOp.h"
+#include "sfTk/sfDevXM125RingBuffer.h"
+#include "sfTk/sfDevXM125PacketEncoder.h"
+#include "sfTk/sfDevXM125Atomic.h"
+#include "sfTk/sfDevXM125Worker.h"
+#include "sfTk/sfDevXM125Field.h"
+#include "sfTk/sfDevXM125CalibrationSupervisor.h"
+#include "sfTk/sfDevXM125LowPower.h"
+#include "sfTk/sfDevXM125Timing.h"
+#include "sfTk/sfDevXM125PeakTracker.h"
 
 // To support version 1.* API 
 #include "sfTk/sfDevXM125DistanceV1.h"
@@ -116,11 +130,88 @@ class SparkFunXM125Presence : public sfDevXM125Presence
         return _i2cBus.ping() == ksfTkErrOk;
     }
 
+    /**
+     * @brief Starts presence detection on the module GPIO and attaches an interrupt to the host pin it
+     * is wired to. Call serviceEvents() from loop() to read each event and pass it to the callback.
+     *
+     * Note: Only one sensor at a time can use GPIO events.
+     *
+     * @param pin Host pin wired to the module detection GPIO.
+     * @param callback Function called with each event frame.
+     * @param user Pointer passed to the callback.
+     * @return True if successful, false otherwise.
+     */
+    bool beginGPIOEvents(uint8_t pin, sfe_xm125_presence_event_cb_t callback, void *user = nullptr)
+    {
+        if (enableGPIOEvents(callback, user) != ksfTkErrOk)
+            return false;
+
+        eventSensor() = this;
+        pinMode(pin, INPUT);
+        attachInterrupt(digitalPinToInterrupt(pin), onGPIOEdge, CHANGE);
+
+        return true;
+    }
+
+    /**
+     * @brief Detaches the interrupt from the host pin and stops presence detection on the module GPIO.
+     *
+     * @param pin Host pin passed to beginGPIOEvents().
+     * @return True if successful, false otherwise.
+     */
+    bool endGPIOEvents(uint8_t pin)
+    {
+        detachInterrupt(digitalPinToInterrupt(pin));
+        eventSensor() = nullptr;
+
+        return disableGPIOEvents() == ksfTkErrOk;
+    }
+
   private:
+    // Sensor that receives the GPIO interrupts
+    static SparkFunXM125Presence *&eventSensor(void)
+    {
+        static SparkFunXM125Presence *sensor = nullptr;
+        return sensor;
+    }
+
+    static void onGPIOEdge(void)
+    {
+        if (eventSensor() != nullptr)
+            eventSensor()->signalGPIOEvent();
+    }
+
     // I2C bus class
     sfTkArdI2C _i2cBus;
 };
 
+/**
+ * @class SparkFunXM125BusMonitor
+ * @brief Arduino class to measure the I2C bus cost of the SparkFun Pulsed Coherent Radar Sensor library.
+ *
+ * This class counts the transactions, bytes and latency of the transfers on an I2C bus, timing each
+ * transfer with micros(). Pass it to the begin() method of a device in place of the bus it monitors.
+ */
+class SparkFunXM125BusMonitor : public sfDevXM125BusMonitor
+{
+  public:
+    /**
+     * @brief Creates a monitor for the given bus, using micros() to measure latency.
+     *
+     * @param theBus I2C bus to monitor.
+     */
+    SparkFunXM125BusMonitor(sfTkII2C *theBus = nullptr) : sfDevXM125BusMonitor(theBus)
+    {
+        setClock(clockUs);
+    }
+
+  private:
+    static uint32_t clockUs(void)
+    {
+        return (uint32_t)micros();
+    }
+};
+
 // Version 1 - for backward compatibility
 /**
  * @class SparkFunXM125DistanceV1
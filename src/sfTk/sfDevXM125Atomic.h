@@ -0,0 +1,139 @@
+/**
+ * @file sfDevXM125Atomic.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains a small, portable atomics layer for sharing data between an interrupt handler
+ * and the main loop, or between the two cores of an ESP32 or RP2040. It is built on the GCC
+ * __atomic builtins, which every supported toolchain provides, and does not need <atomic>, which
+ * the AVR toolchain lacks.
+ *
+ * On AVR only single byte values are read and written atomically - use uint8_t there, or disable
+ * interrupts around the access.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+// Orders all memory accesses before the barrier against all accesses after it. Single core AVR parts
+// only need the compiler not to reorder them.
+#if defined(__AVR__)
+#define SFE_XM125_MEMORY_BARRIER() __asm__ __volatile__("" ::: "memory")
+#else
+#define SFE_XM125_MEMORY_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+// Largest unsigned type that is read and written atomically on every core of the platform
+#if defined(__AVR__)
+typedef uint8_t sfe_xm125_atomic_word_t;
+#else
+typedef uint32_t sfe_xm125_atomic_word_t;
+#endif
+
+/// @brief A value shared between two contexts. load() sees everything written before the store()
+///  of the value it returns (acquire / release ordering).
+template <class T> class sfDevXM125Atomic
+{
+  public:
+    sfDevXM125Atomic() : _value{0}
+    {
+    }
+
+    explicit sfDevXM125Atomic(T value) : _value{value}
+    {
+    }
+
+    /// @brief Reads the value
+    T load(void) const
+    {
+        return __atomic_load_n(&_value, __ATOMIC_ACQUIRE);
+    }
+
+    /// @brief Reads the value without ordering - for the context that is the only writer
+    T loadRelaxed(void) const
+    {
+        return __atomic_load_n(&_value, __ATOMIC_RELAXED);
+    }
+
+    /// @brief Writes the value
+    void store(T value)
+    {
+        __atomic_store_n(&_value, value, __ATOMIC_RELEASE);
+    }
+
+    /// @brief Adds to the value and returns the previous value. Only atomic on parts with atomic
+    ///  read-modify-write instructions - with a single writer, use store() instead.
+    T fetchAdd(T delta)
+    {
+        return __atomic_fetch_add(&_value, delta, __ATOMIC_ACQ_REL);
+    }
+
+  private:
+    T _value;
+};
+
+/// @brief Holds the latest copy of an item written by one context for readers in other contexts.
+///  The writer never waits; a reader retries when the item changed while it was copied. Suits
+///  "latest frame" snapshots, where a reader only needs the newest item and may skip others.
+template <class T> class sfDevXM125Seqlock
+{
+  public:
+    sfDevXM125Seqlock() : _sequence{0}
+    {
+        memset((void *)&_item, 0, sizeof(T));
+    }
+
+    /// @brief Writer - stores a new item. Only one context may write.
+    /// @param item Item to store
+    void write(const T &item)
+    {
+        sfe_xm125_atomic_word_t sequence = _sequence.loadRelaxed();
+
+        // An odd sequence marks the item as being written
+        _sequence.store((sfe_xm125_atomic_word_t)(sequence + 1));
+        SFE_XM125_MEMORY_BARRIER();
+
+        memcpy((void *)&_item, &item, sizeof(T));
+
+        _sequence.store((sfe_xm125_atomic_word_t)(sequence + 2));
+    }
+
+    /// @brief Reader - copies the latest item
+    /// @param item Copy of the item
+    /// @param attempts Number of times to try when the item is being written
+    /// @return true if item holds a consistent copy, false if the writer kept changing it
+    bool read(T &item, uint8_t attempts = 4) const
+    {
+        for (uint8_t i = 0; i < attempts; i++)
+        {
+            sfe_xm125_atomic_word_t before = _sequence.load();
+            if (before & 1)
+                continue;
+
+            memcpy(&item, (const void *)&_item, sizeof(T));
+            SFE_XM125_MEMORY_BARRIER();
+
+            if (_sequence.loadRelaxed() == before)
+                return true;
+        }
+
+        return false;
+    }
+
+    /// @brief Returns the number of items written, wrapping around - a reader can compare it to the
+    ///  value at its last read to tell whether there is a new item
+    sfe_xm125_atomic_word_t version(void) const
+    {
+        return _sequence.load() >> 1;
+    }
+
+  private:
+    sfDevXM125Atomic<sfe_xm125_atomic_word_t> _sequence;
+    volatile T _item;
+};
@@ -0,0 +1,251 @@
+/**
+ * @file sfDevXM125BusMonitor.cpp
+ * @brief Implementation of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the implementation of the I2C bus monitor used to measure the bus
+ * cost of the library.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <string.h>
+
+#include "sfDevXM125BusMonitor.h"
+
+//--------------------------------------------------------------------------------
+sfDevXM125BusMonitor::sfDevXM125BusMonitor(sfTkII2C *theBus) : _theBus{nullptr}, _clock{nullptr}
+{
+    reset();
+    init(theBus);
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125BusMonitor::init(sfTkII2C *theBus)
+{
+    _theBus = theBus;
+
+    if (_theBus != nullptr)
+        setAddress(_theBus->address());
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125BusMonitor::reset(void)
+{
+    memset(&_stats, 0, sizeof(_stats));
+
+    _api = -1;
+    _apiDepth = 0;
+    _apiStartUs = 0;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125BusMonitor::snapshot(sfe_xm125_bus_stats_t &stats)
+{
+    stats = _stats;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125BusMonitor::beginApi(const char *name)
+{
+    if (_apiDepth++ > 0 || name == nullptr)
+        return;
+
+    uint8_t i = 0;
+    for (; i < _stats.nApis; i++)
+    {
+        if (strcmp(_stats.apis[i].name, name) == 0)
+            break;
+    }
+
+    // table full - the call is only counted in the totals
+    if (i == SFE_XM125_BUS_MONITOR_MAX_APIS)
+        return;
+
+    if (i == _stats.nApis)
+    {
+        _stats.nApis++;
+        _stats.apis[i].name = name;
+    }
+
+    _api = (int8_t)i;
+    _stats.apis[i].calls++;
+    _apiStartUs = now();
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125BusMonitor::endApi(void)
+{
+    if (_apiDepth == 0 || --_apiDepth > 0)
+        return;
+
+    if (_api >= 0)
+        _stats.apis[_api].elapsedUs += now() - _apiStartUs;
+
+    _api = -1;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125BusMonitor::addLatency(sfe_xm125_bus_latency_t &latency, uint32_t us)
+{
+    if (latency.count++ == 0)
+        latency.minUs = us;
+    latency.totalUs += us;
+
+    if (us < latency.minUs)
+        latency.minUs = us;
+    if (us > latency.maxUs)
+        latency.maxUs = us;
+
+    uint8_t bucket = 0;
+    for (uint32_t limit = SFE_XM125_BUS_HISTOGRAM_FIRST_US;
+         bucket < SFE_XM125_BUS_HISTOGRAM_BUCKETS - 1 && us >= limit; limit <<= 1)
+        bucket++;
+
+    latency.histogram[bucket]++;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125BusMonitor::record(uint16_t devReg, bool isRead, size_t addrBytes, size_t dataBytes,
+                                  uint32_t startUs, sfTkError_t result)
+{
+    uint32_t elapsedUs = now() - startUs;
+
+    if (isRead)
+    {
+        _stats.reads++;
+        _stats.bytesRead += dataBytes;
+        _stats.bytesWritten += addrBytes;
+    }
+    else
+    {
+        _stats.writes++;
+        _stats.bytesWritten += addrBytes + dataBytes;
+    }
+
+    if (result != ksfTkErrOk)
+        _stats.errors++;
+
+    if (_clock != nullptr)
+        addLatency(_stats.latency, elapsedUs);
+
+    if (_api >= 0)
+    {
+        sfe_xm125_bus_api_stats_t &api = _stats.apis[_api];
+
+        api.transactions++;
+        api.bytes += addrBytes + dataBytes;
+        if (_clock != nullptr)
+            addLatency(api.latency, elapsedUs);
+    }
+
+    uint8_t i = 0;
+    for (; i < _stats.nRegs; i++)
+    {
+        if (_stats.regs[i].reg == devReg)
+            break;
+    }
+
+    if (i == SFE_XM125_BUS_MONITOR_MAX_REGS)
+    {
+        _stats.otherRegs++;
+        return;
+    }
+
+    if (i == _stats.nRegs)
+    {
+        _stats.nRegs++;
+        _stats.regs[i].reg = devReg;
+    }
+
+    sfe_xm125_bus_reg_stats_t &reg = _stats.regs[i];
+    if (isRead)
+        reg.reads++;
+    else
+        reg.writes++;
+    reg.bytes += dataBytes;
+    reg.totalUs += elapsedUs;
+    if (elapsedUs > reg.maxUs)
+        reg.maxUs = elapsedUs;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125BusMonitor::ping()
+{
+    if (_theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    return _theBus->ping();
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125BusMonitor::writeData(const uint8_t *data, size_t length)
+{
+    if (_theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    uint32_t startUs = now();
+    sfTkError_t retVal = _theBus->writeData(data, length);
+
+    // raw data starts with the big-endian register address
+    uint16_t devReg = data != nullptr && length >= 2 ? ((uint16_t)data[0] << 8) | data[1] : 0;
+    record(devReg, false, 0, length, startUs, retVal);
+
+    return retVal;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125BusMonitor::writeRegister(uint8_t devReg, const uint8_t *data, size_t length)
+{
+    if (_theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    uint32_t startUs = now();
+    sfTkError_t retVal = _theBus->writeRegister(devReg, data, length);
+    record(devReg, false, sizeof(devReg), length, startUs, retVal);
+
+    return retVal;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125BusMonitor::writeRegister(uint16_t devReg, const uint8_t *data, size_t length)
+{
+    if (_theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    uint32_t startUs = now();
+    sfTkError_t retVal = _theBus->writeRegister(devReg, data, length);
+    record(devReg, false, sizeof(devReg), length, startUs, retVal);
+
+    return retVal;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125BusMonitor::readRegister(uint8_t devReg, uint8_t *data, size_t numBytes, size_t &readBytes,
+                                               uint32_t read_delay)
+{
+    if (_theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    uint32_t startUs = now();
+    sfTkError_t retVal = _theBus->readRegister(devReg, data, numBytes, readBytes, read_delay);
+    record(devReg, true, sizeof(devReg), readBytes, startUs, retVal);
+
+    return retVal;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125BusMonitor::readRegister(uint16_t devReg, uint8_t *data, size_t numBytes, size_t &readBytes,
+                                               uint32_t read_delay)
+{
+    if (_theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    uint32_t startUs = now();
+    sfTkError_t retVal = _theBus->readRegister(devReg, data, numBytes, readBytes, read_delay);
+    record(devReg, true, sizeof(devReg), readBytes, startUs, retVal);
+
+    return retVal;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file sfDevXM125BusMonitor.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the header of an I2C bus monitor. The monitor implements the toolkit I2C bus
+ * interface on top of another I2C bus and counts the transactions, bytes and latency of every
+ * transfer - in total, per register and per library call - to measure the bus cost of the library.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <sfTk/sfToolkit.h>
+// Bus interfaces
+#include <sfTk/sfTkII2C.h>
+
+// Size of the monitor tables - transfers to registers beyond the register table are counted in otherRegs
+const uint8_t SFE_XM125_BUS_MONITOR_MAX_REGS = 24;
+const uint8_t SFE_XM125_BUS_MONITOR_MAX_APIS = 8;
+
+// Latency histogram - bucket 0 counts transfers under 64us, each following bucket doubles the limit
+// and the last bucket counts everything slower
+const uint8_t SFE_XM125_BUS_HISTOGRAM_BUCKETS = 8;
+const uint32_t SFE_XM125_BUS_HISTOGRAM_FIRST_US = 64;
+
+// Time source for latency measurement - returns microseconds
+typedef uint32_t (*sfe_xm125_bus_clock_us_t)(void);
+
+// Latency statistics of a set of bus transfers, in microseconds
+typedef struct
+{
+    uint32_t count;   // number of timed transfers
+    uint32_t minUs;   // fastest transfer
+    uint32_t maxUs;   // slowest transfer
+    uint32_t totalUs; // sum of all transfer times
+    uint32_t histogram[SFE_XM125_BUS_HISTOGRAM_BUCKETS];
+} sfe_xm125_bus_latency_t;
+
+// Transfers that started at one register. A block transfer is counted at its first register.
+typedef struct
+{
+    uint16_t reg;     // register address
+    uint32_t reads;   // read transactions
+    uint32_t writes;  // write transactions
+    uint32_t bytes;   // data bytes transferred
+    uint32_t totalUs; // sum of all transfer times
+    uint32_t maxUs;   // slowest transfer
+} sfe_xm125_bus_reg_stats_t;
+
+// Transfers made inside a beginApi()/endApi() pair with the same name
+typedef struct
+{
+    const char *name;                // name passed to beginApi()
+    uint32_t calls;                  // number of beginApi() calls
+    uint32_t transactions;           // bus transactions made during the calls
+    uint32_t bytes;                  // bytes on the bus during the calls
+    uint32_t elapsedUs;              // total time from beginApi() to endApi()
+    sfe_xm125_bus_latency_t latency; // latency of the transfers made during the calls
+} sfe_xm125_bus_api_stats_t;
+
+// All counters of a bus monitor. Byte counts include the register address bytes that are sent with
+// each transfer; the I2C address byte and bus framing are not counted.
+typedef struct
+{
+    uint32_t reads;                  // read transactions
+    uint32_t writes;                 // write transactions
+    uint32_t bytesRead;              // bytes read from the device
+    uint32_t bytesWritten;           // bytes written to the device, including register addresses
+    uint32_t errors;                 // transfers that returned an error
+    sfe_xm125_bus_latency_t latency; // latency of all transfers
+    uint8_t nRegs;                   // used entries of regs
+    uint32_t otherRegs;              // transactions not recorded in regs because the table was full
+    sfe_xm125_bus_reg_stats_t regs[SFE_XM125_BUS_MONITOR_MAX_REGS];
+    uint8_t nApis; // used entries of apis
+    sfe_xm125_bus_api_stats_t apis[SFE_XM125_BUS_MONITOR_MAX_APIS];
+} sfe_xm125_bus_stats_t;
+
+class sfDevXM125BusMonitor : public sfTkII2C
+{
+  public:
+    /// @brief Creates a bus monitor
+    /// @param theBus Bus to monitor - can also be set with init()
+    sfDevXM125BusMonitor(sfTkII2C *theBus = nullptr);
+
+    // Make the typed register helpers of the bus interface visible next to the overrides below
+    using sfTkIBus::readRegister;
+    using sfTkIBus::writeRegister;
+
+    /// @brief Sets the bus to monitor. The monitor takes the device address of the bus.
+    /// @param theBus Bus to monitor
+    void init(sfTkII2C *theBus);
+
+    /// @brief Sets the microsecond time source used to measure latency. Without a clock
+    ///  only transactions and bytes are counted.
+    /// @param clock Function returning the current time in microseconds, or nullptr
+    void setClock(sfe_xm125_bus_clock_us_t clock)
+    {
+        _clock = clock;
+    }
+
+    /// @brief Clears all counters
+    void reset(void);
+
+    /// @brief Copies the current counters
+    /// @param stats Structure to hold the counters
+    void snapshot(sfe_xm125_bus_stats_t &stats);
+
+    /// @brief Returns the current counters
+    const sfe_xm125_bus_stats_t &stats(void)
+    {
+        return _stats;
+    }
+
+    /// @brief Attributes the following transfers to a library call until endApi(). Calls
+    ///  with the same name are accumulated. Nested calls are counted in the outermost call.
+    /// @param name Name of the call - must stay valid while the counters are used
+    void beginApi(const char *name);
+
+    /// @brief Ends the call started with beginApi()
+    void endApi(void);
+
+    /// @brief Returns the average latency of a set of transfers
+    /// @param latency Latency statistics
+    /// @return Average transfer time in microseconds, 0 if nothing was timed
+    static uint32_t averageUs(const sfe_xm125_bus_latency_t &latency)
+    {
+        return latency.count == 0 ? 0 : latency.totalUs / latency.count;
+    }
+
+    /// @brief Pings the monitored bus
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t ping() override;
+
+    /// @brief Writes raw data to the monitored bus
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeData(const uint8_t *data, size_t length) override;
+
+    /// @brief Writes to a register on the monitored bus
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeRegister(uint8_t devReg, const uint8_t *data, size_t length) override;
+
+    /// @brief Writes to a register on the monitored bus
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeRegister(uint16_t devReg, const uint8_t *data, size_t length) override;
+
+    /// @brief Reads from a register on the monitored bus
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readRegister(uint8_t devReg, uint8_t *data, size_t numBytes, size_t &readBytes,
+                             uint32_t read_delay = 0) override;
+
+    /// @brief Reads from a register on the monitored bus
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readRegister(uint16_t devReg, uint8_t *data, size_t numBytes, size_t &readBytes,
+                             uint32_t read_delay = 0) override;
+
+  private:
+    uint32_t now(void)
+    {
+        return _clock == nullptr ? 0 : _clock();
+    }
+
+    void record(uint16_t devReg, bool isRead, size_t addrBytes, size_t dataBytes, uint32_t startUs,
+                sfTkError_t result);
+    static void addLatency(sfe_xm125_bus_latency_t &latency, uint32_t us);
+
+    sfTkII2C *_theBus;
+    sfe_xm125_bus_clock_us_t _clock;
+    sfe_xm125_bus_stats_t _stats;
+
+    // api being measured, -1 if none
+    int8_t _api;
+    uint8_t _apiDepth;
+    uint32_t _apiStartUs;
+};
@@ -0,0 +1,163 @@
+/**
+ * @file sfDevXM125CalibrationSupervisor.cpp
+ * @brief Implementation of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the implementation of the distance detector calibration supervisor.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "sfDevXM125CalibrationSupervisor.h"
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125CalibrationSupervisor::begin(sfDevXM125Distance *device)
+{
+    if (device == nullptr)
+        return ksfTkErrFail;
+
+    _device = device;
+    _state = kIdle;
+    _trigger = SFE_XM125_CALIBRATION_TRIGGER_NONE;
+    _temperatureKnown = false;
+    resetStats();
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125CalibrationSupervisor::resetStats(void)
+{
+    int16_t calibrationTemperature = _stats.calibration_temperature;
+    int16_t temperature = _stats.temperature;
+
+    _stats = sfe_xm125_calibration_stats_t();
+    _stats.calibration_temperature = calibrationTemperature;
+    _stats.temperature = temperature;
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125CalibrationSupervisor::update(const sfe_xm125_distance_poll_t &poll)
+{
+    if (!poll.ready)
+        return pending();
+
+    return check((poll.flags & SFE_XM125_DISTANCE_FRAME_CALIBRATION_NEEDED) != 0, poll.temperature);
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125CalibrationSupervisor::update(const sfe_xm125_distance_frame_t &frame)
+{
+    return check((frame.flags & SFE_XM125_DISTANCE_FRAME_CALIBRATION_NEEDED) != 0, frame.temperature);
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125CalibrationSupervisor::check(bool calibrationNeeded, int16_t temperature)
+{
+    _stats.frames++;
+    _stats.temperature = temperature;
+
+    // The first frame after the setup was measured with a fresh calibration
+    if (!_temperatureKnown)
+    {
+        _stats.calibration_temperature = temperature;
+        _temperatureKnown = true;
+    }
+
+    // Already scheduled - the recalibration covers this frame too
+    if (pending())
+        return true;
+
+    if (calibrationNeeded)
+    {
+        _stats.flag_triggers++;
+        schedule(SFE_XM125_CALIBRATION_TRIGGER_FLAG);
+        return true;
+    }
+
+    int32_t drift = (int32_t)temperature - _stats.calibration_temperature;
+    if (drift < 0)
+        drift = -drift;
+
+    if (_driftLimit > 0 && drift >= _driftLimit)
+    {
+        _stats.drift_triggers++;
+        schedule(SFE_XM125_CALIBRATION_TRIGGER_DRIFT);
+        return true;
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125CalibrationSupervisor::request(void)
+{
+    if (!pending())
+        schedule(SFE_XM125_CALIBRATION_TRIGGER_USER);
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125CalibrationSupervisor::schedule(uint8_t trigger)
+{
+    _trigger = trigger;
+    _triggerMs = sftk_ticks_ms();
+    _state = kPending;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125CalibrationSupervisor::service(void)
+{
+    if (_state == kIdle)
+        return ksfTkErrOk;
+
+    if (_device == nullptr)
+        return ksfTkErrBusNotInit;
+
+    if (_state == kPending)
+    {
+        sfTkError_t retVal = _device->recalibrate();
+        if (retVal != ksfTkErrOk)
+            return retVal;
+
+        _device->startBusyPoll(_poll, _timeoutMs);
+        _state = kRecalibrating;
+    }
+
+    sfTkError_t retVal = _device->pollBusy(_poll);
+    if (retVal == ksfTkErrXM125Busy)
+        return retVal;
+
+    // The status register value read by the last poll tells whether the calibration succeeded
+    if (retVal == ksfTkErrOk)
+    {
+        sfDevXM125Status status;
+        sfDevXM125Distance::decodeStatus(_poll.status, status);
+        if (status.hasError())
+            retVal = ksfTkErrXM125Detector;
+    }
+
+    // Try again before the next measurement
+    if (retVal != ksfTkErrOk)
+    {
+        _stats.failures++;
+        _state = kPending;
+        return retVal;
+    }
+
+    uint32_t latency = sftk_ticks_ms() - _triggerMs;
+
+    _stats.recalibrations++;
+    _stats.last_latency_ms = latency;
+    _stats.total_latency_ms += latency;
+    if (latency > _stats.max_latency_ms)
+        _stats.max_latency_ms = latency;
+    _stats.last_trigger = _trigger;
+    _stats.calibration_temperature = _stats.temperature;
+
+    _state = kIdle;
+    _trigger = SFE_XM125_CALIBRATION_TRIGGER_NONE;
+
+    return ksfTkErrOk;
+}
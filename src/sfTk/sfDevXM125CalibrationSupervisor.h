@@ -0,0 +1,145 @@
+/**
+ * @file sfDevXM125CalibrationSupervisor.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the header of the distance detector calibration supervisor. The supervisor looks
+ * at the result of every frame - the calibration needed flag and the sensor temperature - and
+ * recalibrates the detector between two frames when the detector asks for it, or when the temperature
+ * has drifted too far from the temperature of the last calibration. Only the frame that triggered the
+ * recalibration is lost; the next measurement is started once the recalibration is done.
+ *
+ *     supervisor.update(poll);                    // after each ready frame from pollFrame()
+ *     if (supervisor.service() == ksfTkErrOk)     // before each start()
+ *         radarSensor.start();
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "sfDevXM125Distance.h"
+
+// Default temperature change since the last calibration that triggers a recalibration, in degrees
+const uint16_t SFE_XM125_CALIBRATION_DRIFT_DEFAULT = 10;
+
+// Default time allowed for a recalibration in milliseconds
+const uint32_t SFE_XM125_CALIBRATION_TIMEOUT_DEFAULT = 1000;
+
+// Reason of a recalibration
+const uint8_t SFE_XM125_CALIBRATION_TRIGGER_NONE = 0x00;
+const uint8_t SFE_XM125_CALIBRATION_TRIGGER_FLAG = 0x01;  // the detector reported calibration needed
+const uint8_t SFE_XM125_CALIBRATION_TRIGGER_DRIFT = 0x02; // the temperature drifted past the limit
+const uint8_t SFE_XM125_CALIBRATION_TRIGGER_USER = 0x04;  // requested with request()
+
+// Recalibration statistics of a supervisor. Latencies are measured from the frame that triggered the
+// recalibration to the end of the recalibration - the time the detector is not measuring.
+typedef struct
+{
+    uint32_t recalibrations;         // recalibrations completed
+    uint32_t failures;               // recalibrations that failed or timed out
+    uint32_t flag_triggers;          // recalibrations triggered by the calibration needed flag
+    uint32_t drift_triggers;         // recalibrations triggered by temperature drift
+    uint32_t frames;                 // frames checked
+    uint32_t last_latency_ms;        // latency of the last recalibration
+    uint32_t max_latency_ms;         // largest latency seen
+    uint32_t total_latency_ms;       // sum of all latencies - divide by recalibrations for the mean
+    int16_t calibration_temperature; // temperature of the last calibration
+    int16_t temperature;             // temperature of the last frame
+    uint8_t last_trigger;            // SFE_XM125_CALIBRATION_TRIGGER_* flags of the last recalibration
+} sfe_xm125_calibration_stats_t;
+
+class sfDevXM125CalibrationSupervisor
+{
+  public:
+    sfDevXM125CalibrationSupervisor()
+        : _device{nullptr}, _driftLimit{SFE_XM125_CALIBRATION_DRIFT_DEFAULT},
+          _timeoutMs{SFE_XM125_CALIBRATION_TIMEOUT_DEFAULT}, _state{kIdle},
+          _trigger{SFE_XM125_CALIBRATION_TRIGGER_NONE}, _temperatureKnown{false}, _triggerMs{0}, _stats{}, _poll{} {};
+
+    /// @brief Supervises a distance detector. Call this after the setup - the temperature of the
+    ///  first frame is taken as the calibration temperature.
+    /// @param device Distance detector - must outlive the supervisor
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t begin(sfDevXM125Distance *device);
+
+    /// @brief Sets the temperature change since the last calibration that triggers a recalibration,
+    ///  ahead of the detector asking for one
+    /// @param degrees Temperature change in degrees - 0 only recalibrates when the detector asks
+    void setDriftLimit(uint16_t degrees)
+    {
+        _driftLimit = degrees;
+    }
+
+    /// @brief Sets the time allowed for a recalibration
+    /// @param timeoutMs Timeout in milliseconds
+    void setTimeout(uint32_t timeoutMs)
+    {
+        _timeoutMs = timeoutMs;
+    }
+
+    /// @brief Checks a ready frame from pollFrame() and schedules a recalibration when needed
+    /// @param poll Poll result - ignored unless poll.ready is set
+    /// @return true if a recalibration is scheduled - the frame is not valid when the detector
+    ///  reported calibration needed
+    bool update(const sfe_xm125_distance_poll_t &poll);
+
+    /// @brief Checks a frame from readFrame() and schedules a recalibration when needed
+    /// @param frame Frame read after a measurement
+    /// @return true if a recalibration is scheduled
+    bool update(const sfe_xm125_distance_frame_t &frame);
+
+    /// @brief Schedules a recalibration before the next measurement
+    void request(void);
+
+    /// @brief Runs a scheduled recalibration without blocking - sends the command, then checks
+    ///  whether it finished each time it is called. Call this between frames, and only start the
+    ///  next measurement when it returns ksfTkErrOk.
+    /// @return ksfTkErrOk when the detector may be started, ksfTkErrXM125Busy while recalibrating,
+    ///  ksfTkErrXM125Timeout or ksfTkErrXM125Detector when the recalibration failed, or error code
+    ///  (value < -1). A failed recalibration is scheduled again.
+    sfTkError_t service(void);
+
+    /// @brief Returns true while a recalibration is scheduled or running
+    bool pending(void)
+    {
+        return _state != kIdle;
+    }
+
+    /// @brief Returns the recalibration statistics
+    const sfe_xm125_calibration_stats_t &stats(void)
+    {
+        return _stats;
+    }
+
+    /// @brief Clears the recalibration statistics - the calibration temperature is kept
+    void resetStats(void);
+
+  private:
+    typedef enum
+    {
+        kIdle = 0,          // nothing to do
+        kPending = 1,       // recalibration due before the next measurement
+        kRecalibrating = 2, // waiting for the recalibration to finish
+    } state_t;
+
+    /// @brief Checks the calibration flag and temperature of one frame
+    bool check(bool calibrationNeeded, int16_t temperature);
+
+    /// @brief Schedules a recalibration for the given reason
+    void schedule(uint8_t trigger);
+
+    sfDevXM125Distance *_device;
+    uint16_t _driftLimit;
+    uint32_t _timeoutMs;
+    uint8_t _state; // state_t
+    uint8_t _trigger;
+    bool _temperatureKnown;
+    uint32_t _triggerMs;
+    sfe_xm125_calibration_stats_t _stats;
+    sfe_xm125_busy_poll_t _poll;
+};
@@ -24,8 +24,8 @@ sfTkError_t sfDevXM125Core::init(sfTkII2C *theBus)
     if (theBus == nullptr)
         return ksfTkErrBusNotInit;
 
-    // Check if the provided address is valid
-    if (theBus->address() != SFE_XM125_I2C_ADDRESS)
+    // Check if the provided address is one the module can use
+    if (theBus->address() < SFE_XM125_I2C_ADDRESS_LOW || theBus->address() > SFE_XM125_I2C_ADDRESS_HIGH)
         return ksfTkErrFail;
 
     // Sets communication bus
@@ -37,3 +37,417 @@ sfTkError_t sfDevXM125Core::init(sfTkII2C *theBus)
     // return the value of ping
     return theBus->ping();
 }
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Core::readRegisterBlock(uint16_t devReg, uint32_t *values, size_t count)
+{
+    if (_theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    if (values == nullptr || count == 0)
+        return ksfTkErrFail;
+
+    // Read the raw bytes straight into the output array, then decode each word in place
+    size_t nBytes = count * sizeof(uint32_t);
+    size_t readBytes = 0;
+    uint8_t *pBytes = (uint8_t *)values;
+
+    sfTkError_t retVal = _theBus->readRegister(devReg, pBytes, nBytes, readBytes);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    if (readBytes != nBytes)
+        return ksfTkErrFail;
+
+    for (size_t i = 0; i < count; i++, pBytes += sizeof(uint32_t))
+        values[i] = ((uint32_t)pBytes[0] << 24) | ((uint32_t)pBytes[1] << 16) | ((uint32_t)pBytes[2] << 8) |
+                    (uint32_t)pBytes[3];
+
+    if (!_shadowEnabled)
+        return ksfTkErrOk;
+
+    // Keep the shadow cache in step - uncommitted changes take precedence over the device values
+    for (size_t i = 0; i < count; i++)
+    {
+        int8_t index = shadowIndex(devReg + i);
+        if (index < 0)
+            continue;
+
+        uint32_t bit = (uint32_t)1 << index;
+        if (_shadowDirty & bit)
+            values[i] = _shadow[index];
+        else
+        {
+            _shadow[index] = values[i];
+            _shadowValid |= bit;
+        }
+    }
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Core::writeRegisterBlock(uint16_t devReg, const uint32_t *values, size_t count)
+{
+    if (_theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    if (values == nullptr || count == 0)
+        return ksfTkErrFail;
+
+    uint8_t buffer[SFE_XM125_WRITE_BURST_MAX * sizeof(uint32_t)];
+
+    for (size_t done = 0; done < count;)
+    {
+        size_t nRegs = count - done;
+        if (nRegs > _maxWriteBurst)
+            nRegs = _maxWriteBurst;
+
+        // Encode as big-endian words - the byte order the device uses
+        uint8_t *pBytes = buffer;
+        for (size_t i = 0; i < nRegs; i++)
+        {
+            uint32_t value = values[done + i];
+            *pBytes++ = (uint8_t)(value >> 24);
+            *pBytes++ = (uint8_t)(value >> 16);
+            *pBytes++ = (uint8_t)(value >> 8);
+            *pBytes++ = (uint8_t)value;
+        }
+
+        sfTkError_t retVal = _theBus->writeRegister((uint16_t)(devReg + done), buffer, nRegs * sizeof(uint32_t));
+        if (retVal != ksfTkErrOk)
+            return retVal;
+
+        // These registers now match the device
+        for (size_t i = 0; _shadowEnabled && i < nRegs; i++)
+        {
+            int8_t index = shadowIndex(devReg + done + i);
+            if (index < 0)
+                continue;
+
+            uint32_t bit = (uint32_t)1 << index;
+            _shadow[index] = values[done + i];
+            _shadowValid |= bit;
+            _shadowDirty &= ~bit;
+        }
+
+        done += nRegs;
+    }
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Core::startBusyPoll(sfe_xm125_busy_poll_t &poll, uint32_t timeoutMs,
+                                   sfe_xm125_poll_strategy_t strategy, uint32_t expectedMs)
+{
+    poll.startMs = sftk_ticks_ms();
+    poll.timeoutMs = timeoutMs;
+    poll.intervalMs = SFE_XM125_POLL_INTERVAL_DEFAULT;
+    poll.status = 0;
+    poll.polls = 0;
+    poll.strategy = (uint8_t)strategy;
+
+    // The expected duration strategy skips reads until the command should be done
+    if (strategy == XM125_POLL_EXPECTED && expectedMs < timeoutMs)
+        poll.nextPollMs = poll.startMs + expectedMs;
+    else
+        poll.nextPollMs = poll.startMs;
+}
+
+//--------------------------------------------------------------------------------
+uint32_t sfDevXM125Core::estimateSweepUs(uint32_t startMm, uint32_t endMm, uint32_t stepLength, uint32_t profile,
+                                         uint32_t hwaas)
+{
+    sfe_xm125_timing_config_t config;
+    sfDevXM125Timing::defaultConfig(config);
+
+    // Nothing is measured beyond the reach of the lowest PRF
+    uint32_t maxMm = sfDevXM125Timing::maxDistanceMm(XM125_PRF_5_2_MHZ);
+
+    config.end = endMm < maxMm ? endMm : maxMm;
+    config.start = startMm < config.end ? startMm : config.end;
+    config.profile = profile >= 1 && profile <= 5 ? profile : 5;
+    config.step_length = stepLength;
+    config.hwaas = hwaas == 0 ? 1 : hwaas > SFE_XM125_HWAAS_MAX ? SFE_XM125_HWAAS_MAX : hwaas;
+
+    sfe_xm125_timing_t timing;
+    return sfDevXM125Timing::estimate(config, timing) == ksfTkErrOk ? timing.sweep_us : 0;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Core::pollBusyStatus(uint16_t statusReg, uint32_t busyMask, sfe_xm125_busy_poll_t &poll)
+{
+    if (_theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    // Not time to poll yet? Leave the bus alone. Unsigned math keeps this valid over tick wrap.
+    uint32_t now = sftk_ticks_ms();
+    if ((int32_t)(now - poll.nextPollMs) < 0)
+        return ksfTkErrXM125Busy;
+
+    sfTkError_t retVal = _theBus->readRegister(statusReg, poll.status);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    poll.polls++;
+
+    if ((poll.status & busyMask) == 0)
+        return ksfTkErrOk;
+
+    uint32_t elapsed = now - poll.startMs;
+    if (elapsed >= poll.timeoutMs)
+        return ksfTkErrXM125Timeout;
+
+    // Still busy - schedule the next read
+    if (poll.strategy == XM125_POLL_BACKOFF && poll.polls > 1)
+    {
+        poll.intervalMs <<= 1;
+        if (poll.intervalMs > SFE_XM125_POLL_INTERVAL_MAX)
+            poll.intervalMs = SFE_XM125_POLL_INTERVAL_MAX;
+    }
+
+    // Always take one last look at the deadline
+    uint32_t remaining = poll.timeoutMs - elapsed;
+    poll.nextPollMs = now + (poll.intervalMs < remaining ? poll.intervalMs : remaining);
+
+    return ksfTkErrXM125Busy;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Core::busyWaitStatus(uint16_t statusReg, uint32_t busyMask, uint32_t timeoutMs,
+                                           sfe_xm125_poll_strategy_t strategy, uint32_t expectedMs)
+{
+    sfe_xm125_busy_poll_t poll;
+    startBusyPoll(poll, timeoutMs, strategy, expectedMs);
+
+    sfTkError_t retVal;
+    while ((retVal = pollBusyStatus(statusReg, busyMask, poll)) == ksfTkErrXM125Busy)
+    {
+        // Sleep until the next poll is due
+        int32_t wait = (int32_t)(poll.nextPollMs - sftk_ticks_ms());
+        if (wait > 0)
+            sftk_delay_ms((uint32_t)wait);
+    }
+
+    _lastStatus = poll.status;
+    return retVal;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Status::decode(uint32_t regVal, const sfe_xm125_status_entry_t *table, uint8_t count,
+                              uint32_t busyMask)
+{
+    _raw = regVal;
+    _ok = 0;
+    _errors = 0;
+    _firstError = 0;
+    _busy = (regVal & busyMask) != 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const sfe_xm125_status_entry_t &entry = table[i];
+        uint16_t flag = (uint16_t)(1u << entry.flagBit);
+
+        if (entry.okBit != SFE_XM125_STATUS_NO_BIT && (regVal & ((uint32_t)1 << entry.okBit)) != 0)
+            _ok |= flag;
+        if ((regVal & ((uint32_t)1 << entry.errorBit)) != 0)
+        {
+            // The table is in setup order - the first failed entry is the first step that failed
+            if (_errors == 0)
+                _firstError = flag;
+            _errors |= flag;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------
+uint32_t sfDevXM125Core::statusErrorCode(uint32_t regVal, const sfe_xm125_status_entry_t *table, uint8_t count,
+                                         uint32_t busyMask, uint32_t busyCode)
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if ((regVal & ((uint32_t)1 << table[i].errorBit)) != 0)
+            return table[i].legacyCode;
+    }
+
+    return (regVal & busyMask) != 0 ? busyCode : 0;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Core::enableShadowCache(bool enable)
+{
+    _shadowEnabled = enable;
+    _shadowValid = 0;
+    _shadowDirty = 0;
+}
+
+//--------------------------------------------------------------------------------
+int8_t sfDevXM125Core::shadowIndex(uint16_t devReg)
+{
+    if (devReg >= SFE_XM125_SHADOW_BLOCK_START && devReg <= _shadowBlockEnd &&
+        devReg - SFE_XM125_SHADOW_BLOCK_START < SFE_XM125_SHADOW_BLOCK_MAX)
+        return (int8_t)(devReg - SFE_XM125_SHADOW_BLOCK_START);
+
+    if (devReg == SFE_XM125_SHADOW_EXTRA_REG)
+        return SFE_XM125_SHADOW_BLOCK_MAX;
+
+    return -1;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Core::writeConfigRegisterBlock(uint16_t devReg, const uint32_t *values, size_t count)
+{
+    if (!_shadowEnabled)
+        return writeRegisterBlock(devReg, values, count);
+
+    if (values == nullptr)
+        return ksfTkErrFail;
+
+    // Stage the values in the cache, then write only what changed
+    for (size_t i = 0; i < count; i++)
+    {
+        sfTkError_t retVal = writeConfigRegister(devReg + i, values[i]);
+        if (retVal != ksfTkErrOk)
+            return retVal;
+    }
+
+    return commit();
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Core::commit(void)
+{
+    if (_shadowDirty == 0)
+        return ksfTkErrOk;
+
+    if (_theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    sfTkError_t retVal;
+
+    for (uint8_t i = 0; i < SFE_XM125_SHADOW_MAX_REGS; i++)
+    {
+        uint32_t bit = (uint32_t)1 << i;
+        if ((_shadowDirty & bit) == 0)
+            continue;
+
+        uint16_t devReg =
+            i < SFE_XM125_SHADOW_BLOCK_MAX ? SFE_XM125_SHADOW_BLOCK_START + i : SFE_XM125_SHADOW_EXTRA_REG;
+
+        // Coalesce the run of adjacent dirty registers into one block write
+        uint8_t last = i;
+        while (last + 1 < SFE_XM125_SHADOW_BLOCK_MAX && i < SFE_XM125_SHADOW_BLOCK_MAX &&
+               (_shadowDirty & ((uint32_t)1 << (last + 1))))
+            last++;
+
+        // writeRegisterBlock() marks the registers clean
+        retVal = writeRegisterBlock(devReg, &_shadow[i], last - i + 1);
+        if (retVal != ksfTkErrOk)
+            return retVal;
+
+        i = last;
+    }
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Core::readConfigRegister(uint16_t devReg, uint32_t &value)
+{
+    int8_t index = _shadowEnabled ? shadowIndex(devReg) : -1;
+    uint32_t bit = index < 0 ? 0 : (uint32_t)1 << index;
+
+    if (_shadowValid & bit)
+    {
+        value = _shadow[index];
+        return ksfTkErrOk;
+    }
+
+    sfTkError_t retVal = _theBus->readRegister(devReg, value);
+    if (retVal == ksfTkErrOk && bit != 0)
+    {
+        _shadow[index] = value;
+        _shadowValid |= bit;
+    }
+    return retVal;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Core::writeConfigRegister(uint16_t devReg, uint32_t value)
+{
+    int8_t index = _shadowEnabled ? shadowIndex(devReg) : -1;
+    if (index < 0)
+        return _theBus->writeRegister(devReg, value);
+
+    uint32_t bit = (uint32_t)1 << index;
+
+    // Unchanged values need no write
+    if ((_shadowValid & bit) && _shadow[index] == value)
+        return ksfTkErrOk;
+
+    _shadow[index] = value;
+    _shadowValid |= bit;
+    _shadowDirty |= bit;
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Core::readConfigRegisterUInt8(uint16_t devReg, uint8_t &value)
+{
+    // The registers are 32 bit words on the bus, flags included - a shorter read is a packet length error
+    uint32_t regVal = 0;
+
+    sfTkError_t retVal = readConfigRegister(devReg, regVal);
+    if (retVal == ksfTkErrOk)
+        value = (uint8_t)regVal;
+
+    return retVal;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Core::writeConfigRegisterUInt8(uint16_t devReg, uint8_t value)
+{
+    return writeConfigRegister(devReg, (uint32_t)value);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Core::readConfigRegisters(uint32_t *regVals)
+{
+    uint8_t count = configRegisterCount() - 1;
+
+    sfTkError_t retVal = readRegisterBlock(SFE_XM125_SHADOW_BLOCK_START, regVals, count);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    // Not adjacent to the block - and read as a full word, whatever the shadow cache holds for it
+    return _theBus->readRegister(SFE_XM125_SHADOW_EXTRA_REG, regVals[count]);
+}
+
+//--------------------------------------------------------------------------------
+uint32_t sfDevXM125Core::configHash(const uint32_t *regVals, uint8_t count)
+{
+    uint32_t hash = SFE_XM125_CONFIG_HASH_BASIS;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        for (uint8_t shift = 0; shift < 32; shift += 8)
+        {
+            hash ^= (uint8_t)(regVals[i] >> shift);
+            hash *= SFE_XM125_CONFIG_HASH_PRIME;
+        }
+    }
+
+    return hash;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Core::rememberAppliedConfig(void)
+{
+    uint32_t regVals[SFE_XM125_SHADOW_MAX_REGS];
+
+    _appliedConfigKnown = readConfigRegisters(regVals) == ksfTkErrOk;
+    if (_appliedConfigKnown)
+        _appliedConfigHash = configHash(regVals, configRegisterCount());
+}
@@ -19,20 +19,472 @@
 // Bus interfaces
 #include <sfTk/sfTkII2C.h>
 
+#include "sfDevXM125Field.h"
+#include "sfDevXM125Timing.h"
+
 // The I2C address for the device
 const uint16_t SFE_XM125_I2C_ADDRESS = 0x52;
 
+// Addresses selected by the module I2C_ADDR pin - low, not connected (default) and high
+const uint16_t SFE_XM125_I2C_ADDRESS_LOW = 0x51;
+const uint16_t SFE_XM125_I2C_ADDRESS_HIGH = 0x53;
+
+// XM125 library status codes - following the toolkit convention, errors are < 0 and status values are > 0
+const sfTkError_t ksfTkErrXM125Base = 0x3000;
+const sfTkError_t ksfTkErrXM125Busy = ksfTkErrXM125Base + 1;                    // operation still in progress
+const sfTkError_t ksfTkErrXM125Timeout = ksfTkErrFail * (ksfTkErrXM125Base + 2); // device did not finish in time
+const sfTkError_t ksfTkErrXM125Detector = ksfTkErrFail * (ksfTkErrXM125Base + 3); // detector reported an error
+const sfTkError_t ksfTkErrXM125Timing = ksfTkErrFail * (ksfTkErrXM125Base + 4);   // frame rate can not be reached
+
+// Busy wait timing defaults - all values in milliseconds
+const uint32_t SFE_XM125_BUSY_WAIT_TIMEOUT_DEFAULT = 5000;
+const uint32_t SFE_XM125_POLL_INTERVAL_DEFAULT = 2;
+const uint32_t SFE_XM125_POLL_INTERVAL_MAX = 64;
+
+// How the detector status register is polled while waiting for the busy bit to clear
+typedef enum
+{
+    XM125_POLL_FIXED = 0,    // poll every SFE_XM125_POLL_INTERVAL_DEFAULT ms
+    XM125_POLL_BACKOFF = 1,  // double the poll interval after each busy read, up to SFE_XM125_POLL_INTERVAL_MAX ms
+    XM125_POLL_EXPECTED = 2, // wait the expected duration before the first read, then poll at the fixed interval
+} sfe_xm125_poll_strategy_t;
+
+// Fixed delay used between setup steps in XM125_WAIT_FIXED_DELAY mode
+const uint32_t SFE_XM125_FIXED_DELAY_MS = 100;
+
+// How setup and measurement sequences wait for the device between steps
+typedef enum
+{
+    XM125_WAIT_FIXED_DELAY = 0, // sleep SFE_XM125_FIXED_DELAY_MS after each step (original behavior)
+    XM125_WAIT_STATUS = 1,      // only wait until the detector status busy bit shows a command has finished
+} sfe_xm125_wait_mode_t;
+
+// The shadow cache holds the app configuration block, which starts at SFE_XM125_SHADOW_BLOCK_START,
+// plus the single configuration register at SFE_XM125_SHADOW_EXTRA_REG
+const uint16_t SFE_XM125_SHADOW_BLOCK_START = 0x40;
+const uint16_t SFE_XM125_SHADOW_EXTRA_REG = 0x80;
+const uint8_t SFE_XM125_SHADOW_BLOCK_MAX = 22; // largest app configuration block - presence 0x40 - 0x55
+const uint8_t SFE_XM125_SHADOW_MAX_REGS = SFE_XM125_SHADOW_BLOCK_MAX + 1;
+
+// Largest number of registers written in one bus transaction by a block write. The default keeps a
+// write, with its 2 byte register address, inside a 32 byte I2C buffer - see setMaxWriteBurst().
+const uint8_t SFE_XM125_WRITE_BURST_DEFAULT = 7;
+const uint8_t SFE_XM125_WRITE_BURST_MAX = 32;
+
+// FNV-1a parameters of the configuration hash used by the fast restart
+const uint32_t SFE_XM125_CONFIG_HASH_BASIS = 2166136261UL;
+const uint32_t SFE_XM125_CONFIG_HASH_PRIME = 16777619UL;
+
+// State of a non-blocking busy wait - see startBusyPoll() and pollBusy()
+typedef struct
+{
+    uint32_t startMs;    // time the wait was started
+    uint32_t nextPollMs; // time of the next status register read
+    uint32_t intervalMs; // current poll interval
+    uint32_t timeoutMs;  // time allowed for the device to clear the busy bit
+    uint32_t status;     // last value read from the detector status register
+    uint16_t polls;      // number of status register reads performed
+    uint8_t strategy;    // sfe_xm125_poll_strategy_t
+} sfe_xm125_busy_poll_t;
+
+// Detector status flags - the steps of the detector setup, numbered the same for both detectors.
+// Each flag is reported as completed and/or failed by sfDevXM125Status.
+const uint16_t SFE_XM125_STATUS_RSS_REGISTER = 0x0001;
+const uint16_t SFE_XM125_STATUS_CONFIG_CREATE = 0x0002;
+const uint16_t SFE_XM125_STATUS_SENSOR_CREATE = 0x0004;
+const uint16_t SFE_XM125_STATUS_SENSOR_CALIBRATE = 0x0008;
+const uint16_t SFE_XM125_STATUS_DETECTOR_CREATE = 0x0010;
+const uint16_t SFE_XM125_STATUS_DETECTOR_BUFFER = 0x0020;
+const uint16_t SFE_XM125_STATUS_SENSOR_BUFFER = 0x0040;
+const uint16_t SFE_XM125_STATUS_CALIBRATION_BUFFER = 0x0080;
+const uint16_t SFE_XM125_STATUS_CONFIG_APPLY = 0x0100;
+const uint16_t SFE_XM125_STATUS_DETECTOR_CALIBRATE = 0x0200;
+const uint16_t SFE_XM125_STATUS_DETECTOR = 0x0400; // detector error, no completed bit
+
+// Marks a status table entry without a completed bit
+const uint8_t SFE_XM125_STATUS_NO_BIT = 0xff;
+
+// Entry of a detector status table - where one status flag lives in the status register. A table
+// lists the steps in the setup order of its detector, which is also their register bit order.
+typedef struct
+{
+    uint8_t okBit;      // register bit set when the step completed, SFE_XM125_STATUS_NO_BIT if none
+    uint8_t errorBit;   // register bit set when the step failed
+    uint8_t flagBit;    // bit of the SFE_XM125_STATUS_* flag
+    uint8_t legacyCode; // value returned by getDetectorErrorStatus() for this error
+} sfe_xm125_status_entry_t;
+
+/// @brief Decoded detector status register - all completed and failed steps, and the busy bit
+class sfDevXM125Status
+{
+  public:
+    sfDevXM125Status() : _raw{0}, _ok{0}, _errors{0}, _firstError{0}, _busy{false}
+    {
+    }
+
+    /// @brief Decodes a status register value
+    /// @param regVal Value of the detector status register
+    /// @param table Status table of the detector, in setup order
+    /// @param count Number of table entries
+    /// @param busyMask Busy bit in the status register
+    void decode(uint32_t regVal, const sfe_xm125_status_entry_t *table, uint8_t count, uint32_t busyMask);
+
+    /// @brief Returns the decoded status register value
+    uint32_t raw(void)
+    {
+        return _raw;
+    }
+
+    /// @brief Returns the completed steps (SFE_XM125_STATUS_* flags)
+    uint16_t completedFlags(void)
+    {
+        return _ok;
+    }
+
+    /// @brief Returns the failed steps (SFE_XM125_STATUS_* flags)
+    uint16_t errorFlags(void)
+    {
+        return _errors;
+    }
+
+    /// @brief Returns true if the step has completed
+    /// @param flag SFE_XM125_STATUS_* flag
+    bool completed(uint16_t flag)
+    {
+        return (_ok & flag) != 0;
+    }
+
+    /// @brief Returns true if the step has failed
+    /// @param flag SFE_XM125_STATUS_* flag
+    bool failed(uint16_t flag)
+    {
+        return (_errors & flag) != 0;
+    }
+
+    /// @brief Returns true if any step has failed
+    bool hasError(void)
+    {
+        return _errors != 0;
+    }
+
+    /// @brief Returns true while the detector is busy
+    bool busy(void)
+    {
+        return _busy;
+    }
+
+    /// @brief Returns the first step that failed (SFE_XM125_STATUS_* flag), 0 if none
+    uint16_t firstError(void)
+    {
+        return _firstError;
+    }
+
+    /// @brief Returns the number of the first step that failed - 1 for SFE_XM125_STATUS_RSS_REGISTER
+    ///  up to 11 for SFE_XM125_STATUS_DETECTOR, the same for both detectors - or 0 if none
+    uint8_t firstErrorCode(void)
+    {
+        return _firstError == 0 ? 0 : (uint8_t)(__builtin_ctz(_firstError) + 1);
+    }
+
+  private:
+    uint32_t _raw;
+    uint16_t _ok;
+    uint16_t _errors;
+    uint16_t _firstError;
+    bool _busy;
+};
+
+template <class TDevice> class sfDevXM125SetupOp;
+
 class sfDevXM125Core
 {
+    // Records the applied configuration when a resumable setup finishes
+    template <class TDevice> friend class sfDevXM125SetupOp;
+
   public:
     /// @brief Initializer
-    sfDevXM125Core() : _theBus{nullptr} {};
+    /// @param shadowBlockEnd Last register of the app configuration block held in the shadow cache
+    sfDevXM125Core(uint16_t shadowBlockEnd = SFE_XM125_SHADOW_BLOCK_START)
+        : _theBus{nullptr}, _waitMode{XM125_WAIT_FIXED_DELAY}, _shadowEnabled{false}, _shadowBlockEnd{shadowBlockEnd},
+          _shadowValid{0}, _shadowDirty{0}, _maxWriteBurst{SFE_XM125_WRITE_BURST_DEFAULT},
+          _lastStatus{0}, _fastRestart{true}, _appliedConfigKnown{false}, _appliedConfigHash{0}, _timingCheck{false} {};
 
     /// @brief This function begins the examples/communication.
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t init(sfTkII2C *theBus = nullptr);
 
+    /// @brief Sets how setup and measurement sequences wait between steps. XM125_WAIT_STATUS
+    ///  removes the fixed delays and relies on the detector status busy bit only.
+    /// @param mode The wait mode to use
+    void setWaitMode(sfe_xm125_wait_mode_t mode)
+    {
+        _waitMode = mode;
+    }
+
+    /// @brief Returns the current wait mode
+    /// @return The wait mode in use
+    sfe_xm125_wait_mode_t waitMode(void)
+    {
+        return _waitMode;
+    }
+
+    /// @brief Prepares a non-blocking busy wait. Call after issuing a command, then call
+    ///  pollBusy() until it returns a value other than ksfTkErrXM125Busy.
+    /// @param poll Busy wait state to initialize
+    /// @param timeoutMs Time allowed for the device to clear the busy bit
+    /// @param strategy How the status register is polled
+    /// @param expectedMs Expected command duration, used by XM125_POLL_EXPECTED
+    void startBusyPoll(sfe_xm125_busy_poll_t &poll, uint32_t timeoutMs = SFE_XM125_BUSY_WAIT_TIMEOUT_DEFAULT,
+                       sfe_xm125_poll_strategy_t strategy = XM125_POLL_FIXED, uint32_t expectedMs = 0);
+
+    /// @brief Enables or disables the configuration register shadow cache. While enabled,
+    ///  configuration getters are served from the cache once a value is known, and setters
+    ///  only update the cache and mark the register dirty. Dirty registers are written to the
+    ///  device by commit(), which is also run before the configuration is applied.
+    ///  Note: Disabling the cache discards any changes not yet committed.
+    /// @param enable Enable the cache
+    void enableShadowCache(bool enable);
+
+    /// @brief Returns true if the configuration register shadow cache is enabled
+    bool shadowCacheEnabled(void)
+    {
+        return _shadowEnabled;
+    }
+
+    /// @brief Writes all dirty configuration registers in the shadow cache to the device
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t commit(void);
+
+    /// @brief Marks all cached configuration values as unknown, so the next getter reads the
+    ///  device. Changes not yet committed are kept.
+    void invalidateShadowCache(void)
+    {
+        _shadowValid = _shadowDirty;
+    }
+
+    /// @brief Sets the largest number of registers written in a single bus transaction by
+    ///  block writes. Raise it on platforms whose I2C driver buffers more than 32 bytes.
+    /// @param nRegisters Registers per write - 1 to SFE_XM125_WRITE_BURST_MAX
+    void setMaxWriteBurst(uint8_t nRegisters)
+    {
+        _maxWriteBurst = nRegisters == 0                          ? 1
+                         : nRegisters > SFE_XM125_WRITE_BURST_MAX ? SFE_XM125_WRITE_BURST_MAX
+                                                                  : nRegisters;
+    }
+
+    /// @brief Enables or disables the fast restart. While enabled, a setup that would apply the
+    ///  configuration the module already runs skips the module reset and the apply, and only
+    ///  recalibrates when the detector asks for it. The configuration registers are read back and
+    ///  hashed to check that nothing changed since the last setup.
+    /// @param enable Enable the fast restart
+    void enableFastRestart(bool enable)
+    {
+        _fastRestart = enable;
+    }
+
+    /// @brief Returns true if the fast restart is enabled
+    bool fastRestartEnabled(void)
+    {
+        return _fastRestart;
+    }
+
+    /// @brief Enables or disables the timing check - disabled by default. While enabled, a setup
+    ///  estimates the timing of the configuration with sfDevXM125Timing before applying it, and
+    ///  fails with ksfTkErrXM125Timing when the requested frame rate can not be reached. The
+    ///  estimate is approximate, so a configuration close to the limit the module accepts may be
+    ///  rejected - check estimateTiming() against the module before relying on it.
+    /// @param enable Enable the timing check
+    void enableTimingCheck(bool enable)
+    {
+        _timingCheck = enable;
+    }
+
+    /// @brief Returns true if the timing check is enabled
+    bool timingCheckEnabled(void)
+    {
+        return _timingCheck;
+    }
+
+    /// @brief Estimates the duration of a sweep over a distance interval with the timing model of
+    ///  sfDevXM125Timing - automatic PRF, ready state between sweeps
+    /// @param startMm Start of the interval in mm
+    /// @param endMm End of the interval in mm
+    /// @param stepLength Step length in points - 0 uses the automatic step length of the profile
+    /// @param profile Profile 1 - 5
+    /// @param hwaas Hardware accelerated average samples per point
+    /// @return Sweep duration in microseconds
+    static uint32_t estimateSweepUs(uint32_t startMm, uint32_t endMm, uint32_t stepLength, uint32_t profile,
+                                    uint32_t hwaas);
+
   protected:
+    /// @brief Performs one step of a busy wait - reads the status register if a poll is due.
+    /// @param statusReg Detector status register
+    /// @param busyMask Busy bit(s) in the status register
+    /// @param poll Busy wait state from startBusyPoll()
+    /// @return ksfTkErrOk when not busy, ksfTkErrXM125Busy while busy, ksfTkErrXM125Timeout or a bus error
+    sfTkError_t pollBusyStatus(uint16_t statusReg, uint32_t busyMask, sfe_xm125_busy_poll_t &poll);
+
+    /// @brief Blocks until the busy bit clears or the timeout expires, sleeping between polls.
+    ///  The last status register value read is kept in _lastStatus.
+    /// @param statusReg Detector status register
+    /// @param busyMask Busy bit(s) in the status register
+    /// @param timeoutMs Time allowed for the device to clear the busy bit
+    /// @param strategy How the status register is polled
+    /// @param expectedMs Expected command duration, used by XM125_POLL_EXPECTED
+    /// @return ksfTkErrOk when not busy, ksfTkErrXM125Timeout or a bus error
+    sfTkError_t busyWaitStatus(uint16_t statusReg, uint32_t busyMask, uint32_t timeoutMs,
+                               sfe_xm125_poll_strategy_t strategy, uint32_t expectedMs);
+
+    /// @brief Returns the getDetectorErrorStatus() code of a status register value - the code of
+    ///  the lowest error bit set, else busyCode if the busy bit is set, else 0.
+    /// @param regVal Value of the detector status register
+    /// @param table Status table of the detector, in setup order
+    /// @param count Number of table entries
+    /// @param busyMask Busy bit in the status register
+    /// @param busyCode Code returned when only the busy bit is set
+    static uint32_t statusErrorCode(uint32_t regVal, const sfe_xm125_status_entry_t *table, uint8_t count,
+                                    uint32_t busyMask, uint32_t busyCode);
+
+    /// @brief Reads a run of consecutive 32-bit registers in a single bus transaction.
+    ///  The device returns the registers as big-endian words, which are decoded into values.
+    /// @param devReg First register to read
+    /// @param values Array to hold the decoded register values
+    /// @param count Number of registers to read
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readRegisterBlock(uint16_t devReg, uint32_t *values, size_t count);
+
+    /// @brief Reads the register of a field and returns the value of the field
+    /// @param value Field value, converted to the type of value - unchanged on error
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    template <class TField, class TValue> sfTkError_t readField(TValue &value)
+    {
+        uint32_t regVal = 0;
+        sfTkError_t retVal = _theBus->readRegister(TField::reg, regVal);
+        if (retVal == ksfTkErrOk)
+            value = TField::get(regVal);
+
+        return retVal;
+    }
+
+    /// @brief Writes a run of consecutive 32-bit registers as big-endian words, using as few
+    ///  auto-incrementing bus transactions as the write burst size allows. Written values
+    ///  update the shadow cache when it is enabled.
+    /// @param devReg First register to write
+    /// @param values Register values to write
+    /// @param count Number of registers to write
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeRegisterBlock(uint16_t devReg, const uint32_t *values, size_t count);
+
+    /// @brief Writes a run of consecutive configuration registers. With the shadow cache
+    ///  enabled only the registers that change are written, coalesced into block writes.
+    /// @param devReg First register to write
+    /// @param values Register values to write
+    /// @param count Number of registers to write
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeConfigRegisterBlock(uint16_t devReg, const uint32_t *values, size_t count);
+
+    /// @brief Gives a command or register write time to take effect. Sleeps for
+    ///  SFE_XM125_FIXED_DELAY_MS in XM125_WAIT_FIXED_DELAY mode, returns at once otherwise.
+    void settle(void)
+    {
+        if (_waitMode == XM125_WAIT_FIXED_DELAY)
+            sftk_delay_ms(SFE_XM125_FIXED_DELAY_MS);
+    }
+
+    /// @brief Reads a 32-bit configuration register - from the shadow cache when enabled and known
+    /// @param devReg Configuration register
+    /// @param value Register value
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readConfigRegister(uint16_t devReg, uint32_t &value);
+
+    /// @brief Writes a 32-bit configuration register - to the shadow cache when enabled
+    /// @param devReg Configuration register
+    /// @param value Register value
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeConfigRegister(uint16_t devReg, uint32_t value);
+
+    /// @brief Reads a configuration flag - a full 32 bit register, from the shadow cache when enabled
+    ///  and known
+    /// @param devReg Configuration register
+    /// @param value Register value
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readConfigRegisterUInt8(uint16_t devReg, uint8_t &value);
+
+    /// @brief Writes a configuration flag as a full 32 bit register - to the shadow cache when enabled
+    /// @param devReg Configuration register
+    /// @param value Register value
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeConfigRegisterUInt8(uint16_t devReg, uint8_t value);
+
+    /// @brief Returns the number of configuration registers read by readConfigRegisters() - the
+    ///  app configuration block plus the register at SFE_XM125_SHADOW_EXTRA_REG
+    uint8_t configRegisterCount(void)
+    {
+        return _shadowBlockEnd - SFE_XM125_SHADOW_BLOCK_START + 2;
+    }
+
+    /// @brief Reads the configuration registers from the device, in register order
+    /// @param regVals Array of configRegisterCount() register values
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readConfigRegisters(uint32_t *regVals);
+
+    /// @brief Returns the FNV-1a hash of configuration register values
+    /// @param regVals Register values
+    /// @param count Number of registers
+    static uint32_t configHash(const uint32_t *regVals, uint8_t count);
+
+    /// @brief Records the configuration registers just applied by a setup, for the fast restart
+    void rememberAppliedConfig(void);
+
+    /// @brief Forgets the applied configuration - the next setup runs in full
+    void forgetAppliedConfig(void)
+    {
+        _appliedConfigKnown = false;
+    }
+
+    /// @brief Returns true if a setup may try the fast restart - it is enabled, the configuration
+    ///  applied by the last setup is known, and no changes wait in the shadow cache
+    bool fastRestartPossible(void)
+    {
+        return _fastRestart && _appliedConfigKnown && _shadowDirty == 0;
+    }
+
+    /// @brief Returns true if configuration registers read by readConfigRegisters() hold the values
+    ///  applied by the last setup
+    /// @param regVals Array of configRegisterCount() register values
+    bool appliedConfigMatches(const uint32_t *regVals)
+    {
+        return configHash(regVals, configRegisterCount()) == _appliedConfigHash;
+    }
+
+    /// @brief Returns the shadow cache slot for a register, or -1 if the register is not cached
+    int8_t shadowIndex(uint16_t devReg);
+
     // our toolkit bus
     sfTkII2C *_theBus;
+
+    // how sequences wait between steps
+    sfe_xm125_wait_mode_t _waitMode;
+
+    // Configuration register shadow cache - one bit per slot in the valid/dirty masks
+    bool _shadowEnabled;
+    uint16_t _shadowBlockEnd;
+    uint32_t _shadowValid;
+    uint32_t _shadowDirty;
+    uint32_t _shadow[SFE_XM125_SHADOW_MAX_REGS];
+
+    // registers per block write transaction
+    uint8_t _maxWriteBurst;
+
+    // detector status register value read by the last busy wait - checked for errors without
+    // reading the register again
+    uint32_t _lastStatus;
+
+    // Fast restart - hash of the configuration registers applied by the last setup
+    bool _fastRestart;
+    bool _appliedConfigKnown;
+    uint32_t _appliedConfigHash;
+
+    // Reject configurations that miss their frame rate before applying them - opt-in
+    bool _timingCheck;
 };
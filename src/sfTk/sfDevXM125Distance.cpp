@@ -18,6 +18,37 @@
 
 #include "sfDevXM125Distance.h"
 
+// Bit fields of the distance detector registers
+typedef sfDevXM125DistanceFields Fields;
+
+// Detector status register layout, in setup order - the order getDetectorErrorStatus() checks the
+// errors in. The sensor is calibrated after the configuration is applied.
+static constexpr sfe_xm125_status_entry_t kDistanceStatusTable[] = {
+    // SFE_XM125_STATUS_RSS_REGISTER
+    {Fields::RssRegisterOk::offset, Fields::RssRegisterError::offset, 0, 1},
+    // SFE_XM125_STATUS_CONFIG_CREATE
+    {Fields::ConfigCreateOk::offset, Fields::ConfigCreateError::offset, 1, 2},
+    // SFE_XM125_STATUS_SENSOR_CREATE
+    {Fields::SensorCreateOk::offset, Fields::SensorCreateError::offset, 2, 3},
+    // SFE_XM125_STATUS_DETECTOR_CREATE
+    {Fields::DetectorCreateOk::offset, Fields::DetectorCreateError::offset, 4, 5},
+    // SFE_XM125_STATUS_DETECTOR_BUFFER
+    {Fields::DetectorBufferOk::offset, Fields::DetectorBufferError::offset, 5, 6},
+    // SFE_XM125_STATUS_SENSOR_BUFFER
+    {Fields::SensorBufferOk::offset, Fields::SensorBufferError::offset, 6, 7},
+    // SFE_XM125_STATUS_CALIBRATION_BUFFER
+    {Fields::CalibrationBufferOk::offset, Fields::CalibrationBufferError::offset, 7, 8},
+    // SFE_XM125_STATUS_CONFIG_APPLY
+    {Fields::ConfigApplyOk::offset, Fields::ConfigApplyError::offset, 8, 9},
+    // SFE_XM125_STATUS_SENSOR_CALIBRATE
+    {Fields::SensorCalibrateOk::offset, Fields::SensorCalibrateError::offset, 3, 10},
+    // SFE_XM125_STATUS_DETECTOR_CALIBRATE
+    {Fields::DetectorCalibrateOk::offset, Fields::DetectorCalibrateError::offset, 9, 11},
+    // SFE_XM125_STATUS_DETECTOR
+    {SFE_XM125_STATUS_NO_BIT, Fields::DetectorError::offset, 10, 12},
+};
+static constexpr uint8_t kDistanceStatusTableSize = sizeof(kDistanceStatusTable) / sizeof(kDistanceStatusTable[0]);
+
 //------------------------------------------------------------------
 // begin method - overrides the super class begin -
 //
@@ -45,15 +76,19 @@ int32_t sfDevXM125Distance::distanceSetup(uint32_t startRange, uint32_t endRange
 {
     uint32_t errorStatus = 0;
 
+    // Nothing to set up when the module still runs this configuration
+    if (fastRestart(startRange, endRange))
+        return 0;
+
     // *** Distance Sensor Setup ***
     // Reset sensor configuration to reapply configuration registers
     setCommand(SFE_XM125_DISTANCE_RESET_MODULE);
-    sftk_delay_ms(100);
+    settle();
 
-    busyWait();
-
-    // Check error and busy bits
-    if (getDetectorErrorStatus(errorStatus) != 0)
+    // Check error and busy bits - from the status read by the busy wait when it finished
+    if (busyWait() == ksfTkErrOk)
+        errorStatus = busyWaitErrorStatus();
+    else if (getDetectorErrorStatus(errorStatus) != 0)
     {
         return 1;
     }
@@ -68,14 +103,14 @@ int32_t sfDevXM125Distance::distanceSetup(uint32_t startRange, uint32_t endRange
     {
         return 3;
     }
-    sftk_delay_ms(100); // give time for command to set
+    settle(); // give time for command to set
 
     // Set End register
     if (setEnd(endRange) != 0)
     {
         return 4;
     }
-    sftk_delay_ms(100); // give time for command to set
+    settle(); // give time for command to set
 
     // Apply configuration and calibrate.
     if (setCommand(SFE_XM125_DISTANCE_APPLY_CONFIGURATION) != 0)
@@ -96,17 +131,70 @@ int32_t sfDevXM125Distance::distanceSetup(uint32_t startRange, uint32_t endRange
         return 7;
     }
 
-    // Check detector status
-    getDetectorErrorStatus(errorStatus);
+    // Check detector status - the busy wait has just read it
+    errorStatus = busyWaitErrorStatus();
     if (errorStatus != 0)
     {
         return 7;
     }
 
+    // Keep what was applied, for the next setup
+    rememberAppliedConfig();
+
     // Return 0 on no error
     return 0;
 }
 
+//--------------------------------------------------------------------------------
+bool sfDevXM125Distance::fastRestart(uint32_t startRange, uint32_t endRange)
+{
+    if (!fastRestartPossible())
+        return false;
+
+    // Same range, and no configuration register changed since the last setup applied them
+    uint32_t regVals[SFE_XM125_DISTANCE_CONFIG_REGS + 1];
+    if (readConfigRegisters(regVals) != ksfTkErrOk)
+        return false;
+
+    if (regVals[SFE_XM125_DISTANCE_START - SFE_XM125_DISTANCE_START] != startRange ||
+        regVals[SFE_XM125_DISTANCE_END - SFE_XM125_DISTANCE_START] != endRange || !appliedConfigMatches(regVals))
+        return false;
+
+    // The module must still run it - applied and calibrated, without errors. A module that was
+    // reset or power cycled since has not applied any configuration.
+    sfDevXM125Status status;
+    if (getStatus(status) != ksfTkErrOk)
+        return false;
+
+    // Let a command still running - a measurement or a recalibration - finish first
+    if (status.busy())
+    {
+        if (busyWait() != ksfTkErrOk)
+            return false;
+        decodeStatus(_lastStatus, status);
+    }
+
+    if (status.hasError())
+        return false;
+
+    const uint16_t applied = SFE_XM125_STATUS_CONFIG_APPLY | SFE_XM125_STATUS_DETECTOR_CALIBRATE;
+    if ((status.completedFlags() & applied) != applied)
+        return false;
+
+    // Recalibrate only when the last measurement asked for it
+    bool calibrationNeeded = false;
+    if (readField<Fields::CalibrationNeeded>(calibrationNeeded) != ksfTkErrOk)
+        return false;
+
+    if (calibrationNeeded)
+    {
+        if (recalibrate() != ksfTkErrOk || busyWait() != ksfTkErrOk || busyWaitErrorStatus() != 0)
+            return false;
+    }
+
+    return true;
+}
+
 //--------------------------------------------------------------------------------
 int32_t sfDevXM125Distance::detectorReadingSetup()
 {
@@ -126,7 +214,7 @@ int32_t sfDevXM125Distance::detectorReadingSetup()
     {
         return 2;
     }
-    sftk_delay_ms(100); // give time for command to set
+    settle(); // give time for command to set
 
     // Poll detector status until busy bit is cleared - CHECK ON THIS!
     if (busyWait() != 0)
@@ -134,30 +222,37 @@ int32_t sfDevXM125Distance::detectorReadingSetup()
         return 3;
     }
 
-    // Verify that no error bits are set in the detector status register
-    getDetectorErrorStatus(errorStatus);
+    // Verify that no error bits are set in the detector status register read by the busy wait
+    errorStatus = busyWaitErrorStatus();
     if (errorStatus != 0)
     {
         return 4;
     }
-    sftk_delay_ms(100);
+    settle();
+
+    // Read the result register once - the error and calibration flags come from the same measurement
+    sfe_xm125_distance_result_t result;
+    if (readResult(result) != ksfTkErrOk)
+    {
+        return 5;
+    }
 
     // Check MEASURE_DISTANCE_ERROR for measurement failed
-    getMeasureDistanceError(measDistErr);
+    getMeasureDistanceError(result, measDistErr);
     if (measDistErr == 1)
     {
         return 5;
     }
-    sftk_delay_ms(100);
+    settle();
 
     // Recalibrate device if calibration error is triggered
-    getCalibrationNeeded(calibrateNeeded);
+    getCalibrationNeeded(result, calibrateNeeded);
     if (calibrateNeeded == 1)
     {
         setCommand(SFE_XM125_DISTANCE_RECALIBRATE);
         return 6;
     }
-    sftk_delay_ms(100);
+    settle();
 
     return 0;
 }
@@ -172,9 +267,9 @@ sfTkError_t sfDevXM125Distance::getDetectorVersion(uint32_t &major, uint32_t &mi
     retVal = _theBus->readRegister(SFE_XM125_DISTANCE_VERSION, regVal);
 
     // Mask unused bits from register
-    major = (regVal & SFE_XM125_DISTANCE_MAJOR_VERSION_MASK) >> SFE_XM125_DISTANCE_MAJOR_VERSION_MASK_SHIFT;
-    minor = (regVal & SFE_XM125_DISTANCE_MINOR_VERSION_MASK) >> SFE_XM125_DISTANCE_MINOR_VERSION_MASK_SHIFT;
-    patch = regVal & SFE_XM125_DISTANCE_PATCH_VERSION_MASK;
+    major = Fields::MajorVersion::get(regVal);
+    minor = Fields::MinorVersion::get(regVal);
+    patch = Fields::PatchVersion::get(regVal);
 
     return retVal;
 }
@@ -188,9 +283,8 @@ sfTkError_t sfDevXM125Distance::getDetectorError(uint32_t &error)
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getDetectorErrorStatus(uint32_t &status)
 {
-    sfTkError_t retVal;
     uint32_t regVal = 0;
-    retVal = _theBus->readRegister(SFE_XM125_DISTANCE_DETECTOR_STATUS, regVal);
+    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_DISTANCE_DETECTOR_STATUS, regVal);
 
     // No error
     status = 0;
@@ -198,48 +292,34 @@ sfTkError_t sfDevXM125Distance::getDetectorErrorStatus(uint32_t &status)
     if (retVal != ksfTkErrOk)
         return retVal;
 
-    // Any errors - if not, skip the  big bit check pachinko if-else  below
-    if ((regVal & SFE_XM125_DISTANCE_ALL_ERROR_MASK) == 0)
-        return ksfTkErrOk;
-    // okay some bit is set...
-
-    if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_DISTANCE_RSS_REGISTER_ERROR_MASK))
-        status = 1;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_DISTANCE_CONFIG_CREATE_ERROR_MASK))
-        status = 2;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_DISTANCE_SENSOR_CREATE_ERROR_MASK))
-        status = 3;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_DISTANCE_DETECTOR_CREATE_ERROR_MASK))
-        status = 5;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_DISTANCE_DETECTOR_BUFFER_ERROR_MASK))
-        status = 6;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_DISTANCE_SENSOR_BUFFER_ERROR_MASK))
-        status = 7;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_DISTANCE_CALIBRATION_BUFFER_ERROR_MASK))
-        status = 8;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_DISTANCE_CONFIG_APPLY_ERROR_MASK))
-        status = 9;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_DISTANCE_SENSOR_CALIBRATE_ERROR_MASK))
-        status = 10;
+    status = statusErrorCode(regVal, kDistanceStatusTable, kDistanceStatusTableSize, Fields::Busy::mask,
+                             SFE_XM125_DISTANCE_BUSY_ERROR_CODE);
+    return ksfTkErrOk;
+}
 
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_DISTANCE_DETECTOR_CALIBRATE_ERROR_MASK))
-        status = 11;
+//--------------------------------------------------------------------------------
+uint32_t sfDevXM125Distance::busyWaitErrorStatus(void)
+{
+    return statusErrorCode(_lastStatus, kDistanceStatusTable, kDistanceStatusTableSize, Fields::Busy::mask,
+                           SFE_XM125_DISTANCE_BUSY_ERROR_CODE);
+}
 
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_DISTANCE_DETECTOR_ERROR_MASK))
-        status = 12;
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::getStatus(sfDevXM125Status &status)
+{
+    uint32_t regVal = 0;
+    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_DISTANCE_DETECTOR_STATUS, regVal);
+    if (retVal != ksfTkErrOk)
+        return retVal;
 
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_DISTANCE_BUSY_MASK))
-        status = 13;
+    decodeStatus(regVal, status);
+    return ksfTkErrOk;
+}
 
-    return ksfTkErrOk; // return 0  with no errors
+//--------------------------------------------------------------------------------
+void sfDevXM125Distance::decodeStatus(uint32_t regVal, sfDevXM125Status &status)
+{
+    status.decode(regVal, kDistanceStatusTable, kDistanceStatusTableSize, Fields::Busy::mask);
 }
 
 //--------------------------------------------------------------------------------
@@ -255,89 +335,119 @@ sfTkError_t sfDevXM125Distance::getDetectorStatus(uint32_t &status)
 }
 
 //--------------------------------------------------------------------------------
-sfTkError_t sfDevXM125Distance::getNumberDistances(uint32_t &distance)
+sfTkError_t sfDevXM125Distance::readResult(sfe_xm125_distance_result_t &result)
 {
-    sfTkError_t retVal;
     uint32_t regVal = 0;
 
-    // Read from 16-Bit Register
-    retVal = _theBus->readRegister(SFE_XM125_DISTANCE_RESULT, regVal);
+    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_DISTANCE_RESULT, regVal);
+    if (retVal != ksfTkErrOk)
+        return retVal;
 
-    // Mask unused bits from register
-    distance = (regVal & SFE_XM125_DISTANCE_NUMBER_DISTANCES_MASK);
+    // Decode each field using the register fields - keeps the result independent of bit-field layout
+    result.distance_num_distances = Fields::NumDistances::get(regVal);
+    result.rsvd1 = 0;
+    result.distance_near_start_edge = Fields::NearStartEdge::get(regVal);
+    result.distance_calibration_needed = Fields::CalibrationNeeded::get(regVal);
+    result.distance_measure_distance_error = Fields::MeasureDistanceError::get(regVal);
+    result.reserved1 = 0;
+    result.distance_temperature = static_cast<uint16_t>(Fields::Temperature::get(regVal));
 
-    return retVal;
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::getNumberDistances(uint32_t &distance)
+{
+    sfe_xm125_distance_result_t result;
+
+    sfTkError_t retVal = readResult(result);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    return getNumberDistances(result, distance);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::getNumberDistances(const sfe_xm125_distance_result_t &result, uint32_t &distance)
+{
+    distance = result.distance_num_distances;
+    return ksfTkErrOk;
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getNearStartEdge(uint32_t &edge)
 {
-    sfTkError_t retVal;
-    uint32_t regVal = 0;
+    sfe_xm125_distance_result_t result;
 
-    // Read from 16-Bit Register
-    retVal = _theBus->readRegister(SFE_XM125_DISTANCE_RESULT, regVal);
+    sfTkError_t retVal = readResult(result);
     if (retVal != ksfTkErrOk)
         return retVal;
 
-    // Mask unused bits from register
-    edge = (regVal & SFE_XM125_DISTANCE_NEAR_START_EDGE_MASK) >> SFE_XM125_DISTANCE_NEAR_START_EDGE_MASK_SHIFT;
+    return getNearStartEdge(result, edge);
+}
 
-    return retVal;
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::getNearStartEdge(const sfe_xm125_distance_result_t &result, uint32_t &edge)
+{
+    edge = result.distance_near_start_edge;
+    return ksfTkErrOk;
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getCalibrationNeeded(uint32_t &calibrate)
 {
-    sfTkError_t retVal;
-    uint32_t regVal = 0;
+    sfe_xm125_distance_result_t result;
 
-    // Read from 16-Bit Register
-    retVal = _theBus->readRegister(SFE_XM125_DISTANCE_RESULT, regVal);
+    sfTkError_t retVal = readResult(result);
     if (retVal != ksfTkErrOk)
         return retVal;
 
-    // Mask unused bits from register
-    calibrate =
-        (regVal & SFE_XM125_DISTANCE_CALIBRATION_NEEDED_MASK) >> SFE_XM125_DISTANCE_CALIBRATION_NEEDED_MASK_SHIFT;
+    return getCalibrationNeeded(result, calibrate);
+}
 
-    return retVal;
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::getCalibrationNeeded(const sfe_xm125_distance_result_t &result, uint32_t &calibrate)
+{
+    calibrate = result.distance_calibration_needed;
+    return ksfTkErrOk;
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getMeasureDistanceError(uint32_t &error)
 {
-    sfTkError_t retVal;
-    uint32_t regVal = 0;
+    sfe_xm125_distance_result_t result;
 
-    // Read from 16-Bit Register
-    retVal = _theBus->readRegister(SFE_XM125_DISTANCE_RESULT, regVal);
+    sfTkError_t retVal = readResult(result);
     if (retVal != ksfTkErrOk)
         return retVal;
 
-    // Mask unused bits from register
-    error = (regVal & SFE_XM125_DISTANCE_MEASURE_DISTANCE_ERROR_MASK) >>
-            SFE_XM125_DISTANCE_MEASURE_DISTANCE_ERROR_MASK_SHIFT;
+    return getMeasureDistanceError(result, error);
+}
 
-    return retVal;
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::getMeasureDistanceError(const sfe_xm125_distance_result_t &result, uint32_t &error)
+{
+    error = result.distance_measure_distance_error;
+    return ksfTkErrOk;
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getTemperature(int16_t &temperature)
 {
-    sfTkError_t retVal;
-    uint32_t regVal = 0;
+    sfe_xm125_distance_result_t result;
 
-    // Read from 16-Bit Register
-    retVal = _theBus->readRegister(SFE_XM125_DISTANCE_RESULT, regVal);
+    sfTkError_t retVal = readResult(result);
     if (retVal != ksfTkErrOk)
         return retVal;
 
-    // Mask unused bits from register
-    temperature = static_cast<int16_t>((regVal & SFE_XM125_DISTANCE_TEMPERATURE_MASK) >>
-                                       SFE_XM125_DISTANCE_TEMPERATURE_MASK_SHIFT);
+    return getTemperature(result, temperature);
+}
 
-    return retVal;
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::getTemperature(const sfe_xm125_distance_result_t &result, int16_t &temperature)
+{
+    temperature = static_cast<int16_t>(result.distance_temperature);
+    return ksfTkErrOk;
 }
 
 //--------------------------------------------------------------------------------
@@ -545,47 +655,167 @@ sfTkError_t sfDevXM125Distance::getPeak9Strength(int32_t &peak)
     return _theBus->readRegister(SFE_XM125_DISTANCE_PEAK9_STRENGTH, *((uint32_t *)&peak));
 }
 
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::readPeaks(sfe_xm125_distance_peaks_t &peaks)
+{
+    // The distance and strength registers are contiguous - read them all in one transaction
+    uint32_t regVals[SFE_XM125_DISTANCE_MAX_PEAKS * 2];
+
+    sfTkError_t retVal =
+        readRegisterBlock(SFE_XM125_DISTANCE_PEAK0_DISTANCE, regVals, SFE_XM125_DISTANCE_MAX_PEAKS * 2);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    for (uint8_t i = 0; i < SFE_XM125_DISTANCE_MAX_PEAKS; i++)
+    {
+        peaks.distance[i] = regVals[i];
+        peaks.strength[i] = (int32_t)regVals[SFE_XM125_DISTANCE_MAX_PEAKS + i];
+    }
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::readFrame(sfe_xm125_distance_frame_t &frame)
+{
+    // The result register is followed by the distance and strength registers
+    uint32_t regVals[1 + SFE_XM125_DISTANCE_MAX_PEAKS * 2];
+
+    frame.timestamp = sftk_ticks_ms();
+
+    sfTkError_t retVal = getMeasureCounter(frame.measure_counter);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    retVal = readRegisterBlock(SFE_XM125_DISTANCE_RESULT, regVals, 1 + SFE_XM125_DISTANCE_MAX_PEAKS * 2);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    uint32_t result = regVals[0];
+    uint8_t numPeaks = Fields::NumDistances::get(result);
+
+    frame.num_peaks = numPeaks < SFE_XM125_DISTANCE_MAX_PEAKS ? numPeaks : SFE_XM125_DISTANCE_MAX_PEAKS;
+    frame.temperature = Fields::Temperature::get(result);
+    frame.flags = 0;
+    if (Fields::NearStartEdge::get(result))
+        frame.flags |= SFE_XM125_DISTANCE_FRAME_NEAR_START_EDGE;
+    if (Fields::CalibrationNeeded::get(result))
+        frame.flags |= SFE_XM125_DISTANCE_FRAME_CALIBRATION_NEEDED;
+    if (Fields::MeasureDistanceError::get(result))
+        frame.flags |= SFE_XM125_DISTANCE_FRAME_MEASURE_ERROR;
+
+    for (uint8_t i = 0; i < SFE_XM125_DISTANCE_MAX_PEAKS; i++)
+    {
+        if (i >= frame.num_peaks)
+        {
+            frame.distance[i] = 0;
+            frame.strength[i] = 0;
+            continue;
+        }
+
+        // Distances are in mm, strengths a factor 1000 larger than the RSS value in dB
+        uint32_t distance = regVals[1 + i];
+        int32_t strength = (int32_t)regVals[1 + SFE_XM125_DISTANCE_MAX_PEAKS + i] / 10;
+
+        if (distance > UINT16_MAX || strength > INT16_MAX || strength < INT16_MIN)
+            frame.flags |= SFE_XM125_DISTANCE_FRAME_CLAMPED;
+
+        frame.distance[i] = distance > UINT16_MAX ? UINT16_MAX : (uint16_t)distance;
+        frame.strength[i] = strength > INT16_MAX   ? INT16_MAX
+                            : strength < INT16_MIN ? INT16_MIN
+                                                   : (int16_t)strength;
+    }
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::pollFrame(sfe_xm125_distance_poll_t &poll)
+{
+    poll.ready = false;
+
+    // The measure counter and detector status registers are adjacent - one read
+    uint32_t regVals[2];
+    sfTkError_t retVal = readRegisterBlock(SFE_XM125_DISTANCE_MEASURE_COUNTER, regVals, 2);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    sfDevXM125Status status;
+    decodeStatus(regVals[1], status);
+
+    poll.status = regVals[1];
+    poll.status_errors = status.errorFlags();
+    poll.busy = status.busy();
+
+    if (status.hasError())
+        return ksfTkErrXM125Detector;
+
+    // Still measuring, or no measurement since the last ready one - nothing else to read
+    if (poll.busy || regVals[0] == poll.measure_counter)
+        return ksfTkErrOk;
+
+    uint32_t result = 0;
+    retVal = _theBus->readRegister(SFE_XM125_DISTANCE_RESULT, result);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    poll.measure_counter = regVals[0];
+    poll.num_distances = Fields::NumDistances::get(result);
+    poll.temperature = Fields::Temperature::get(result);
+    poll.flags = 0;
+    if (Fields::NearStartEdge::get(result))
+        poll.flags |= SFE_XM125_DISTANCE_FRAME_NEAR_START_EDGE;
+    if (Fields::CalibrationNeeded::get(result))
+        poll.flags |= SFE_XM125_DISTANCE_FRAME_CALIBRATION_NEEDED;
+    if (Fields::MeasureDistanceError::get(result))
+        poll.flags |= SFE_XM125_DISTANCE_FRAME_MEASURE_ERROR;
+
+    poll.ready = true;
+
+    return ksfTkErrOk;
+}
+
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getStart(uint32_t &startVal)
 {
-    return _theBus->readRegister(SFE_XM125_DISTANCE_START, startVal);
+    return readConfigRegister(SFE_XM125_DISTANCE_START, startVal);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::setStart(uint32_t start)
 {
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_START, start);
+    return writeConfigRegister(SFE_XM125_DISTANCE_START, start);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getEnd(uint32_t &end)
 {
-    return _theBus->readRegister(SFE_XM125_DISTANCE_END, end);
+    return readConfigRegister(SFE_XM125_DISTANCE_END, end);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::setEnd(uint32_t end)
 {
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_END, end);
+    return writeConfigRegister(SFE_XM125_DISTANCE_END, end);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getMaxStepLength(uint32_t &length)
 {
-    return _theBus->readRegister(SFE_XM125_DISTANCE_MAX_STEP_LENGTH, length);
+    return readConfigRegister(SFE_XM125_DISTANCE_MAX_STEP_LENGTH, length);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::setMaxStepLength(uint32_t length)
 {
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_MAX_STEP_LENGTH, length);
+    return writeConfigRegister(SFE_XM125_DISTANCE_MAX_STEP_LENGTH, length);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getCloseRangeLeakageCancellation(bool &range)
 {
     uint8_t readVal = 0;
-    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_DISTANCE_CLOSE_RANGE_LEAKAGE, readVal);
+    sfTkError_t retVal = readConfigRegisterUInt8(SFE_XM125_DISTANCE_CLOSE_RANGE_LEAKAGE, readVal);
     if (retVal != ksfTkErrOk)
         return retVal;
 
@@ -597,122 +827,122 @@ sfTkError_t sfDevXM125Distance::getCloseRangeLeakageCancellation(bool &range)
 sfTkError_t sfDevXM125Distance::setCloseRangeLeakageCancellation(bool range)
 {
     uint8_t value = range ? 1 : 0;
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_CLOSE_RANGE_LEAKAGE, value);
+    return writeConfigRegisterUInt8(SFE_XM125_DISTANCE_CLOSE_RANGE_LEAKAGE, value);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getSignalQuality(uint32_t &signal)
 {
-    return _theBus->readRegister(SFE_XM125_DISTANCE_SIGNAL_QUALITY, signal);
+    return readConfigRegister(SFE_XM125_DISTANCE_SIGNAL_QUALITY, signal);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::setSignalQuality(uint32_t signal)
 {
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_SIGNAL_QUALITY, signal);
+    return writeConfigRegister(SFE_XM125_DISTANCE_SIGNAL_QUALITY, signal);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getMaxProfile(uint32_t &profile)
 {
-    return _theBus->readRegister(SFE_XM125_DISTANCE_MAX_PROFILE, profile);
+    return readConfigRegister(SFE_XM125_DISTANCE_MAX_PROFILE, profile);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::setMaxProfile(uint32_t profile)
 {
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_MAX_PROFILE, profile);
+    return writeConfigRegister(SFE_XM125_DISTANCE_MAX_PROFILE, profile);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getThresholdMethod(uint32_t &method)
 {
-    return _theBus->readRegister(SFE_XM125_DISTANCE_THRESHOLD_METHOD, method);
+    return readConfigRegister(SFE_XM125_DISTANCE_THRESHOLD_METHOD, method);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::setThresholdMethod(uint32_t method)
 {
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_THRESHOLD_METHOD, method);
+    return writeConfigRegister(SFE_XM125_DISTANCE_THRESHOLD_METHOD, method);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getPeakSorting(uint32_t &peak)
 {
-    return _theBus->readRegister(SFE_XM125_DISTANCE_PEAK_SORTING, peak);
+    return readConfigRegister(SFE_XM125_DISTANCE_PEAK_SORTING, peak);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::setPeakSorting(uint32_t peak)
 {
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_PEAK_SORTING, peak);
+    return writeConfigRegister(SFE_XM125_DISTANCE_PEAK_SORTING, peak);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getNumFramesRecordedThreshold(uint32_t &thresh)
 {
-    return _theBus->readRegister(SFE_XM125_DISTANCE_NUM_FRAMES_RECORDED_THRESH, thresh);
+    return readConfigRegister(SFE_XM125_DISTANCE_NUM_FRAMES_RECORDED_THRESH, thresh);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::setNumFramesRecordedThreshold(uint32_t thresh)
 {
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_NUM_FRAMES_RECORDED_THRESH, thresh);
+    return writeConfigRegister(SFE_XM125_DISTANCE_NUM_FRAMES_RECORDED_THRESH, thresh);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getFixedAmpThreshold(uint32_t &thresh)
 {
-    return _theBus->readRegister(SFE_XM125_DISTANCE_FIXED_AMPLITUDE_THRESHOLD_VAL, thresh);
+    return readConfigRegister(SFE_XM125_DISTANCE_FIXED_AMPLITUDE_THRESHOLD_VAL, thresh);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::setFixedAmpThreshold(uint32_t thresh)
 {
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_FIXED_AMPLITUDE_THRESHOLD_VAL, thresh);
+    return writeConfigRegister(SFE_XM125_DISTANCE_FIXED_AMPLITUDE_THRESHOLD_VAL, thresh);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getThresholdSensitivity(uint32_t &thresh)
 {
-    return _theBus->readRegister(SFE_XM125_DISTANCE_THREHSOLD_SENSITIVITY, thresh);
+    return readConfigRegister(SFE_XM125_DISTANCE_THREHSOLD_SENSITIVITY, thresh);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::setThresholdSensitivity(uint32_t thresh)
 {
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_THREHSOLD_SENSITIVITY, thresh);
+    return writeConfigRegister(SFE_XM125_DISTANCE_THREHSOLD_SENSITIVITY, thresh);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getReflectorShape(uint32_t &shape)
 {
-    return _theBus->readRegister(SFE_XM125_DISTANCE_REFLECTOR_SHAPE, shape);
+    return readConfigRegister(SFE_XM125_DISTANCE_REFLECTOR_SHAPE, shape);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::setReflectorShape(uint32_t shape)
 {
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_REFLECTOR_SHAPE, shape);
+    return writeConfigRegister(SFE_XM125_DISTANCE_REFLECTOR_SHAPE, shape);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getFixedStrengthThresholdValue(int32_t &thresh)
 {
-    return _theBus->readRegister(SFE_XM125_DISTANCE_FIXED_STRENGTH_THRESHOLD_VAL, *((uint32_t *)&thresh));
+    return readConfigRegister(SFE_XM125_DISTANCE_FIXED_STRENGTH_THRESHOLD_VAL, *((uint32_t *)&thresh));
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::setFixedStrengthThresholdValue(int32_t thresh)
 {
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_FIXED_STRENGTH_THRESHOLD_VAL, *((uint32_t *)&thresh));
+    return writeConfigRegister(SFE_XM125_DISTANCE_FIXED_STRENGTH_THRESHOLD_VAL, *((uint32_t *)&thresh));
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::getMeasureOneWakeup(bool &measure)
 {
     uint8_t value;
-    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_DISTANCE_MEASURE_ON_WAKEUP, value);
+    sfTkError_t retVal = readConfigRegisterUInt8(SFE_XM125_DISTANCE_MEASURE_ON_WAKEUP, value);
     measure = static_cast<bool>(value);
     return retVal;
 }
@@ -721,13 +951,160 @@ sfTkError_t sfDevXM125Distance::getMeasureOneWakeup(bool &measure)
 sfTkError_t sfDevXM125Distance::setMeasureOneWakeup(bool measure)
 {
     uint8_t value = static_cast<uint8_t>(measure);
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_MEASURE_ON_WAKEUP, value);
+    return writeConfigRegisterUInt8(SFE_XM125_DISTANCE_MEASURE_ON_WAKEUP, value);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Distance::setCommand(uint32_t command)
 {
-    return _theBus->writeRegister(SFE_XM125_DISTANCE_COMMAND, command);
+    // Flush any cached configuration changes before the device uses them
+    if (command == SFE_XM125_DISTANCE_APPLY_CONFIGURATION || command == SFE_XM125_DISTANCE_START_DETECTOR)
+    {
+        sfTkError_t retVal = commit();
+        if (retVal != ksfTkErrOk)
+            return retVal;
+    }
+
+    // A reset or an apply replaces the applied configuration - the next setup runs in full
+    if (command == SFE_XM125_DISTANCE_RESET_MODULE || command == SFE_XM125_DISTANCE_APPLY_CONFIGURATION)
+        forgetAppliedConfig();
+
+    sfTkError_t retVal = _theBus->writeRegister(SFE_XM125_DISTANCE_COMMAND, command);
+
+    // A module reset returns the configuration to its defaults - cached values are no longer known
+    if (retVal == ksfTkErrOk && command == SFE_XM125_DISTANCE_RESET_MODULE)
+        invalidateShadowCache();
+
+    return retVal;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Distance::getDefaultConfig(sfe_xm125_distance_config_t &config)
+{
+    config.start = sfe_xm125_distance_start_default;
+    config.end = sfe_xm125_distance_end_default;
+    config.max_step_length = sfe_xm125_distance_max_step_length_default;
+    config.close_range_leakage_cancellation = sfe_xm125_distance_close_range_leakage_default;
+    config.signal_quality = sfe_xm125_distance_signal_quality_default;
+    config.max_profile = XM125_DISTANCE_PROFILE5;
+    config.threshold_method = XM125_DISTANCE_CFAR;
+    config.peak_sorting = XM125_DISTANCE_STRONGEST;
+    config.num_frames_recorded_threshold = sfe_xm125_distance_num_frames_recorded_thresh_default;
+    config.fixed_amplitude_threshold_value = sfe_xm125_distance_fixed_amp_thresh_val_default;
+    config.threshold_sensitivity = sfe_xm125_distance_threshold_sensitivity_default;
+    config.reflector_shape = XM125_DISTANCE_GENERIC;
+    config.fixed_strength_threshold_value = sfe_xm125_distance_fixed_strength_threshold_val_default;
+    config.measure_on_wakeup = sfe_xm125_distance_measure_on_wakup;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::writeConfigBlock(const sfe_xm125_distance_config_t &config)
+{
+    uint32_t regVals[SFE_XM125_DISTANCE_CONFIG_REGS] = {config.start,
+                                                        config.end,
+                                                        config.max_step_length,
+                                                        config.close_range_leakage_cancellation ? 1u : 0u,
+                                                        config.signal_quality,
+                                                        config.max_profile,
+                                                        config.threshold_method,
+                                                        config.peak_sorting,
+                                                        config.num_frames_recorded_threshold,
+                                                        config.fixed_amplitude_threshold_value,
+                                                        config.threshold_sensitivity,
+                                                        config.reflector_shape,
+                                                        (uint32_t)config.fixed_strength_threshold_value};
+
+    sfTkError_t retVal = writeConfigRegisterBlock(SFE_XM125_DISTANCE_START, regVals, SFE_XM125_DISTANCE_CONFIG_REGS);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    // Measure on wakeup is outside the configuration block
+    return setMeasureOneWakeup(config.measure_on_wakeup);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::readConfigBlock(sfe_xm125_distance_config_t &config)
+{
+    uint32_t regVals[SFE_XM125_DISTANCE_CONFIG_REGS];
+
+    sfTkError_t retVal = readRegisterBlock(SFE_XM125_DISTANCE_START, regVals, SFE_XM125_DISTANCE_CONFIG_REGS);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    config.start = regVals[0];
+    config.end = regVals[1];
+    config.max_step_length = regVals[2];
+    config.close_range_leakage_cancellation = regVals[3] != 0;
+    config.signal_quality = regVals[4];
+    config.max_profile = regVals[5];
+    config.threshold_method = regVals[6];
+    config.peak_sorting = regVals[7];
+    config.num_frames_recorded_threshold = regVals[8];
+    config.fixed_amplitude_threshold_value = regVals[9];
+    config.threshold_sensitivity = regVals[10];
+    config.reflector_shape = regVals[11];
+    config.fixed_strength_threshold_value = (int32_t)regVals[12];
+
+    return getMeasureOneWakeup(config.measure_on_wakeup);
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Distance::timingConfig(const sfe_xm125_distance_config_t &config,
+                                      sfe_xm125_timing_config_t &timingConfig)
+{
+    sfDevXM125Timing::defaultConfig(timingConfig);
+
+    timingConfig.start = config.start;
+    timingConfig.end = config.end;
+    timingConfig.profile = config.max_profile;
+    timingConfig.step_length = config.max_step_length;
+    timingConfig.hwaas = SFE_XM125_DISTANCE_ESTIMATE_HWAAS;
+    timingConfig.processing_us = SFE_XM125_DISTANCE_PROCESSING_US;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::estimateTiming(const sfe_xm125_distance_config_t &config, sfe_xm125_timing_t &timing)
+{
+    sfe_xm125_timing_config_t settings;
+    timingConfig(config, settings);
+
+    return sfDevXM125Timing::estimate(settings, timing);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::estimateTiming(sfe_xm125_timing_t &timing)
+{
+    sfe_xm125_distance_config_t config;
+
+    sfTkError_t retVal = readConfigBlock(config);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    return estimateTiming(config, timing);
+}
+
+//--------------------------------------------------------------------------------
+uint32_t sfDevXM125Distance::estimateFrameMs(const sfe_xm125_distance_config_t &config)
+{
+    sfe_xm125_timing_t timing;
+    if (estimateTiming(config, timing) != ksfTkErrOk)
+        return 0;
+
+    // The measurement is done once it is processed
+    return (timing.frame_period_us + 999) / 1000;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::estimateFrameMs(uint32_t &frameMs)
+{
+    sfe_xm125_distance_config_t config;
+
+    sfTkError_t retVal = readConfigBlock(config);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    frameMs = estimateFrameMs(config);
+    return ksfTkErrOk;
 }
 
 //--------------------------------------------------------------------------------
@@ -785,16 +1162,13 @@ sfTkError_t sfDevXM125Distance::reset()
 }
 
 //--------------------------------------------------------------------------------
-sfTkError_t sfDevXM125Distance::busyWait()
+sfTkError_t sfDevXM125Distance::busyWait(uint32_t timeoutMs, sfe_xm125_poll_strategy_t strategy, uint32_t expectedMs)
 {
-    sfTkError_t retVal = 0;
-    uint32_t regVal = 0;
-
-    retVal = _theBus->readRegister(SFE_XM125_DISTANCE_DETECTOR_STATUS, regVal);
-
-    // Poll Detector Status until Busy bit is cleared
-    while (((regVal & SFE_XM125_DISTANCE_DETECTOR_STATUS_MASK) >> SFE_XM125_DISTANCE_DETECTOR_STATUS_MASK_SHIFT) != 0)
-        retVal = _theBus->readRegister(SFE_XM125_DISTANCE_DETECTOR_STATUS, regVal);
+    return busyWaitStatus(Fields::Busy::reg, Fields::Busy::mask, timeoutMs, strategy, expectedMs);
+}
 
-    return retVal;
-}
\ No newline at end of file
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Distance::pollBusy(sfe_xm125_busy_poll_t &poll)
+{
+    return pollBusyStatus(Fields::Busy::reg, Fields::Busy::mask, poll);
+}
@@ -13,72 +13,12 @@
 #pragma once
 
 #include "sfDevXM125Core.h"
+#include "sfDevXM125DistanceFlags.h"
 
 // Defines
 
 /* ****************************** Distance Values ****************************** */
 
-const uint32_t SFE_XM125_DISTANCE_MAJOR_VERSION_MASK = 0xffff0000;
-const uint32_t SFE_XM125_DISTANCE_MINOR_VERSION_MASK = 0x0000ff00;
-const uint32_t SFE_XM125_DISTANCE_PATCH_VERSION_MASK = 0x000000ff;
-const uint32_t SFE_XM125_DISTANCE_NUMBER_DISTANCES_MASK = 0x0000000f;
-const uint32_t SFE_XM125_DISTANCE_NEAR_START_EDGE_MASK = 0x00000100;
-const uint32_t SFE_XM125_DISTANCE_MEASURE_DISTANCE_ERROR_MASK = 0x00000400;
-const uint32_t SFE_XM125_DISTANCE_TEMPERATURE_MASK = 0xffff0000;
-const uint32_t SFE_XM125_DISTANCE_RSS_REGISTER_OK_MASK = 0x00000001;
-const uint32_t SFE_XM125_DISTANCE_CONFIG_CREATE_OK_MASK = 0x00000002;
-const uint32_t SFE_XM125_DISTANCE_SENSOR_CREATE_OK_MASK = 0x00000004;
-const uint32_t SFE_XM125_DISTANCE_DETECTOR_CREATE_OK_MASK = 0x00000008;
-const uint32_t SFE_XM125_DISTANCE_DETECTOR_BUFFER_OK_MASK = 0x00000010;
-const uint32_t SFE_XM125_DISTANCE_SENSOR_BUFFER_OK_MASK = 0x00000020;
-const uint32_t SFE_XM125_DISTANCE_CALIBRATION_BUFFER_OK_MASK = 0x00000040;
-const uint32_t SFE_XM125_DISTANCE_CONFIG_APPLY_OK_MASK = 0x00000080;
-const uint32_t SFE_XM125_DISTANCE_SENSOR_CALIBRATE_OK_MASK = 0x00000100;
-const uint32_t SFE_XM125_DISTANCE_DETECTOR_CALIBRATE_OK_MASK = 0x00000200;
-const uint32_t SFE_XM125_DISTANCE_RSS_REGISTER_ERROR_MASK = 0x00010000;
-const uint32_t SFE_XM125_DISTANCE_CONFIG_CREATE_ERROR_MASK = 0x00020000;
-const uint32_t SFE_XM125_DISTANCE_SENSOR_CREATE_ERROR_MASK = 0x00040000;
-const uint32_t SFE_XM125_DISTANCE_DETECTOR_CREATE_ERROR_MASK = 0x00080000;
-const uint32_t SFE_XM125_DISTANCE_DETECTOR_BUFFER_ERROR_MASK = 0x00100000;
-const uint32_t SFE_XM125_DISTANCE_SENSOR_BUFFER_ERROR_MASK = 0x00200000;
-const uint32_t SFE_XM125_DISTANCE_CALIBRATION_BUFFER_ERROR_MASK = 0x00400000;
-const uint32_t SFE_XM125_DISTANCE_CONFIG_APPLY_ERROR_MASK = 0x00800000;
-const uint32_t SFE_XM125_DISTANCE_SENSOR_CALIBRATE_ERROR_MASK = 0x01000000;
-const uint32_t SFE_XM125_DISTANCE_DETECTOR_CALIBRATE_ERROR_MASK = 0x02000000;
-const uint32_t SFE_XM125_DISTANCE_DETECTOR_ERROR_MASK = 0x10000000;
-const uint32_t SFE_XM125_DISTANCE_BUSY_MASK = 0x80000000;
-const uint32_t SFE_XM125_DISTANCE_CALIBRATION_NEEDED_MASK = 0x00000200;
-
-const uint32_t SFE_XM125_DISTANCE_ALL_ERROR_MASK =
-    (SFE_XM125_DISTANCE_RSS_REGISTER_ERROR_MASK | SFE_XM125_DISTANCE_CONFIG_CREATE_ERROR_MASK |
-     SFE_XM125_DISTANCE_SENSOR_CREATE_ERROR_MASK | SFE_XM125_DISTANCE_DETECTOR_CREATE_ERROR_MASK |
-     SFE_XM125_DISTANCE_DETECTOR_BUFFER_ERROR_MASK | SFE_XM125_DISTANCE_SENSOR_BUFFER_ERROR_MASK |
-     SFE_XM125_DISTANCE_CALIBRATION_BUFFER_ERROR_MASK | SFE_XM125_DISTANCE_CONFIG_APPLY_ERROR_MASK |
-     SFE_XM125_DISTANCE_SENSOR_CALIBRATE_ERROR_MASK | SFE_XM125_DISTANCE_DETECTOR_CALIBRATE_ERROR_MASK |
-     SFE_XM125_DISTANCE_DETECTOR_ERROR_MASK | SFE_XM125_DISTANCE_BUSY_MASK);
-
-const uint32_t SFE_XM125_DISTANCE_MAJOR_VERSION_MASK_SHIFT = 16;
-const uint32_t SFE_XM125_DISTANCE_MINOR_VERSION_MASK_SHIFT = 8;
-const uint32_t SFE_XM125_DISTANCE_RSS_REGISTER_ERROR_MASK_SHIFT = 15;
-const uint32_t SFE_XM125_DISTANCE_CONFIG_CREATE_ERROR_MASK_SHIFT = 16;
-const uint32_t SFE_XM125_DISTANCE_SENSOR_CREATE_ERROR_MASK_SHIFT = 17;
-const uint32_t SFE_XM125_DISTANCE_DETECTOR_CREATE_ERROR_MASK_SHIFT = 18;
-const uint32_t SFE_XM125_DISTANCE_DETECTOR_BUFFER_ERROR_MASK_SHIFT = 19;
-const uint32_t SFE_XM125_DISTANCE_SENSOR_BUFFER_ERROR_MASK_SHIFT = 20;
-const uint32_t SFE_XM125_DISTANCE_CALIBRATION_BUFFER_ERROR_MASK_SHIFT = 21;
-const uint32_t SFE_XM125_DISTANCE_CONFIG_APPLY_ERROR_MASK_SHIFT = 22;
-const uint32_t SFE_XM125_DISTANCE_SENSOR_CALIBRATE_ERROR_MASK_SHIFT = 23;
-const uint32_t SFE_XM125_DISTANCE_DETECTOR_CALIBRATE_ERROR_MASK_SHIFT = 24;
-const uint32_t SFE_XM125_DISTANCE_DETECTOR_ERROR_MASK_SHIFT = 27;
-const uint32_t SFE_XM125_DISTANCE_BUSY_MASK_SHIFT = 30;
-const uint32_t SFE_XM125_DISTANCE_NEAR_START_EDGE_MASK_SHIFT = 8;
-const uint32_t SFE_XM125_DISTANCE_CALIBRATION_NEEDED_MASK_SHIFT = 9;
-const uint32_t SFE_XM125_DISTANCE_MEASURE_DISTANCE_ERROR_MASK_SHIFT = 10;
-const uint32_t SFE_XM125_DISTANCE_TEMPERATURE_MASK_SHIFT = 16;
-const uint32_t SFE_XM125_DISTANCE_DETECTOR_STATUS_MASK_SHIFT = 30;
-
-const uint32_t SFE_XM125_DISTANCE_DETECTOR_STATUS_MASK = 0b10010000111111110000000011111111;
-
 const uint16_t SFE_XM125_DISTANCE_VERSION = 0x00;
 typedef struct
 {
@@ -142,6 +82,123 @@ typedef struct
     uint32_t distance_temperature : 16;
 } sfe_xm125_distance_result_t;
 
+// Bit fields of the version, detector status and result registers - sfDevXM125Field<register, offset, width, type>
+struct sfDevXM125DistanceFields
+{
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_VERSION, 16, 16> MajorVersion;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_VERSION, 8, 8> MinorVersion;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_VERSION, 0, 8> PatchVersion;
+
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 0, 1, bool> RssRegisterOk;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 1, 1, bool> ConfigCreateOk;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 2, 1, bool> SensorCreateOk;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 3, 1, bool> DetectorCreateOk;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 4, 1, bool> DetectorBufferOk;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 5, 1, bool> SensorBufferOk;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 6, 1, bool> CalibrationBufferOk;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 7, 1, bool> ConfigApplyOk;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 8, 1, bool> SensorCalibrateOk;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 9, 1, bool> DetectorCalibrateOk;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 16, 1, bool> RssRegisterError;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 17, 1, bool> ConfigCreateError;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 18, 1, bool> SensorCreateError;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 19, 1, bool> DetectorCreateError;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 20, 1, bool> DetectorBufferError;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 21, 1, bool> SensorBufferError;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 22, 1, bool> CalibrationBufferError;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 23, 1, bool> ConfigApplyError;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 24, 1, bool> SensorCalibrateError;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 25, 1, bool> DetectorCalibrateError;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 28, 1, bool> DetectorError;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_DETECTOR_STATUS, 31, 1, bool> Busy;
+
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_RESULT, 0, 4, uint8_t> NumDistances;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_RESULT, 8, 1, bool> NearStartEdge;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_RESULT, 9, 1, bool> CalibrationNeeded;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_RESULT, 10, 1, bool> MeasureDistanceError;
+    typedef sfDevXM125Field<SFE_XM125_DISTANCE_RESULT, 16, 16, int16_t> Temperature;
+};
+
+// Masks and shifts of the register fields, kept for existing code - generated from the fields above
+const uint32_t SFE_XM125_DISTANCE_MAJOR_VERSION_MASK = sfDevXM125DistanceFields::MajorVersion::mask;
+const uint32_t SFE_XM125_DISTANCE_MINOR_VERSION_MASK = sfDevXM125DistanceFields::MinorVersion::mask;
+const uint32_t SFE_XM125_DISTANCE_PATCH_VERSION_MASK = sfDevXM125DistanceFields::PatchVersion::mask;
+const uint32_t SFE_XM125_DISTANCE_NUMBER_DISTANCES_MASK = sfDevXM125DistanceFields::NumDistances::mask;
+const uint32_t SFE_XM125_DISTANCE_NEAR_START_EDGE_MASK = sfDevXM125DistanceFields::NearStartEdge::mask;
+const uint32_t SFE_XM125_DISTANCE_CALIBRATION_NEEDED_MASK = sfDevXM125DistanceFields::CalibrationNeeded::mask;
+const uint32_t SFE_XM125_DISTANCE_MEASURE_DISTANCE_ERROR_MASK = sfDevXM125DistanceFields::MeasureDistanceError::mask;
+const uint32_t SFE_XM125_DISTANCE_TEMPERATURE_MASK = sfDevXM125DistanceFields::Temperature::mask;
+const uint32_t SFE_XM125_DISTANCE_RSS_REGISTER_OK_MASK = sfDevXM125DistanceFields::RssRegisterOk::mask;
+const uint32_t SFE_XM125_DISTANCE_CONFIG_CREATE_OK_MASK = sfDevXM125DistanceFields::ConfigCreateOk::mask;
+const uint32_t SFE_XM125_DISTANCE_SENSOR_CREATE_OK_MASK = sfDevXM125DistanceFields::SensorCreateOk::mask;
+const uint32_t SFE_XM125_DISTANCE_DETECTOR_CREATE_OK_MASK = sfDevXM125DistanceFields::DetectorCreateOk::mask;
+const uint32_t SFE_XM125_DISTANCE_DETECTOR_BUFFER_OK_MASK = sfDevXM125DistanceFields::DetectorBufferOk::mask;
+const uint32_t SFE_XM125_DISTANCE_SENSOR_BUFFER_OK_MASK = sfDevXM125DistanceFields::SensorBufferOk::mask;
+const uint32_t SFE_XM125_DISTANCE_CALIBRATION_BUFFER_OK_MASK = sfDevXM125DistanceFields::CalibrationBufferOk::mask;
+const uint32_t SFE_XM125_DISTANCE_CONFIG_APPLY_OK_MASK = sfDevXM125DistanceFields::ConfigApplyOk::mask;
+const uint32_t SFE_XM125_DISTANCE_SENSOR_CALIBRATE_OK_MASK = sfDevXM125DistanceFields::SensorCalibrateOk::mask;
+const uint32_t SFE_XM125_DISTANCE_DETECTOR_CALIBRATE_OK_MASK = sfDevXM125DistanceFields::DetectorCalibrateOk::mask;
+const uint32_t SFE_XM125_DISTANCE_RSS_REGISTER_ERROR_MASK = sfDevXM125DistanceFields::RssRegisterError::mask;
+const uint32_t SFE_XM125_DISTANCE_CONFIG_CREATE_ERROR_MASK = sfDevXM125DistanceFields::ConfigCreateError::mask;
+const uint32_t SFE_XM125_DISTANCE_SENSOR_CREATE_ERROR_MASK = sfDevXM125DistanceFields::SensorCreateError::mask;
+const uint32_t SFE_XM125_DISTANCE_DETECTOR_CREATE_ERROR_MASK = sfDevXM125DistanceFields::DetectorCreateError::mask;
+const uint32_t SFE_XM125_DISTANCE_DETECTOR_BUFFER_ERROR_MASK = sfDevXM125DistanceFields::DetectorBufferError::mask;
+const uint32_t SFE_XM125_DISTANCE_SENSOR_BUFFER_ERROR_MASK = sfDevXM125DistanceFields::SensorBufferError::mask;
+const uint32_t SFE_XM125_DISTANCE_CALIBRATION_BUFFER_ERROR_MASK =
+    sfDevXM125DistanceFields::CalibrationBufferError::mask;
+const uint32_t SFE_XM125_DISTANCE_CONFIG_APPLY_ERROR_MASK = sfDevXM125DistanceFields::ConfigApplyError::mask;
+const uint32_t SFE_XM125_DISTANCE_SENSOR_CALIBRATE_ERROR_MASK = sfDevXM125DistanceFields::SensorCalibrateError::mask;
+const uint32_t SFE_XM125_DISTANCE_DETECTOR_CALIBRATE_ERROR_MASK =
+    sfDevXM125DistanceFields::DetectorCalibrateError::mask;
+const uint32_t SFE_XM125_DISTANCE_DETECTOR_ERROR_MASK = sfDevXM125DistanceFields::DetectorError::mask;
+const uint32_t SFE_XM125_DISTANCE_BUSY_MASK = sfDevXM125DistanceFields::Busy::mask;
+
+const uint32_t SFE_XM125_DISTANCE_ALL_ERROR_MASK =
+    (SFE_XM125_DISTANCE_RSS_REGISTER_ERROR_MASK | SFE_XM125_DISTANCE_CONFIG_CREATE_ERROR_MASK |
+     SFE_XM125_DISTANCE_SENSOR_CREATE_ERROR_MASK | SFE_XM125_DISTANCE_DETECTOR_CREATE_ERROR_MASK |
+     SFE_XM125_DISTANCE_DETECTOR_BUFFER_ERROR_MASK | SFE_XM125_DISTANCE_SENSOR_BUFFER_ERROR_MASK |
+     SFE_XM125_DISTANCE_CALIBRATION_BUFFER_ERROR_MASK | SFE_XM125_DISTANCE_CONFIG_APPLY_ERROR_MASK |
+     SFE_XM125_DISTANCE_SENSOR_CALIBRATE_ERROR_MASK | SFE_XM125_DISTANCE_DETECTOR_CALIBRATE_ERROR_MASK |
+     SFE_XM125_DISTANCE_DETECTOR_ERROR_MASK | SFE_XM125_DISTANCE_BUSY_MASK);
+
+// All defined bits of the detector status register
+const uint32_t SFE_XM125_DISTANCE_DETECTOR_STATUS_MASK =
+    SFE_XM125_DISTANCE_ALL_ERROR_MASK | SFE_XM125_DISTANCE_RSS_REGISTER_OK_MASK |
+    SFE_XM125_DISTANCE_CONFIG_CREATE_OK_MASK | SFE_XM125_DISTANCE_SENSOR_CREATE_OK_MASK |
+    SFE_XM125_DISTANCE_DETECTOR_CREATE_OK_MASK | SFE_XM125_DISTANCE_DETECTOR_BUFFER_OK_MASK |
+    SFE_XM125_DISTANCE_SENSOR_BUFFER_OK_MASK | SFE_XM125_DISTANCE_CALIBRATION_BUFFER_OK_MASK |
+    SFE_XM125_DISTANCE_CONFIG_APPLY_OK_MASK | SFE_XM125_DISTANCE_SENSOR_CALIBRATE_OK_MASK |
+    SFE_XM125_DISTANCE_DETECTOR_CALIBRATE_OK_MASK;
+
+const uint32_t SFE_XM125_DISTANCE_MAJOR_VERSION_MASK_SHIFT = sfDevXM125DistanceFields::MajorVersion::offset;
+const uint32_t SFE_XM125_DISTANCE_MINOR_VERSION_MASK_SHIFT = sfDevXM125DistanceFields::MinorVersion::offset;
+const uint32_t SFE_XM125_DISTANCE_RSS_REGISTER_ERROR_MASK_SHIFT = sfDevXM125DistanceFields::RssRegisterError::offset;
+const uint32_t SFE_XM125_DISTANCE_CONFIG_CREATE_ERROR_MASK_SHIFT = sfDevXM125DistanceFields::ConfigCreateError::offset;
+const uint32_t SFE_XM125_DISTANCE_SENSOR_CREATE_ERROR_MASK_SHIFT = sfDevXM125DistanceFields::SensorCreateError::offset;
+const uint32_t SFE_XM125_DISTANCE_DETECTOR_CREATE_ERROR_MASK_SHIFT =
+    sfDevXM125DistanceFields::DetectorCreateError::offset;
+const uint32_t SFE_XM125_DISTANCE_DETECTOR_BUFFER_ERROR_MASK_SHIFT =
+    sfDevXM125DistanceFields::DetectorBufferError::offset;
+const uint32_t SFE_XM125_DISTANCE_SENSOR_BUFFER_ERROR_MASK_SHIFT = sfDevXM125DistanceFields::SensorBufferError::offset;
+const uint32_t SFE_XM125_DISTANCE_CALIBRATION_BUFFER_ERROR_MASK_SHIFT =
+    sfDevXM125DistanceFields::CalibrationBufferError::offset;
+const uint32_t SFE_XM125_DISTANCE_CONFIG_APPLY_ERROR_MASK_SHIFT = sfDevXM125DistanceFields::ConfigApplyError::offset;
+const uint32_t SFE_XM125_DISTANCE_SENSOR_CALIBRATE_ERROR_MASK_SHIFT =
+    sfDevXM125DistanceFields::SensorCalibrateError::offset;
+const uint32_t SFE_XM125_DISTANCE_DETECTOR_CALIBRATE_ERROR_MASK_SHIFT =
+    sfDevXM125DistanceFields::DetectorCalibrateError::offset;
+const uint32_t SFE_XM125_DISTANCE_DETECTOR_ERROR_MASK_SHIFT = sfDevXM125DistanceFields::DetectorError::offset;
+const uint32_t SFE_XM125_DISTANCE_BUSY_MASK_SHIFT = sfDevXM125DistanceFields::Busy::offset;
+const uint32_t SFE_XM125_DISTANCE_NEAR_START_EDGE_MASK_SHIFT = sfDevXM125DistanceFields::NearStartEdge::offset;
+const uint32_t SFE_XM125_DISTANCE_CALIBRATION_NEEDED_MASK_SHIFT = sfDevXM125DistanceFields::CalibrationNeeded::offset;
+const uint32_t SFE_XM125_DISTANCE_MEASURE_DISTANCE_ERROR_MASK_SHIFT =
+    sfDevXM125DistanceFields::MeasureDistanceError::offset;
+const uint32_t SFE_XM125_DISTANCE_TEMPERATURE_MASK_SHIFT = sfDevXM125DistanceFields::Temperature::offset;
+const uint32_t SFE_XM125_DISTANCE_DETECTOR_STATUS_MASK_SHIFT = sfDevXM125DistanceFields::Busy::offset;
+
+// Code returned by getDetectorErrorStatus() when no error but the busy bit is set
+const uint32_t SFE_XM125_DISTANCE_BUSY_ERROR_CODE = 13;
+
 const uint16_t SFE_XM125_DISTANCE_PEAK0_DISTANCE = 0x11;
 const uint16_t SFE_XM125_DISTANCE_PEAK1_DISTANCE = 0x12;
 const uint16_t SFE_XM125_DISTANCE_PEAK2_DISTANCE = 0x13;
@@ -163,6 +220,42 @@ const uint16_t SFE_XM125_DISTANCE_PEAK7_STRENGTH = 0x22;
 const uint16_t SFE_XM125_DISTANCE_PEAK8_STRENGTH = 0x23;
 const uint16_t SFE_XM125_DISTANCE_PEAK9_STRENGTH = 0x24;
 
+// The number of peaks reported by the device - the distance registers are followed by the strength registers
+const uint8_t SFE_XM125_DISTANCE_MAX_PEAKS = 10;
+
+// All peak values from a single measurement. Distances are in mm, strengths are a factor 1000 larger than RSS
+typedef struct
+{
+    uint32_t distance[SFE_XM125_DISTANCE_MAX_PEAKS];
+    int32_t strength[SFE_XM125_DISTANCE_MAX_PEAKS];
+} sfe_xm125_distance_peaks_t;
+
+// Compact result of a single measurement, for buffering - 52 bytes instead of the 80 bytes of
+// sfe_xm125_distance_peaks_t plus the result register. Only the first num_peaks peaks are valid.
+typedef struct
+{
+    uint32_t measure_counter;                          // measure counter of the device
+    uint32_t timestamp;                                // host time of the read in ms
+    int16_t temperature;                               // sensor temperature
+    uint8_t num_peaks;                                 // number of valid peaks
+    uint8_t flags;                                     // SFE_XM125_DISTANCE_FRAME_* flags
+    uint16_t distance[SFE_XM125_DISTANCE_MAX_PEAKS];   // peak distances in mm
+    int16_t strength[SFE_XM125_DISTANCE_MAX_PEAKS];    // peak strengths in 0.01 dB
+} sfe_xm125_distance_frame_t;
+
+// State and result of pollFrame() - keep it between calls, zero initialized before the first
+typedef struct
+{
+    bool ready;               // a new measurement has finished - the result fields are valid
+    bool busy;                // the detector is still busy
+    uint32_t measure_counter; // measure counter of the last ready measurement
+    uint32_t status;          // detector status register value
+    uint16_t status_errors;   // failed steps (SFE_XM125_STATUS_* flags), 0 if none
+    uint8_t num_distances;    // number of detected peaks
+    uint8_t flags;            // SFE_XM125_DISTANCE_FRAME_* flags
+    int16_t temperature;      // sensor temperature
+} sfe_xm125_distance_poll_t;
+
 // Default Value: 250mm
 const uint16_t SFE_XM125_DISTANCE_START = 0x40;
 const uint16_t sfe_xm125_distance_start_default = 250;
@@ -240,6 +333,33 @@ const uint16_t sfe_xm125_distance_fixed_strength_threshold_val_default = 0;
 const uint16_t SFE_XM125_DISTANCE_MEASURE_ON_WAKEUP = 0x80;
 const bool sfe_xm125_distance_measure_on_wakup = false;
 
+// Number of consecutive configuration registers (0x40 - 0x4c)
+const uint8_t SFE_XM125_DISTANCE_CONFIG_REGS = 13;
+
+// Frame time estimation - the detector picks HWAAS from the signal quality, and processes each
+// measurement on the module before the result is ready
+const uint32_t SFE_XM125_DISTANCE_ESTIMATE_HWAAS = 16;
+const uint32_t SFE_XM125_DISTANCE_PROCESSING_US = 10000;
+
+// Full detector configuration - fields are in register order, starting at SFE_XM125_DISTANCE_START
+typedef struct
+{
+    uint32_t start;                           // start of measured interval in mm
+    uint32_t end;                             // end of measured interval in mm
+    uint32_t max_step_length;                 // maximum step length, 0 for automatic
+    bool close_range_leakage_cancellation;    // enable close range leakage cancellation
+    uint32_t signal_quality;                  // signal quality
+    uint32_t max_profile;                     // max profile (sfe_xm125_distance_profile_t)
+    uint32_t threshold_method;                // threshold method (sfe_xm125_distance_threshold_method_t)
+    uint32_t peak_sorting;                    // peak sorting method (sfe_xm125_distance_peak_sorting_t)
+    uint32_t num_frames_recorded_threshold;   // frames used for the recorded threshold
+    uint32_t fixed_amplitude_threshold_value; // fixed amplitude threshold value
+    uint32_t threshold_sensitivity;           // threshold sensitivity
+    uint32_t reflector_shape;                 // reflector shape (sfe_xm125_distance_reflector_shape_t)
+    int32_t fixed_strength_threshold_value;   // fixed strength threshold value
+    bool measure_on_wakeup;                   // measure on wakeup (register 0x80)
+} sfe_xm125_distance_config_t;
+
 const uint16_t SFE_XM125_DISTANCE_COMMAND = 0x100;
 typedef enum
 {
@@ -269,6 +389,9 @@ const uint32_t SFE_XM125_DISTANCE_RESET_MODULE = 1381192737;
 class sfDevXM125Distance : public sfDevXM125Core
 {
   public:
+    /// @brief Initializer
+    sfDevXM125Distance() : sfDevXM125Core(SFE_XM125_DISTANCE_FIXED_STRENGTH_THRESHOLD_VAL) {};
+
     /**
      * @brief Initializes the distance detector device.
      *
@@ -281,7 +404,8 @@ class sfDevXM125Distance : public sfDevXM125Core
     sfTkError_t begin(sfTkII2C *theBus = nullptr);
 
     /// @brief This function sets all the beginning values for a basic I2C
-    ///  example to be run on the device for presence sensing.
+    ///  example to be run on the device for presence sensing. With the fast restart enabled, a
+    ///  repeated setup with the same range skips the module reset - see enableFastRestart().
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t distanceSetup(uint32_t start = sfe_xm125_distance_start_default,
                               uint32_t end = sfe_xm125_distance_end_default);
@@ -317,27 +441,70 @@ class sfDevXM125Distance : public sfDevXM125Core
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t getDetectorStatus(uint32_t &status);
 
+    /// @brief This function reads the detector status register once and decodes all of its
+    ///  flags - every completed and failed setup step, and the busy bit.
+    /// @param status Decoded status
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t getStatus(sfDevXM125Status &status);
+
+    /// @brief Decodes a detector status register value without reading the device - for
+    ///  example the status left in sfe_xm125_busy_poll_t::status by pollBusy().
+    /// @param regVal Value of the detector status register
+    /// @param status Decoded status
+    static void decodeStatus(uint32_t regVal, sfDevXM125Status &status);
+
+    /// @brief This function reads the result register once and decodes all of its
+    ///  fields, so the values from a single measurement can be examined without
+    ///  additional bus traffic. Use with the getter overloads that take a result.
+    /// @param result Decoded result register
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readResult(sfe_xm125_distance_result_t &result);
+
     /// @brief This function returns the number of detected distances.
     /// @param distance Number of detected distances
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t getNumberDistances(uint32_t &distance);
 
+    /// @brief This function returns the number of detected distances from a result read with readResult()
+    /// @param result Result register values
+    /// @param distance Number of detected distances
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t getNumberDistances(const sfe_xm125_distance_result_t &result, uint32_t &distance);
+
     /// @brief This function returns the indication that there might be an object
     ///   near the start point of the measured range.
     /// @param edge Flag to determine object in range
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t getNearStartEdge(uint32_t &edge);
 
+    /// @brief This function returns the near start edge flag from a result read with readResult()
+    /// @param result Result register values
+    /// @param edge Flag to determine object in range
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t getNearStartEdge(const sfe_xm125_distance_result_t &result, uint32_t &edge);
+
     /// @brief This function returns the indication of a sensor calibration needed.
     /// @param calibrate Flag to indicate calibration required
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t getCalibrationNeeded(uint32_t &calibrate);
 
+    /// @brief This function returns the calibration needed flag from a result read with readResult()
+    /// @param result Result register values
+    /// @param calibrate Flag to indicate calibration required
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t getCalibrationNeeded(const sfe_xm125_distance_result_t &result, uint32_t &calibrate);
+
     /// @brief This function returns if the measure command failed.
     /// @param error Flag to indicate measure command error
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t getMeasureDistanceError(uint32_t &error);
 
+    /// @brief This function returns the measure distance error flag from a result read with readResult()
+    /// @param result Result register values
+    /// @param error Flag to indicate measure command error
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t getMeasureDistanceError(const sfe_xm125_distance_result_t &result, uint32_t &error);
+
     /// @brief This function returns the temperature in sensor during measurements
     ///   (in degree Celsius). Note that it has poor absolute accuracy and should
     ///   only be used for relative temperature measurements.
@@ -345,6 +512,12 @@ class sfDevXM125Distance : public sfDevXM125Core
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t getTemperature(int16_t &temperature);
 
+    /// @brief This function returns the temperature from a result read with readResult()
+    /// @param result Result register values
+    /// @param temperature Relative temperature of device
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t getTemperature(const sfe_xm125_distance_result_t &result, int16_t &temperature);
+
     //--------------------------------------------------------------------------------
     // Generic distance peak distance method
     /// @brief This function returns the distance to peak num
@@ -463,6 +636,29 @@ class sfDevXM125Distance : public sfDevXM125Core
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t getPeak9Strength(int32_t &peak);
 
+    /// @brief This function reads the distance and strength of all ten peaks
+    ///  in a single burst read of the peak registers (0x11 - 0x24).
+    ///  Note: Only the first getNumberDistances() entries hold valid values
+    /// @param peaks Structure to hold the peak distances and strengths
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readPeaks(sfe_xm125_distance_peaks_t &peaks);
+
+    /// @brief This function reads the result of the last measurement into a compact frame -
+    ///  the measure counter, then the result and all peak registers (0x10 - 0x24) in a single
+    ///  burst read. Fill a ring buffer slot in place with it, see sfDevXM125RingBuffer.h.
+    /// @param frame Frame to fill - timestamped with sftk_ticks_ms()
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readFrame(sfe_xm125_distance_frame_t &frame);
+
+    /// @brief Checks for a finished measurement with as few reads as possible - one burst read of
+    ///  the adjacent measure counter and detector status registers (0x02 - 0x03), and only when a
+    ///  new measurement has finished, one read of the result register. Call start(), then call
+    ///  this until poll.ready is set; read the peaks with readPeaks() if there are any.
+    /// @param poll Poll state and result - keep it between calls
+    /// @return ksfTkErrOk on success - check poll.ready - ksfTkErrXM125Detector when the detector
+    ///  status shows an error (see poll.status_errors), or error code (value < -1)
+    sfTkError_t pollFrame(sfe_xm125_distance_poll_t &poll);
+
     /// @brief This function returns the start of measured interval
     ///  in millimeters.
     ///  Note: This value is a factor 1000 larger than the RSS value
@@ -646,6 +842,55 @@ class sfDevXM125Distance : public sfDevXM125Core
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t setCommand(uint32_t command);
 
+    /// @brief This function fills a configuration structure with the device default values
+    /// @param config Configuration to fill
+    void getDefaultConfig(sfe_xm125_distance_config_t &config);
+
+    /// @brief This function writes a complete detector configuration. The configuration
+    ///  registers are written with auto-incrementing block writes instead of one
+    ///  transaction per register. The configuration still needs to be applied.
+    /// @param config Configuration to write
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeConfigBlock(const sfe_xm125_distance_config_t &config);
+
+    /// @brief This function reads the complete detector configuration in a single
+    ///  block read, plus the measure on wakeup register.
+    /// @param config Configuration read from the device
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readConfigBlock(sfe_xm125_distance_config_t &config);
+
+    /// @brief This function fills the sensor settings of the timing model from a detector
+    ///  configuration. The detector splits the range into subsweeps with their own profiles and
+    ///  HWAAS; the model assumes a single sweep with the largest profile and step length,
+    ///  SFE_XM125_DISTANCE_ESTIMATE_HWAAS and SFE_XM125_DISTANCE_PROCESSING_US of processing.
+    /// @param config Detector configuration
+    /// @param timingConfig Timing model settings to fill
+    static void timingConfig(const sfe_xm125_distance_config_t &config, sfe_xm125_timing_config_t &timingConfig);
+
+    /// @brief This function estimates the timing of a measurement from a detector configuration
+    /// @param config Detector configuration
+    /// @param timing Estimated timing
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    static sfTkError_t estimateTiming(const sfe_xm125_distance_config_t &config, sfe_xm125_timing_t &timing);
+
+    /// @brief This function estimates the timing of a measurement with the configuration of the device
+    /// @param timing Estimated timing
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t estimateTiming(sfe_xm125_timing_t &timing);
+
+    /// @brief This function estimates the duration of a measurement from a detector
+    ///  configuration, from its range, step length and profile.
+    /// @param config Detector configuration
+    /// @return Estimated measurement duration in milliseconds, 0 for a configuration the sensor
+    ///  does not accept
+    static uint32_t estimateFrameMs(const sfe_xm125_distance_config_t &config);
+
+    /// @brief This function estimates the duration of a measurement with the configuration
+    ///  of the device.
+    /// @param frameMs Estimated measurement duration in milliseconds
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t estimateFrameMs(uint32_t &frameMs);
+
     /// @brief This function applies the configuration to the device by
     ///  writing the defined value to the distance command register
     /// @return ksfTkErrOk on success, or error code (value < -1)
@@ -691,8 +936,31 @@ class sfDevXM125Distance : public sfDevXM125Core
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t reset();
 
-    /// @brief Completes a busy wait loop while the device is uploading
-    ///  information by waiting for the status
-    /// @return ksfTkErrOk on success, or error code (value < -1)
-    sfTkError_t busyWait();
+    /// @brief Waits while the device is busy by polling the busy bit of the detector
+    ///  status register. The wait is bounded by a timeout, and the poll rate is set by
+    ///  the polling strategy.
+    /// @param timeoutMs Time allowed for the device to clear the busy bit
+    /// @param strategy How the status register is polled
+    /// @param expectedMs Expected command duration, used by XM125_POLL_EXPECTED
+    /// @return ksfTkErrOk on success, ksfTkErrXM125Timeout on timeout, or error code (value < -1)
+    sfTkError_t busyWait(uint32_t timeoutMs = SFE_XM125_BUSY_WAIT_TIMEOUT_DEFAULT,
+                         sfe_xm125_poll_strategy_t strategy = XM125_POLL_FIXED, uint32_t expectedMs = 0);
+
+    /// @brief Non-blocking busy wait step for cooperative schedulers. Start the wait with
+    ///  startBusyPoll(), then call this until it returns a value other than ksfTkErrXM125Busy.
+    ///  The bus is only accessed when a poll is due.
+    /// @param poll Busy wait state from startBusyPoll()
+    /// @return ksfTkErrOk when not busy, ksfTkErrXM125Busy while busy, ksfTkErrXM125Timeout on timeout,
+    ///  or error code (value < -1)
+    sfTkError_t pollBusy(sfe_xm125_busy_poll_t &poll);
+
+  private:
+    /// @brief Returns the getDetectorErrorStatus() code of the status register value read by the
+    ///  last busy wait, so a finished command is checked without reading the register again
+    uint32_t busyWaitErrorStatus(void);
+
+    /// @brief Fast restart of distanceSetup() - succeeds when the module still runs the
+    ///  configuration the setup would apply, recalibrating when the detector asks for it
+    /// @return true if the setup is done, false if it must run in full
+    bool fastRestart(uint32_t startRange, uint32_t endRange);
 };
\ No newline at end of file
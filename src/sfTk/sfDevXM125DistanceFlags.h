@@ -0,0 +1,23 @@
+/**
+ * @file sfDevXM125DistanceFlags.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the flags of a compact distance frame. They are shared by the distance
+ * detector (sfDevXM125Distance.h), the packet format (sfDevXM125Packet.h) and the peak tracker
+ * (sfDevXM125PeakTracker.h), and do not depend on the toolkit, so the host tools can use them too.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+// Flags of a compact distance frame
+const uint8_t SFE_XM125_DISTANCE_FRAME_NEAR_START_EDGE = 0x01;     // object close to the start of the interval
+const uint8_t SFE_XM125_DISTANCE_FRAME_CALIBRATION_NEEDED = 0x02;  // the detector needs a recalibration
+const uint8_t SFE_XM125_DISTANCE_FRAME_MEASURE_ERROR = 0x04;       // the measurement failed
+const uint8_t SFE_XM125_DISTANCE_FRAME_CLAMPED = 0x08;             // a peak value did not fit and was clamped
@@ -0,0 +1,70 @@
+/**
+ * @file sfDevXM125Field.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains a compile time description of the bit fields of the XM125 registers. Each field
+ * names its register, position, width and value type once; the mask, the shift and the code to
+ * extract or insert the value are generated from that, so they can not disagree:
+ *
+ *     typedef sfDevXM125Field<SFE_XM125_DISTANCE_RESULT, 16, 16, int16_t> Temperature;
+ *
+ *     int16_t temperature = Temperature::get(regVal);     // (regVal & 0xffff0000) >> 16
+ *     regVal = Temperature::set(regVal, temperature);
+ *
+ * With constant arguments the accessors fold to a single mask and shift.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+/// @brief A bit field of a 32-bit register
+///  Reg is the register address, Offset the position of the lowest bit, Width the number of bits and
+///  T the type the value is returned as. A signed T is sign extended from the field width only when
+///  the field is as wide as T.
+template <uint16_t Reg, uint8_t Offset, uint8_t Width, class T = uint32_t> struct sfDevXM125Field
+{
+    static_assert(Width > 0 && Offset + Width <= 32, "field does not fit in a 32-bit register");
+
+    typedef T type;
+
+    static constexpr uint16_t reg = Reg;
+    static constexpr uint8_t offset = Offset;
+    static constexpr uint8_t width = Width;
+
+    /// @brief Bits of the field, in register position
+    static constexpr uint32_t mask = (Width == 32 ? 0xffffffffUL : (1UL << Width) - 1) << Offset;
+
+    /// @brief Returns the value of the field in a register value
+    static constexpr T get(uint32_t regVal)
+    {
+        return static_cast<T>((regVal & mask) >> Offset);
+    }
+
+    /// @brief Returns a register value with the field replaced - other bits are kept
+    static constexpr uint32_t set(uint32_t regVal, T value)
+    {
+        return (regVal & ~mask) | ((static_cast<uint32_t>(value) << Offset) & mask);
+    }
+
+    /// @brief Returns true if any bit of the field is set in a register value
+    static constexpr bool isSet(uint32_t regVal)
+    {
+        return (regVal & mask) != 0;
+    }
+};
+
+// Definitions of the static members, for when they are passed by reference (C++11)
+template <uint16_t Reg, uint8_t Offset, uint8_t Width, class T>
+constexpr uint16_t sfDevXM125Field<Reg, Offset, Width, T>::reg;
+template <uint16_t Reg, uint8_t Offset, uint8_t Width, class T>
+constexpr uint8_t sfDevXM125Field<Reg, Offset, Width, T>::offset;
+template <uint16_t Reg, uint8_t Offset, uint8_t Width, class T>
+constexpr uint8_t sfDevXM125Field<Reg, Offset, Width, T>::width;
+template <uint16_t Reg, uint8_t Offset, uint8_t Width, class T>
+constexpr uint32_t sfDevXM125Field<Reg, Offset, Width, T>::mask;
@@ -0,0 +1,218 @@
+/**
+ * @file sfDevXM125LowPower.cpp
+ * @brief Implementation of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the implementation of the duty cycled low power distance mode.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "sfDevXM125LowPower.h"
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125LowPower::begin(sfDevXM125Distance *device, sfe_xm125_wake_pin_cb_t wakePin,
+                                      sfe_xm125_ready_pin_cb_t readyPin, void *user)
+{
+    if (device == nullptr || wakePin == nullptr)
+        return ksfTkErrFail;
+
+    _device = device;
+    _wakePin = wakePin;
+    _readyPin = readyPin;
+    _user = user;
+    resetStats();
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125LowPower::setup(uint32_t startRange, uint32_t endRange)
+{
+    if (_device == nullptr)
+        return ksfTkErrBusNotInit;
+
+    uint32_t transfers = 0;
+    uint32_t wakeMs = sftk_ticks_ms();
+
+    wake(true);
+
+    // The module measures on wakeup only once set up - wait for it to answer
+    sfTkError_t retVal = ksfTkErrOk;
+    if (_readyPin != nullptr)
+        retVal = waitReady(wakeMs, transfers);
+    else
+        sftk_delay_ms(_wakeMs);
+
+    // Measure on wakeup is outside the configuration block, and cleared by the reset of the setup
+    if (retVal == ksfTkErrOk && _device->distanceSetup(startRange, endRange) != 0)
+        retVal = ksfTkErrFail;
+
+    // The configuration goes in after the reset of the setup, and is applied again
+    if (retVal == ksfTkErrOk && _configure != nullptr)
+    {
+        retVal = _configure(*_device, _user);
+
+        if (retVal == ksfTkErrOk)
+            retVal = _device->applyConfiguration();
+
+        if (retVal == ksfTkErrOk)
+            retVal = waitBusy(_timeoutMs, XM125_POLL_BACKOFF, 0, transfers);
+    }
+
+    if (retVal == ksfTkErrOk)
+        retVal = _device->setMeasureOneWakeup(true);
+
+    if (retVal == ksfTkErrOk)
+        retVal = _device->estimateFrameMs(_frameMs);
+
+    wake(false);
+
+    // The first cycle is due right away
+    _nextWakeMs = sftk_ticks_ms();
+
+    return retVal;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125LowPower::cycle(sfe_xm125_distance_frame_t &frame)
+{
+    if (_device == nullptr)
+        return ksfTkErrBusNotInit;
+
+    uint32_t wakeMs = sftk_ticks_ms();
+    uint32_t transfers = 0;
+
+    // Keep the cycles a period apart - unless this one started more than a period late
+    if ((uint32_t)(wakeMs - _nextWakeMs) < _periodMs)
+        _nextWakeMs += _periodMs;
+    else
+        _nextWakeMs = wakeMs + _periodMs;
+
+    wake(true);
+
+    sfTkError_t retVal = waitReady(wakeMs, transfers);
+
+    // The measure counter, then the result and all peak registers
+    if (retVal == ksfTkErrOk)
+    {
+        retVal = _device->readFrame(frame);
+        transfers += 2;
+    }
+
+    // Recalibrate while awake - the next wakeup measures with the new calibration
+    if (retVal == ksfTkErrOk && (frame.flags & SFE_XM125_DISTANCE_FRAME_CALIBRATION_NEEDED))
+    {
+        retVal = _device->recalibrate();
+        transfers++;
+
+        if (retVal == ksfTkErrOk)
+            retVal = waitBusy(_timeoutMs, XM125_POLL_BACKOFF, 0, transfers);
+
+        if (retVal == ksfTkErrOk)
+            _stats.recalibrations++;
+    }
+
+    wake(false);
+
+    uint32_t awakeMs = sftk_ticks_ms() - wakeMs;
+
+    _stats.cycles++;
+    if (retVal == ksfTkErrOk)
+        _stats.frames++;
+    else
+        _stats.errors++;
+
+    _stats.last_awake_ms = awakeMs;
+    _stats.total_awake_ms += awakeMs;
+    if (awakeMs > _stats.max_awake_ms)
+        _stats.max_awake_ms = awakeMs;
+
+    _stats.last_transfers = transfers;
+    _stats.total_transfers += transfers;
+
+    return retVal;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125LowPower::waitReady(uint32_t wakeMs, uint32_t &transfers)
+{
+    // MCU_INT goes high once the measurement is done - no bus transfers needed
+    if (_readyPin != nullptr)
+    {
+        while (!_readyPin(_user))
+        {
+            if (sftk_ticks_ms() - wakeMs >= _timeoutMs)
+                return ksfTkErrXM125Timeout;
+
+            sftk_delay_ms(1);
+        }
+
+        return ksfTkErrOk;
+    }
+
+    // Without it, give the module time to wake up, then read the status once the measurement
+    // should be done
+    sftk_delay_ms(_wakeMs);
+
+    uint32_t elapsed = sftk_ticks_ms() - wakeMs;
+    if (elapsed >= _timeoutMs)
+        return ksfTkErrXM125Timeout;
+
+    return waitBusy(_timeoutMs - elapsed, XM125_POLL_EXPECTED, _frameMs, transfers);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125LowPower::waitBusy(uint32_t timeoutMs, sfe_xm125_poll_strategy_t strategy,
+                                         uint32_t expectedMs, uint32_t &transfers)
+{
+    sfe_xm125_busy_poll_t poll;
+    _device->startBusyPoll(poll, timeoutMs, strategy, expectedMs);
+
+    sfTkError_t retVal;
+    while ((retVal = _device->pollBusy(poll)) == ksfTkErrXM125Busy)
+    {
+        // Sleep until the next poll is due
+        int32_t wait = (int32_t)(poll.nextPollMs - sftk_ticks_ms());
+        if (wait > 0)
+            sftk_delay_ms((uint32_t)wait);
+    }
+
+    // A failed read is not counted in polls
+    transfers += poll.polls;
+    if (retVal != ksfTkErrOk && retVal != ksfTkErrXM125Timeout)
+        transfers++;
+
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    sfDevXM125Status status;
+    sfDevXM125Distance::decodeStatus(poll.status, status);
+
+    return status.hasError() ? ksfTkErrXM125Detector : ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+uint32_t sfDevXM125LowPower::nextCycleMs(void)
+{
+    int32_t wait = (int32_t)(_nextWakeMs - sftk_ticks_ms());
+
+    return wait > 0 ? (uint32_t)wait : 0;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125LowPower::sleep(void)
+{
+    uint32_t sleepMs = nextCycleMs();
+    if (sleepMs == 0)
+        return;
+
+    if (_hostSleep != nullptr)
+        _hostSleep(sleepMs, _user);
+    else
+        sftk_delay_ms(sleepMs);
+
+    _stats.total_sleep_ms += sleepMs;
+}
@@ -0,0 +1,210 @@
+/**
+ * @file sfDevXM125LowPower.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the header of the duty cycled low power distance mode. The distance detector is
+ * set up once with measure on wakeup enabled; after that the module hibernates between frames, with
+ * its WAKE_UP pin low. Each cycle raises WAKE_UP, waits for the measurement the module makes on
+ * wakeup - on the MCU_INT pin when it is connected, otherwise with as few status reads as possible -
+ * reads the frame in two burst reads, and lowers WAKE_UP again. The host then sleeps until the next
+ * cycle is due.
+ *
+ * The pins are driven through callbacks, so the mode works with any GPIO and sleep API:
+ *
+ *     lowPower.begin(&radarSensor, setWakeUpPin, readMcuIntPin);
+ *     lowPower.setup(250, 3000);
+ *     while (true)
+ *     {
+ *         lowPower.cycle(frame);
+ *         lowPower.sleep();
+ *     }
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "sfDevXM125Distance.h"
+
+// Default time between two cycles in milliseconds
+const uint32_t SFE_XM125_LOW_POWER_PERIOD_DEFAULT = 10000;
+
+// Default time the module needs after WAKE_UP is raised before it answers on the bus, in
+// milliseconds - only used without the MCU_INT pin
+const uint32_t SFE_XM125_LOW_POWER_WAKE_MS_DEFAULT = 10;
+
+// Default time allowed from raising WAKE_UP to a finished measurement, in milliseconds
+const uint32_t SFE_XM125_LOW_POWER_TIMEOUT_DEFAULT = 1000;
+
+/// @brief Drives the WAKE_UP pin of the module - high wakes it up, low lets it hibernate
+/// @param level Pin level
+/// @param user User pointer passed to begin()
+typedef void (*sfe_xm125_wake_pin_cb_t)(bool level, void *user);
+
+/// @brief Returns the level of the MCU_INT pin of the module - high when it is ready
+/// @param user User pointer passed to begin()
+typedef bool (*sfe_xm125_ready_pin_cb_t)(void *user);
+
+/// @brief Writes the detector configuration - thresholds, profile and the like, not the range
+/// @param device The distance detector, awake and right after its setup
+/// @param user User pointer passed to begin()
+/// @return ksfTkErrOk on success, or error code (value < -1)
+typedef sfTkError_t (*sfe_xm125_configure_cb_t)(sfDevXM125Distance &device, void *user);
+
+/// @brief Puts the host to sleep
+/// @param sleepMs Time to sleep in milliseconds
+/// @param user User pointer passed to begin()
+typedef void (*sfe_xm125_host_sleep_cb_t)(uint32_t sleepMs, void *user);
+
+// Energy relevant statistics of the low power mode. Divide the totals by frames for the
+// average awake time and bus transfers per frame.
+typedef struct
+{
+    uint32_t cycles;           // cycles run
+    uint32_t frames;           // frames read
+    uint32_t errors;           // cycles that failed
+    uint32_t recalibrations;   // recalibrations run while awake
+    uint32_t last_awake_ms;    // time WAKE_UP was high in the last cycle
+    uint32_t max_awake_ms;     // longest time WAKE_UP was high
+    uint32_t total_awake_ms;   // sum of the times WAKE_UP was high
+    uint32_t last_transfers;   // bus transfers in the last cycle
+    uint32_t total_transfers;  // bus transfers in all cycles
+    uint32_t total_sleep_ms;   // time the host was put to sleep by sleep()
+} sfe_xm125_low_power_stats_t;
+
+class sfDevXM125LowPower
+{
+  public:
+    sfDevXM125LowPower()
+        : _device{nullptr}, _wakePin{nullptr}, _readyPin{nullptr}, _configure{nullptr}, _hostSleep{nullptr},
+          _user{nullptr},
+          _periodMs{SFE_XM125_LOW_POWER_PERIOD_DEFAULT}, _wakeMs{SFE_XM125_LOW_POWER_WAKE_MS_DEFAULT},
+          _timeoutMs{SFE_XM125_LOW_POWER_TIMEOUT_DEFAULT}, _frameMs{0}, _nextWakeMs{0}, _stats{} {};
+
+    /// @brief Sets the module and the pins used by the low power mode
+    /// @param device Distance detector - must outlive the low power mode
+    /// @param wakePin Drives the WAKE_UP pin
+    /// @param readyPin Reads the MCU_INT pin - nullptr when it is not connected, the status
+    ///  register is polled instead
+    /// @param user User pointer passed to the callbacks
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t begin(sfDevXM125Distance *device, sfe_xm125_wake_pin_cb_t wakePin,
+                      sfe_xm125_ready_pin_cb_t readyPin = nullptr, void *user = nullptr);
+
+    /// @brief Sets the function that writes the detector configuration in setup(). setup() calls it
+    ///  after the module reset, while the module is awake, and applies what it wrote.
+    /// @param configure Configuration function, nullptr for the default configuration
+    void setConfigure(sfe_xm125_configure_cb_t configure)
+    {
+        _configure = configure;
+    }
+
+    /// @brief Sets the function that puts the host to sleep in sleep(). Without one the host
+    ///  waits with sftk_delay_ms().
+    /// @param hostSleep Host sleep function
+    void setHostSleep(sfe_xm125_host_sleep_cb_t hostSleep)
+    {
+        _hostSleep = hostSleep;
+    }
+
+    /// @brief Sets the time between the start of two cycles
+    /// @param periodMs Period in milliseconds
+    void setPeriod(uint32_t periodMs)
+    {
+        _periodMs = periodMs;
+    }
+
+    /// @brief Returns the time between the start of two cycles in milliseconds
+    uint32_t period(void)
+    {
+        return _periodMs;
+    }
+
+    /// @brief Sets the time the module needs after WAKE_UP is raised before it answers on the bus.
+    ///  Only used without the MCU_INT pin.
+    /// @param wakeMs Time in milliseconds
+    void setWakeTime(uint32_t wakeMs)
+    {
+        _wakeMs = wakeMs;
+    }
+
+    /// @brief Sets the time allowed from raising WAKE_UP to a finished measurement
+    /// @param timeoutMs Timeout in milliseconds
+    void setTimeout(uint32_t timeoutMs)
+    {
+        _timeoutMs = timeoutMs;
+    }
+
+    /// @brief Wakes the module, sets up the distance detector with measure on wakeup enabled and
+    ///  lets it hibernate. The setup resets the module, so configuration registers written before
+    ///  are back at their defaults, and the module does not answer on the bus once it hibernates.
+    ///  Write the configuration from the callback set with setConfigure() instead.
+    /// @param startRange Start of the measured interval in mm
+    /// @param endRange End of the measured interval in mm
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t setup(uint32_t startRange = sfe_xm125_distance_start_default,
+                      uint32_t endRange = sfe_xm125_distance_end_default);
+
+    /// @brief Runs one cycle - wakes the module, waits for its measurement, reads the frame and
+    ///  lets the module hibernate again. The module is recalibrated while awake when the frame
+    ///  reports calibration needed; that frame is still returned, with the flag set.
+    /// @param frame Frame to fill
+    /// @return ksfTkErrOk on success, ksfTkErrXM125Timeout when the measurement did not finish in
+    ///  time, ksfTkErrXM125Detector when the detector reported an error, or error code (value < -1)
+    sfTkError_t cycle(sfe_xm125_distance_frame_t &frame);
+
+    /// @brief Sleeps the host until the next cycle is due. Cycles are a fixed period apart,
+    ///  whatever time a cycle took.
+    void sleep(void);
+
+    /// @brief Returns the time until the next cycle is due in milliseconds, 0 if it is due now
+    uint32_t nextCycleMs(void);
+
+    /// @brief Returns the statistics of the low power mode
+    const sfe_xm125_low_power_stats_t &stats(void)
+    {
+        return _stats;
+    }
+
+    /// @brief Clears the statistics
+    void resetStats(void)
+    {
+        _stats = sfe_xm125_low_power_stats_t();
+    }
+
+  private:
+    /// @brief Waits for the measurement the module makes on wakeup
+    /// @param wakeMs Time WAKE_UP was raised
+    /// @param transfers Incremented by the bus transfers used
+    sfTkError_t waitReady(uint32_t wakeMs, uint32_t &transfers);
+
+    /// @brief Waits for a command to finish by polling the busy bit, sleeping between polls, and
+    ///  checks the detector status of the last poll
+    /// @param transfers Incremented by the bus transfers used
+    sfTkError_t waitBusy(uint32_t timeoutMs, sfe_xm125_poll_strategy_t strategy, uint32_t expectedMs,
+                         uint32_t &transfers);
+
+    /// @brief Drives the WAKE_UP pin
+    void wake(bool level)
+    {
+        _wakePin(level, _user);
+    }
+
+    sfDevXM125Distance *_device;
+    sfe_xm125_wake_pin_cb_t _wakePin;
+    sfe_xm125_ready_pin_cb_t _readyPin;
+    sfe_xm125_configure_cb_t _configure;
+    sfe_xm125_host_sleep_cb_t _hostSleep;
+    void *_user;
+    uint32_t _periodMs;
+    uint32_t _wakeMs;
+    uint32_t _timeoutMs;
+    uint32_t _frameMs;
+    uint32_t _nextWakeMs;
+    sfe_xm125_low_power_stats_t _stats;
+};
@@ -0,0 +1,182 @@
+/**
+ * @file sfDevXM125Manager.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains a manager for several XM125 modules of the same application, on separate
+ * buses, at different addresses or behind an I2C mux (see sfDevXM125Mux.h). The manager runs the
+ * modules as a pipeline: all modules measure at the same time, and each one is read out and started
+ * again as soon as it has finished, while the others are still measuring.
+ *
+ * The pipeline needs modules that measure once per start - the distance detector. A started presence
+ * detector measures on its own and is never busy between frames, so it is not supported; use
+ * readStream() or the scheduler (sfDevXM125Scheduler.h) for presence modules.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "sfDevXM125Distance.h"
+#include "sfDevXM125Measurement.h"
+
+// Largest number of modules a manager can hold
+const uint8_t SFE_XM125_MANAGER_MAX_SENSORS = 16;
+
+/// @brief True when T is sfDevXM125Distance or derived from it - without <type_traits>, which
+///  AVR does not have
+template <class T> struct sfDevXM125IsDistance
+{
+    static char test(const sfDevXM125Distance *);
+    static long test(...);
+    static const bool value = sizeof(test((const T *)nullptr)) == sizeof(char);
+};
+
+/// @brief Manages up to N distance modules. TDevice is sfDevXM125Distance, or a class derived
+///  from it such as SparkFunXM125Distance.
+template <class TDevice, uint8_t N> class sfDevXM125Manager
+{
+    static_assert(N > 0 && N <= SFE_XM125_MANAGER_MAX_SENSORS, "sfDevXM125Manager: unsupported number of sensors");
+    static_assert(sfDevXM125IsDistance<TDevice>::value,
+                  "sfDevXM125Manager: only distance modules measure once per start - see sfDevXM125Scheduler");
+
+  public:
+    /// @brief Called by service() once a module has finished a measurement - index is the index
+    ///  returned by addSensor()
+    typedef typename sfDevXM125Measurement<TDevice>::readout_cb_t readout_cb_t;
+
+    sfDevXM125Manager() : _count{0}, _timeoutMs{SFE_XM125_BUSY_WAIT_TIMEOUT_DEFAULT}
+    {
+    }
+
+    /// @brief Adds a module and calls its begin()
+    /// @param theBus Bus of the module - for a module behind a mux, an sfDevXM125MuxChannel
+    /// @param index Index of the added module
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t addSensor(sfTkII2C *theBus, uint8_t &index)
+    {
+        if (_count >= N)
+            return ksfTkErrFail;
+
+        // Qualified, as SparkFunXM125Distance hides this begin() with its Arduino one
+        sfTkError_t retVal = _sensors[_count].sfDevXM125Distance::begin(theBus);
+        if (retVal != ksfTkErrOk)
+            return retVal;
+
+        index = _count++;
+        return ksfTkErrOk;
+    }
+
+    /// @brief Returns the number of modules added
+    uint8_t count(void)
+    {
+        return _count;
+    }
+
+    /// @brief Returns a module, for configuration and readout
+    /// @param index Index of the module - must be less than count()
+    TDevice &sensor(uint8_t index)
+    {
+        return _sensors[index];
+    }
+
+    /// @brief Sets the time allowed for a measurement
+    /// @param timeoutMs Timeout in milliseconds
+    void setTimeout(uint32_t timeoutMs)
+    {
+        _timeoutMs = timeoutMs;
+    }
+
+    /// @brief Starts a measurement on one module. The module is not polled before expectedMs.
+    /// @param index Index of the module
+    /// @param expectedMs Expected measurement duration
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t start(uint8_t index, uint32_t expectedMs = 0)
+    {
+        if (index >= _count)
+            return ksfTkErrFail;
+
+        _expectedMs[index] = expectedMs;
+        return _measurement[index].start(_sensors[index], _timeoutMs, expectedMs);
+    }
+
+    /// @brief Starts a measurement on all modules
+    /// @param expectedMs Expected measurement duration
+    /// @return ksfTkErrOk if all modules started, otherwise the error of the last module that failed
+    sfTkError_t startAll(uint32_t expectedMs = 0)
+    {
+        sfTkError_t retVal = ksfTkErrOk;
+
+        for (uint8_t i = 0; i < _count; i++)
+        {
+            if (start(i, expectedMs) != ksfTkErrOk)
+                retVal = _measurement[i].lastError();
+        }
+
+        return retVal;
+    }
+
+    /// @brief Performs one non-blocking pass over the modules. Each module that has finished
+    ///  is read out through the callback, then started again when restart is set. Call this
+    ///  from the main loop. A module that fails stops - see lastError().
+    /// @param callback Called for each finished module
+    /// @param user User pointer passed to the callback
+    /// @param restart Start the next measurement right after the readout
+    /// @return Number of modules read out in this pass
+    uint8_t service(readout_cb_t callback, void *user = nullptr, bool restart = true)
+    {
+        uint8_t done = 0;
+
+        for (uint8_t i = 0; i < _count; i++)
+        {
+            if (!_measurement[i].poll(_sensors[i]) || _measurement[i].lastError() != ksfTkErrOk)
+                continue;
+
+            _measurement[i].readout(_sensors[i], i, callback, user);
+            done++;
+
+            if (restart)
+                start(i, _expectedMs[i]);
+        }
+
+        return done;
+    }
+
+    /// @brief Returns true while any module is measuring
+    bool busy(void)
+    {
+        for (uint8_t i = 0; i < _count; i++)
+        {
+            if (_measurement[i].running())
+                return true;
+        }
+        return false;
+    }
+
+    /// @brief Returns true while a module is measuring
+    /// @param index Index of the module
+    bool running(uint8_t index)
+    {
+        return index < _count && _measurement[index].running();
+    }
+
+    /// @brief Returns the result of the last start or measurement of a module
+    /// @param index Index of the module
+    sfTkError_t lastError(uint8_t index)
+    {
+        return index < _count ? _measurement[index].lastError() : ksfTkErrFail;
+    }
+
+  private:
+    TDevice _sensors[N];
+    uint8_t _count;
+    uint32_t _timeoutMs;
+
+    // per module measurement state
+    sfDevXM125Measurement<TDevice> _measurement[N];
+    uint32_t _expectedMs[N];
+};
@@ -0,0 +1,126 @@
+/**
+ * @file sfDevXM125Measurement.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the measurement step shared by the multi module drivers - the manager
+ * (sfDevXM125Manager.h) and the scheduler (sfDevXM125Scheduler.h): start a module, poll its busy bit
+ * without blocking until the measurement has ended, and hand the finished module to the readout
+ * callback.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "sfDevXM125Core.h"
+
+/// @brief The measurement state of one module. TDevice is sfDevXM125Distance or sfDevXM125Presence -
+///  any class with start() and the busy poll of sfDevXM125Core will do.
+template <class TDevice> class sfDevXM125Measurement
+{
+  public:
+    /// @brief Called with a module that has a new frame
+    /// @param index Index of the module in its manager or scheduler
+    /// @param device The module - read the results here
+    /// @param user User pointer passed to service()
+    typedef void (*readout_cb_t)(uint8_t index, TDevice &device, void *user);
+
+    sfDevXM125Measurement() : _running{false}, _lastError{ksfTkErrOk}, _frames{0}, _poll{}
+    {
+    }
+
+    /// @brief Starts a measurement and prepares its busy poll
+    /// @param device The module
+    /// @param timeoutMs Time allowed for the measurement
+    /// @param expectedMs Expected measurement duration - the module is not polled before
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t start(TDevice &device, uint32_t timeoutMs, uint32_t expectedMs)
+    {
+        _lastError = device.start();
+        _running = _lastError == ksfTkErrOk;
+        if (_running)
+            device.startBusyPoll(_poll, timeoutMs, XM125_POLL_EXPECTED, expectedMs);
+
+        return _lastError;
+    }
+
+    /// @brief Polls a running measurement once, reading the status register only when a poll is due
+    /// @param device The module
+    /// @return true once the measurement has ended - check lastError() - false while it runs or
+    ///  when none was started
+    bool poll(TDevice &device)
+    {
+        if (!_running)
+            return false;
+
+        sfTkError_t retVal = device.pollBusy(_poll);
+        if (retVal == ksfTkErrXM125Busy)
+            return false;
+
+        _running = false;
+        _lastError = retVal;
+        return true;
+    }
+
+    /// @brief Counts a frame and passes the module to the callback
+    /// @param device The module
+    /// @param index Index of the module, passed to the callback
+    /// @param callback Called with the module, may be nullptr
+    /// @param user User pointer passed to the callback
+    void readout(TDevice &device, uint8_t index, readout_cb_t callback, void *user)
+    {
+        _frames++;
+        if (callback != nullptr)
+            callback(index, device, user);
+    }
+
+    /// @brief Ends the measurement with an error found outside the busy poll
+    /// @param error The error
+    void fail(sfTkError_t error)
+    {
+        _running = false;
+        _lastError = error;
+    }
+
+    /// @brief Records a successful step outside the busy poll
+    void clearError(void)
+    {
+        _lastError = ksfTkErrOk;
+    }
+
+    /// @brief Returns true while a measurement runs
+    bool running(void)
+    {
+        return _running;
+    }
+
+    /// @brief Returns the result of the last start or measurement
+    sfTkError_t lastError(void)
+    {
+        return _lastError;
+    }
+
+    /// @brief Returns the number of frames read out
+    uint32_t frames(void)
+    {
+        return _frames;
+    }
+
+    /// @brief Returns the busy poll of the last measurement - when it started, how often the status
+    ///  was read and when the next poll is due
+    const sfe_xm125_busy_poll_t &busyPoll(void)
+    {
+        return _poll;
+    }
+
+  private:
+    bool _running;
+    sfTkError_t _lastError;
+    uint32_t _frames;
+    sfe_xm125_busy_poll_t _poll;
+};
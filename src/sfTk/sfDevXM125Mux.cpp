@@ -0,0 +1,152 @@
+/**
+ * @file sfDevXM125Mux.cpp
+ * @brief Implementation of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the implementation of the TCA9548 style I2C multiplexer support.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "sfDevXM125Mux.h"
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Mux::init(sfTkII2C *theBus)
+{
+    if (theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    _theBus = theBus;
+    _channel = SFE_XM125_MUX_NO_CHANNEL;
+
+    return _theBus->ping();
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Mux::writeChannelMask(uint8_t mask)
+{
+    if (_theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    // The mux has a single control register, written without a register address
+    return _theBus->writeData(&mask, 1);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Mux::select(uint8_t channel)
+{
+    if (channel >= SFE_XM125_MUX_CHANNELS)
+        return ksfTkErrFail;
+
+    if (channel == _channel)
+        return ksfTkErrOk;
+
+    sfTkError_t retVal = writeChannelMask((uint8_t)(1 << channel));
+
+    // After a failed write the mux state is unknown
+    _channel = retVal == ksfTkErrOk ? channel : SFE_XM125_MUX_NO_CHANNEL;
+
+    return retVal;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Mux::deselect(void)
+{
+    sfTkError_t retVal = writeChannelMask(0);
+
+    _channel = SFE_XM125_MUX_NO_CHANNEL;
+
+    return retVal;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125MuxChannel::init(sfDevXM125Mux *mux, uint8_t channel, sfTkII2C *theBus)
+{
+    if (mux == nullptr || theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    if (channel >= SFE_XM125_MUX_CHANNELS)
+        return ksfTkErrFail;
+
+    _mux = mux;
+    _channel = channel;
+    _theBus = theBus;
+
+    // Present the device address, so device init() checks work
+    setAddress(_theBus->address());
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125MuxChannel::select(void)
+{
+    if (_mux == nullptr || _theBus == nullptr)
+        return ksfTkErrBusNotInit;
+
+    return _mux->select(_channel);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125MuxChannel::ping()
+{
+    sfTkError_t retVal = select();
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    return _theBus->ping();
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125MuxChannel::writeData(const uint8_t *data, size_t length)
+{
+    sfTkError_t retVal = select();
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    return _theBus->writeData(data, length);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125MuxChannel::writeRegister(uint8_t devReg, const uint8_t *data, size_t length)
+{
+    sfTkError_t retVal = select();
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    return _theBus->writeRegister(devReg, data, length);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125MuxChannel::writeRegister(uint16_t devReg, const uint8_t *data, size_t length)
+{
+    sfTkError_t retVal = select();
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    return _theBus->writeRegister(devReg, data, length);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125MuxChannel::readRegister(uint8_t devReg, uint8_t *data, size_t numBytes, size_t &readBytes,
+                                               uint32_t read_delay)
+{
+    sfTkError_t retVal = select();
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    return _theBus->readRegister(devReg, data, numBytes, readBytes, read_delay);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125MuxChannel::readRegister(uint16_t devReg, uint8_t *data, size_t numBytes, size_t &readBytes,
+                                               uint32_t read_delay)
+{
+    sfTkError_t retVal = select();
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    return _theBus->readRegister(devReg, data, numBytes, readBytes, read_delay);
+}
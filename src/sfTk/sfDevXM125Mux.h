@@ -0,0 +1,120 @@
+/**
+ * @file sfDevXM125Mux.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the header of the TCA9548 style I2C multiplexer support. Each mux channel is
+ * presented as its own toolkit I2C bus, which selects the channel before each transfer, so a device
+ * object behind a mux works unchanged.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <sfTk/sfToolkit.h>
+// Bus interfaces
+#include <sfTk/sfTkII2C.h>
+
+// The default I2C address of a TCA9548 mux - address pins select 0x70 to 0x77
+const uint8_t SFE_XM125_MUX_I2C_ADDRESS = 0x70;
+
+// Number of channels on a TCA9548 mux
+const uint8_t SFE_XM125_MUX_CHANNELS = 8;
+
+// No channel is known to be selected
+const uint8_t SFE_XM125_MUX_NO_CHANNEL = 0xff;
+
+class sfDevXM125Mux
+{
+  public:
+    sfDevXM125Mux() : _theBus{nullptr}, _channel{SFE_XM125_MUX_NO_CHANNEL} {};
+
+    /// @brief Sets the bus used to talk to the mux itself
+    /// @param theBus I2C bus with the address of the mux
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t init(sfTkII2C *theBus);
+
+    /// @brief Routes the downstream bus to a channel. The mux is only written when the
+    ///  channel changes.
+    /// @param channel Channel to select - 0 to SFE_XM125_MUX_CHANNELS - 1
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t select(uint8_t channel);
+
+    /// @brief Disconnects all channels from the downstream bus
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t deselect(void);
+
+    /// @brief Returns the selected channel, SFE_XM125_MUX_NO_CHANNEL if unknown
+    uint8_t channel(void)
+    {
+        return _channel;
+    }
+
+    /// @brief Forgets the selected channel, so the next select() writes the mux. Use this
+    ///  when something else may have changed the mux.
+    void invalidate(void)
+    {
+        _channel = SFE_XM125_MUX_NO_CHANNEL;
+    }
+
+  private:
+    sfTkError_t writeChannelMask(uint8_t mask);
+
+    sfTkII2C *_theBus;
+    uint8_t _channel;
+};
+
+class sfDevXM125MuxChannel : public sfTkII2C
+{
+  public:
+    sfDevXM125MuxChannel() : _mux{nullptr}, _theBus{nullptr}, _channel{0} {};
+
+    /// @brief Sets up the channel bus
+    /// @param mux Mux the device is connected to
+    /// @param channel Mux channel of the device
+    /// @param theBus I2C bus with the address of the device, on the downstream side of the mux
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t init(sfDevXM125Mux *mux, uint8_t channel, sfTkII2C *theBus);
+
+    // Make the typed register helpers of the bus interface visible next to the overrides below
+    using sfTkIBus::readRegister;
+    using sfTkIBus::writeRegister;
+
+    /// @brief Selects the channel and pings the device
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t ping() override;
+
+    /// @brief Selects the channel and writes raw data to the device
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeData(const uint8_t *data, size_t length) override;
+
+    /// @brief Selects the channel and writes to a device register
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeRegister(uint8_t devReg, const uint8_t *data, size_t length) override;
+
+    /// @brief Selects the channel and writes to a device register
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeRegister(uint16_t devReg, const uint8_t *data, size_t length) override;
+
+    /// @brief Selects the channel and reads from a device register
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readRegister(uint8_t devReg, uint8_t *data, size_t numBytes, size_t &readBytes,
+                             uint32_t read_delay = 0) override;
+
+    /// @brief Selects the channel and reads from a device register
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readRegister(uint16_t devReg, uint8_t *data, size_t numBytes, size_t &readBytes,
+                             uint32_t read_delay = 0) override;
+
+  private:
+    sfTkError_t select(void);
+
+    sfDevXM125Mux *_mux;
+    sfTkII2C *_theBus;
+    uint8_t _channel;
+};
@@ -0,0 +1,356 @@
+/**
+ * @file sfDevXM125Packet.cpp
+ * @brief Implementation of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the implementation of the packed binary packet format.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <string.h>
+
+#include "sfDevXM125Packet.h"
+
+//--------------------------------------------------------------------------------
+uint16_t sfDevXM125Packet::crc16(const uint8_t *data, size_t length, uint16_t crc)
+{
+    // Bitwise - no table, to keep the flash footprint small
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = crc & 0x8000 ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+
+    return crc;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125PacketWriter::begin(uint8_t *buffer, size_t size, uint8_t type)
+{
+    _buffer = buffer;
+    _size = size;
+    _length = 0;
+    _overflow = buffer == nullptr || size < SFE_XM125_PACKET_HEADER_SIZE + SFE_XM125_PACKET_CRC_SIZE;
+
+    if (_overflow)
+        return;
+
+    _buffer[0] = SFE_XM125_PACKET_SYNC1;
+    _buffer[1] = SFE_XM125_PACKET_SYNC2;
+    _buffer[2] = type;
+    _buffer[3] = 0; // length, filled in by end()
+    _length = SFE_XM125_PACKET_HEADER_SIZE;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125PacketWriter::putByte(uint8_t value)
+{
+    // Keep room for the CRC, and stay inside the largest payload
+    if (_overflow || _length + SFE_XM125_PACKET_CRC_SIZE >= _size ||
+        _length - SFE_XM125_PACKET_HEADER_SIZE >= SFE_XM125_PACKET_MAX_PAYLOAD)
+    {
+        _overflow = true;
+        return;
+    }
+
+    _buffer[_length++] = value;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125PacketWriter::putVarint(uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        putByte((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    putByte((uint8_t)value);
+}
+
+//--------------------------------------------------------------------------------
+size_t sfDevXM125PacketWriter::end(void)
+{
+    if (_overflow)
+        return 0;
+
+    _buffer[3] = (uint8_t)(_length - SFE_XM125_PACKET_HEADER_SIZE);
+
+    // The CRC covers type, length and payload
+    uint16_t crc = sfDevXM125Packet::crc16(&_buffer[2], _length - 2);
+    _buffer[_length++] = (uint8_t)(crc & 0xff);
+    _buffer[_length++] = (uint8_t)(crc >> 8);
+
+    return _length;
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125PacketReader::getByte(uint8_t &value)
+{
+    if (_pos >= _length)
+        return false;
+
+    value = _payload[_pos++];
+    return true;
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125PacketReader::getVarint(uint32_t &value)
+{
+    value = 0;
+
+    // A 32-bit value takes at most 5 bytes
+    for (uint8_t shift = 0; shift < 35; shift += 7)
+    {
+        uint8_t byte;
+        if (!getByte(byte))
+            return false;
+
+        value |= (uint32_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125PacketReader::getSigned(int32_t &value)
+{
+    uint32_t raw;
+    if (!getVarint(raw))
+        return false;
+
+    value = sfDevXM125Packet::unzigzag(raw);
+    return true;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125PacketDecoder::reset(void)
+{
+    _state = kSync1;
+    _count = 0;
+    _scan = 0;
+    _frames = 0;
+    _crcErrors = 0;
+    _formatErrors = 0;
+    _skipped = 0;
+    memset(&_frame, 0, sizeof(_frame));
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125PacketDecoder::decodePayload(uint8_t type, const uint8_t *payload, size_t length,
+                                          sfe_xm125_packet_frame_t &frame)
+{
+    sfDevXM125PacketReader reader(payload, length);
+    int32_t temperature;
+
+    frame.type = type;
+
+    if (!reader.getVarint(frame.measure_counter) || !reader.getVarint(frame.timestamp))
+        return false;
+
+    if (type == SFE_XM125_PACKET_TYPE_DISTANCE)
+    {
+        if (!reader.getSigned(temperature) || !reader.getByte(frame.flags) || !reader.getByte(frame.num_peaks) ||
+            frame.num_peaks > SFE_XM125_PACKET_MAX_PEAKS)
+            return false;
+
+        // First distance, then deltas to the previous peak
+        int32_t distance = 0;
+        for (uint8_t i = 0; i < frame.num_peaks; i++)
+        {
+            int32_t delta;
+            if (i == 0)
+            {
+                uint32_t first;
+                if (!reader.getVarint(first))
+                    return false;
+                delta = (int32_t)first;
+            }
+            else if (!reader.getSigned(delta))
+                return false;
+
+            distance += delta;
+            frame.distance[i] = (uint16_t)distance;
+        }
+
+        for (uint8_t i = 0; i < frame.num_peaks; i++)
+        {
+            int32_t strength;
+            if (!reader.getSigned(strength))
+                return false;
+            frame.strength[i] = (int16_t)strength;
+        }
+    }
+    else if (type == SFE_XM125_PACKET_TYPE_PRESENCE)
+    {
+        if (!reader.getByte(frame.flags) || !reader.getSigned(temperature) ||
+            !reader.getVarint(frame.presence_distance) || !reader.getVarint(frame.intra_score) ||
+            !reader.getVarint(frame.inter_score))
+            return false;
+
+        frame.num_peaks = 0;
+    }
+    else
+        return false;
+
+    frame.temperature = (int16_t)temperature;
+
+    // Trailing bytes mean the packet does not match this format
+    return reader.atEnd();
+}
+
+//--------------------------------------------------------------------------------
+// Returns true if a payload of this length can hold a packet of this type
+static bool payloadLengthValid(uint8_t type, uint8_t length)
+{
+    const uint8_t framing = SFE_XM125_PACKET_HEADER_SIZE + SFE_XM125_PACKET_CRC_SIZE;
+
+    if (type == SFE_XM125_PACKET_TYPE_DISTANCE)
+        return length >= SFE_XM125_PACKET_DISTANCE_MIN_PAYLOAD &&
+               length <= SFE_XM125_PACKET_DISTANCE_MAX_PACKET - framing;
+
+    if (type == SFE_XM125_PACKET_TYPE_PRESENCE)
+        return length >= SFE_XM125_PACKET_PRESENCE_MIN_PAYLOAD &&
+               length <= SFE_XM125_PACKET_PRESENCE_MAX_PACKET - framing;
+
+    return false;
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125PacketDecoder::completePacket(void)
+{
+    // Decode into a copy, so frame() keeps the last valid packet
+    sfe_xm125_packet_frame_t frame;
+    if (!decodePayload(_packet[0], &_packet[2], _packet[1], frame))
+    {
+        _formatErrors++;
+        return false;
+    }
+
+    _frame = frame;
+    _frames++;
+    return true;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125PacketDecoder::discardProcessed(void)
+{
+    _count -= _scan;
+    if (_count > 0)
+        memmove(_packet, &_packet[_scan], _count);
+    _scan = 0;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125PacketDecoder::restartSearch(void)
+{
+    // The packet started right after its sync - search its bytes again from there
+    _state = kSync1;
+    _scan = 0;
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125PacketDecoder::feed(uint8_t byte)
+{
+    // Never full - at most a packet less its last byte is held here, and after a packet is decoded
+    // from the held bytes, fewer than before
+    _packet[_count++] = byte;
+
+    // Usually only the new byte - after a rejected packet, also the bytes that followed its sync.
+    // Stop at a decoded packet; the bytes left are processed on the next call, ahead of its byte.
+    while (_scan < _count)
+    {
+        if (process(_packet[_scan++]))
+            return true;
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125PacketDecoder::process(uint8_t byte)
+{
+    bool decoded;
+
+    // Packet bytes are held from the type on, so the payload starts at _packet[2]
+    switch (_state)
+    {
+    case kSync1:
+        if (byte == SFE_XM125_PACKET_SYNC1)
+            _state = kSync2;
+        else
+            _skipped++;
+        break;
+
+    case kSync2:
+        if (byte == SFE_XM125_PACKET_SYNC2)
+        {
+            _state = kType;
+            discardProcessed();
+            return false;
+        }
+
+        _skipped++;
+        _state = byte == SFE_XM125_PACKET_SYNC1 ? kSync2 : kSync1;
+        break;
+
+    case kType:
+        _state = kLength;
+        return false;
+
+    case kLength:
+        // A length the type can not have - most likely a false sync, or a corrupted header
+        if (!payloadLengthValid(_packet[0], byte))
+        {
+            _formatErrors++;
+            restartSearch();
+            return false;
+        }
+        _state = kPayload;
+        return false;
+
+    case kPayload:
+        if (_scan == 2u + _packet[1])
+            _state = kCrcLow;
+        return false;
+
+    case kCrcLow:
+        // The CRC covers type, length and payload
+        _crc = sfDevXM125Packet::crc16(_packet, 2u + _packet[1]);
+        if (byte != (uint8_t)(_crc & 0xff))
+        {
+            _crcErrors++;
+            restartSearch();
+            return false;
+        }
+        _state = kCrcHigh;
+        return false;
+
+    case kCrcHigh:
+        if (byte != (uint8_t)(_crc >> 8))
+        {
+            _crcErrors++;
+            restartSearch();
+            return false;
+        }
+        _state = kSync1;
+        decoded = completePacket();
+        discardProcessed();
+        return decoded;
+
+    default:
+        _state = kSync1;
+        break;
+    }
+
+    // Searching for a sync - the bytes processed are no longer needed
+    if (_scan == _count)
+        _count = _scan = 0;
+
+    return false;
+}
@@ -0,0 +1,276 @@
+/**
+ * @file sfDevXM125Packet.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the packed binary packet format used to stream measurement frames over a serial
+ * link, with the packet writer and the decoder. It does not depend on the toolkit or on Arduino, so
+ * the decoder also builds on a host (see tools/xm125_decode).
+ *
+ * Packet layout, all multi-byte header fields little endian:
+ *
+ *     0xA5 0x5A   sync
+ *     type        SFE_XM125_PACKET_TYPE_*
+ *     length      payload length, 0 - 255
+ *     payload     length bytes
+ *     crc         CRC-16/CCITT-FALSE (poly 0x1021, init 0xffff) of type, length and payload, 2 bytes
+ *
+ * Payload fields are varints - 7 bits per byte, least significant group first, bit 7 set on all but
+ * the last byte. Signed fields are zigzag encoded first (0, -1, 1, -2 ... become 0, 1, 2, 3 ...).
+ *
+ * Distance payload:
+ *     varint   measure counter
+ *     varint   timestamp in ms
+ *     signed   temperature
+ *     byte     flags (SFE_XM125_DISTANCE_FRAME_*)
+ *     byte     number of peaks n, 0 - 10
+ *     varint   distance of peak 0 in mm, then n - 1 signed deltas to the distance of the previous peak
+ *     signed   n peak strengths in 0.01 dB
+ *
+ * Presence payload:
+ *     varint   measure counter
+ *     varint   timestamp in ms
+ *     byte     flags (SFE_XM125_PACKET_PRESENCE_*)
+ *     signed   temperature
+ *     varint   distance in mm
+ *     varint   intra presence score
+ *     varint   inter presence score
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sfDevXM125DistanceFlags.h"
+
+// Packet framing
+const uint8_t SFE_XM125_PACKET_SYNC1 = 0xa5;
+const uint8_t SFE_XM125_PACKET_SYNC2 = 0x5a;
+const uint8_t SFE_XM125_PACKET_HEADER_SIZE = 4; // sync, type and length
+const uint8_t SFE_XM125_PACKET_CRC_SIZE = 2;
+const uint16_t SFE_XM125_PACKET_MAX_PAYLOAD = 255;
+
+// Packet types
+const uint8_t SFE_XM125_PACKET_TYPE_DISTANCE = 0x01;
+const uint8_t SFE_XM125_PACKET_TYPE_PRESENCE = 0x02;
+
+// Largest packets of each type - buffers of this size always hold a packet
+const uint8_t SFE_XM125_PACKET_DISTANCE_MAX_PACKET = 81;
+const uint8_t SFE_XM125_PACKET_PRESENCE_MAX_PACKET = 35;
+
+// Shortest payloads of each type - every varint in a single byte, and no peaks
+const uint8_t SFE_XM125_PACKET_DISTANCE_MIN_PAYLOAD = 5;
+const uint8_t SFE_XM125_PACKET_PRESENCE_MIN_PAYLOAD = 7;
+
+// Peaks in a distance packet
+const uint8_t SFE_XM125_PACKET_MAX_PEAKS = 10;
+
+// Presence packet flags
+const uint8_t SFE_XM125_PACKET_PRESENCE_DETECTED = 0x01;
+const uint8_t SFE_XM125_PACKET_PRESENCE_DETECTED_STICKY = 0x02;
+const uint8_t SFE_XM125_PACKET_PRESENCE_DETECTOR_ERROR = 0x04;
+
+// A decoded packet - the fields of the packet type are valid
+typedef struct
+{
+    uint8_t type;             // SFE_XM125_PACKET_TYPE_*
+    uint32_t measure_counter; // measure counter of the device
+    uint32_t timestamp;       // host time of the read in ms
+    int16_t temperature;      // sensor temperature
+    uint8_t flags;            // distance or presence flags
+
+    // distance packets
+    uint8_t num_peaks;                          // number of peaks
+    uint16_t distance[SFE_XM125_PACKET_MAX_PEAKS]; // peak distances in mm
+    int16_t strength[SFE_XM125_PACKET_MAX_PEAKS];  // peak strengths in 0.01 dB
+
+    // presence packets
+    uint32_t presence_distance; // distance to the detected presence in mm
+    uint32_t intra_score;       // measure of fast motion
+    uint32_t inter_score;       // measure of slow motion
+} sfe_xm125_packet_frame_t;
+
+class sfDevXM125Packet
+{
+  public:
+    /// @brief Computes the CRC-16/CCITT-FALSE of a block of bytes
+    /// @param data Bytes to check
+    /// @param length Number of bytes
+    /// @param crc CRC of the preceding bytes, to continue a calculation
+    /// @return The CRC
+    static uint16_t crc16(const uint8_t *data, size_t length, uint16_t crc = 0xffff);
+
+    /// @brief Maps a signed value to an unsigned one, small magnitudes to small values
+    static uint32_t zigzag(int32_t value)
+    {
+        return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+    }
+
+    /// @brief Reverses zigzag()
+    static int32_t unzigzag(uint32_t value)
+    {
+        return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+    }
+};
+
+/// @brief Builds a packet in a caller supplied buffer
+class sfDevXM125PacketWriter
+{
+  public:
+    sfDevXM125PacketWriter() : _buffer{nullptr}, _size{0}, _length{0}, _overflow{false} {};
+
+    /// @brief Starts a packet
+    /// @param buffer Buffer for the packet
+    /// @param size Size of the buffer
+    /// @param type Packet type
+    void begin(uint8_t *buffer, size_t size, uint8_t type);
+
+    /// @brief Appends a byte to the payload
+    void putByte(uint8_t value);
+
+    /// @brief Appends a varint to the payload
+    void putVarint(uint32_t value);
+
+    /// @brief Appends a zigzag encoded varint to the payload
+    void putSigned(int32_t value)
+    {
+        putVarint(sfDevXM125Packet::zigzag(value));
+    }
+
+    /// @brief Finishes the packet - fills in the length and the CRC
+    /// @return Size of the packet in bytes, 0 if it did not fit in the buffer
+    size_t end(void);
+
+  private:
+    uint8_t *_buffer;
+    size_t _size;
+    size_t _length; // bytes written, including the header
+    bool _overflow;
+};
+
+/// @brief Reads the fields of a packet payload
+class sfDevXM125PacketReader
+{
+  public:
+    /// @brief Creates a reader over a payload
+    /// @param payload Payload bytes
+    /// @param length Payload length
+    sfDevXM125PacketReader(const uint8_t *payload, size_t length) : _payload{payload}, _length{length}, _pos{0} {};
+
+    /// @brief Reads a byte, returns false past the end of the payload
+    bool getByte(uint8_t &value);
+
+    /// @brief Reads a varint, returns false if it is truncated or too long
+    bool getVarint(uint32_t &value);
+
+    /// @brief Reads a zigzag encoded varint, returns false if it is truncated or too long
+    bool getSigned(int32_t &value);
+
+    /// @brief Returns true once the whole payload has been read
+    bool atEnd(void)
+    {
+        return _pos == _length;
+    }
+
+  private:
+    const uint8_t *_payload;
+    size_t _length;
+    size_t _pos;
+};
+
+/// @brief Decodes a byte stream of packets. Bytes before a sync and packets with a wrong CRC or
+///  payload are skipped, so the decoder resynchronizes after lost or corrupted bytes. A packet
+///  rejected by its length or CRC is searched again for a sync from the byte after its own, so a
+///  false sync inside a packet does not hide the packets that follow.
+class sfDevXM125PacketDecoder
+{
+  public:
+    sfDevXM125PacketDecoder()
+    {
+        reset();
+    }
+
+    /// @brief Drops any partial packet and clears the counters
+    void reset(void);
+
+    /// @brief Adds a received byte
+    /// @param byte The byte
+    /// @return true when the byte completed a valid packet - see frame()
+    bool feed(uint8_t byte);
+
+    /// @brief Returns the last decoded packet
+    const sfe_xm125_packet_frame_t &frame(void)
+    {
+        return _frame;
+    }
+
+    /// @brief Returns the number of valid packets decoded
+    uint32_t frames(void)
+    {
+        return _frames;
+    }
+
+    /// @brief Returns the number of packets dropped because of a wrong CRC
+    uint32_t crcErrors(void)
+    {
+        return _crcErrors;
+    }
+
+    /// @brief Returns the number of packets dropped because of an unknown type, a length that does not
+    ///  fit the type or a bad payload
+    uint32_t formatErrors(void)
+    {
+        return _formatErrors;
+    }
+
+    /// @brief Returns the number of bytes skipped while looking for a sync
+    uint32_t skippedBytes(void)
+    {
+        return _skipped;
+    }
+
+    /// @brief Decodes the payload of a packet
+    /// @param type Packet type
+    /// @param payload Payload bytes
+    /// @param length Payload length
+    /// @param frame Decoded packet
+    /// @return true if the payload is valid for the type
+    static bool decodePayload(uint8_t type, const uint8_t *payload, size_t length, sfe_xm125_packet_frame_t &frame);
+
+  private:
+    typedef enum
+    {
+        kSync1 = 0,
+        kSync2 = 1,
+        kType = 2,
+        kLength = 3,
+        kPayload = 4,
+        kCrcLow = 5,
+        kCrcHigh = 6,
+    } state_t;
+
+    bool process(uint8_t byte);
+    void discardProcessed(void);
+    void restartSearch(void);
+    bool completePacket(void);
+
+    uint8_t _state; // state_t
+    uint16_t _count; // bytes held in _packet
+    uint16_t _scan;  // bytes of _packet already processed
+    uint16_t _crc;
+
+    // Type, length, payload and CRC of the packet being received - after a rejected packet, also the
+    // bytes still to be searched for a sync
+    uint8_t _packet[2 + SFE_XM125_PACKET_MAX_PAYLOAD + SFE_XM125_PACKET_CRC_SIZE];
+
+    sfe_xm125_packet_frame_t _frame;
+    uint32_t _frames;
+    uint32_t _crcErrors;
+    uint32_t _formatErrors;
+    uint32_t _skipped;
+};
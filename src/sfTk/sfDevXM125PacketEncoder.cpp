@@ -0,0 +1,67 @@
+/**
+ * @file sfDevXM125PacketEncoder.cpp
+ * @brief Implementation of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the implementation of the packet format encoder.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "sfDevXM125PacketEncoder.h"
+
+//--------------------------------------------------------------------------------
+size_t sfDevXM125PacketEncoder::encode(const sfe_xm125_distance_frame_t &frame, uint8_t *buffer, size_t size)
+{
+    sfDevXM125PacketWriter writer;
+    uint8_t numPeaks = frame.num_peaks < SFE_XM125_PACKET_MAX_PEAKS ? frame.num_peaks : SFE_XM125_PACKET_MAX_PEAKS;
+
+    writer.begin(buffer, size, SFE_XM125_PACKET_TYPE_DISTANCE);
+    writer.putVarint(frame.measure_counter);
+    writer.putVarint(frame.timestamp);
+    writer.putSigned(frame.temperature);
+    writer.putByte(frame.flags);
+    writer.putByte(numPeaks);
+
+    // Peaks are usually close together or sorted by distance, so deltas stay small
+    for (uint8_t i = 0; i < numPeaks; i++)
+    {
+        if (i == 0)
+            writer.putVarint(frame.distance[0]);
+        else
+            writer.putSigned((int32_t)frame.distance[i] - (int32_t)frame.distance[i - 1]);
+    }
+
+    for (uint8_t i = 0; i < numPeaks; i++)
+        writer.putSigned(frame.strength[i]);
+
+    return writer.end();
+}
+
+//--------------------------------------------------------------------------------
+size_t sfDevXM125PacketEncoder::encode(const sfe_xm125_presence_frame_t &frame, uint32_t timestampMs, uint8_t *buffer,
+                                       size_t size)
+{
+    sfDevXM125PacketWriter writer;
+    uint8_t flags = 0;
+
+    if (frame.detected)
+        flags |= SFE_XM125_PACKET_PRESENCE_DETECTED;
+    if (frame.detected_sticky)
+        flags |= SFE_XM125_PACKET_PRESENCE_DETECTED_STICKY;
+    if (frame.detector_error)
+        flags |= SFE_XM125_PACKET_PRESENCE_DETECTOR_ERROR;
+
+    writer.begin(buffer, size, SFE_XM125_PACKET_TYPE_PRESENCE);
+    writer.putVarint(frame.measure_counter);
+    writer.putVarint(timestampMs);
+    writer.putByte(flags);
+    writer.putSigned(frame.temperature);
+    writer.putVarint(frame.distance);
+    writer.putVarint(frame.intra_score);
+    writer.putVarint(frame.inter_score);
+
+    return writer.end();
+}
@@ -0,0 +1,40 @@
+/**
+ * @file sfDevXM125PacketEncoder.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the encoder of distance and presence frames into the packed binary
+ * packet format described in sfDevXM125Packet.h.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "sfDevXM125Distance.h"
+#include "sfDevXM125Presence.h"
+#include "sfDevXM125Packet.h"
+
+class sfDevXM125PacketEncoder
+{
+  public:
+    /// @brief Encodes a distance frame into a packet
+    /// @param frame Frame read with sfDevXM125Distance::readFrame()
+    /// @param buffer Buffer for the packet - SFE_XM125_PACKET_DISTANCE_MAX_PACKET bytes always suffice
+    /// @param size Size of the buffer
+    /// @return Size of the packet in bytes, 0 if it did not fit in the buffer
+    static size_t encode(const sfe_xm125_distance_frame_t &frame, uint8_t *buffer, size_t size);
+
+    /// @brief Encodes a presence frame into a packet
+    /// @param frame Frame read with sfDevXM125Presence::readStream()
+    /// @param timestampMs Host time of the read in ms
+    /// @param buffer Buffer for the packet - SFE_XM125_PACKET_PRESENCE_MAX_PACKET bytes always suffice
+    /// @param size Size of the buffer
+    /// @return Size of the packet in bytes, 0 if it did not fit in the buffer
+    static size_t encode(const sfe_xm125_presence_frame_t &frame, uint32_t timestampMs, uint8_t *buffer,
+                         size_t size);
+};
@@ -0,0 +1,227 @@
+/**
+ * @file sfDevXM125PeakTracker.cpp
+ * @brief Implementation of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the implementation of the distance peak tracker.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "sfDevXM125PeakTracker.h"
+
+// Filtered position in um to a reported distance in mm
+static uint16_t positionToMm(int32_t positionUm)
+{
+    int32_t distanceMm = (positionUm + 500) / 1000;
+
+    return distanceMm > UINT16_MAX ? UINT16_MAX : (uint16_t)distanceMm;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125PeakTracker::setGains(uint16_t alpha, uint16_t beta)
+{
+    _alpha = alpha == 0 ? 1 : alpha > 1000 ? 1000 : alpha;
+    _beta = beta > 1000 ? 1000 : beta;
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125PeakTracker::findTrack(uint16_t id, sfe_xm125_track_t &track)
+{
+    for (uint8_t i = 0; i < _numTracks; i++)
+    {
+        if (_tracks[i].track.id == id)
+        {
+            track = _tracks[i].track;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------------
+uint8_t sfDevXM125PeakTracker::numConfirmed(void)
+{
+    uint8_t confirmed = 0;
+
+    for (uint8_t i = 0; i < _numTracks; i++)
+        confirmed += _tracks[i].track.confirmed ? 1 : 0;
+
+    return confirmed;
+}
+
+//--------------------------------------------------------------------------------
+uint8_t sfDevXM125PeakTracker::update(const uint16_t *distance, const int16_t *strength, uint8_t numPeaks,
+                                      uint32_t timeMs)
+{
+    if (numPeaks > SFE_XM125_TRACKER_MAX_PEAKS)
+        numPeaks = SFE_XM125_TRACKER_MAX_PEAKS;
+
+    uint32_t dtMs = _started ? timeMs - _lastMs : 0;
+    if (dtMs > SFE_XM125_TRACKER_MAX_DT_MS)
+        dtMs = SFE_XM125_TRACKER_MAX_DT_MS;
+
+    _lastMs = timeMs;
+    _started = true;
+
+    // Predict where each track is now
+    for (uint8_t i = 0; i < _numTracks; i++)
+    {
+        _tracks[i].positionUm += _tracks[i].velocity * (int32_t)dtMs;
+        if (_tracks[i].positionUm < 0)
+            _tracks[i].positionUm = 0;
+    }
+
+    int8_t peakTrack[SFE_XM125_TRACKER_MAX_PEAKS];
+    bool trackHit[SFE_XM125_TRACKER_MAX_TRACKS];
+
+    for (uint8_t i = 0; i < SFE_XM125_TRACKER_MAX_PEAKS; i++)
+        peakTrack[i] = -1;
+    for (uint8_t i = 0; i < SFE_XM125_TRACKER_MAX_TRACKS; i++)
+        trackHit[i] = false;
+
+    // Confirmed tracks pick their peaks first, so a new track can not take over a target
+    associate(distance, numPeaks, true, peakTrack, trackHit);
+    associate(distance, numPeaks, false, peakTrack, trackHit);
+
+    for (uint8_t i = 0; i < numPeaks; i++)
+    {
+        if (peakTrack[i] >= 0)
+            correct(_tracks[peakTrack[i]], distance[i], strength[i], dtMs);
+    }
+
+    uint8_t confirmed = 0;
+
+    // Age the tracks and drop the lost ones - the last track takes the place of a dropped one
+    uint8_t i = 0;
+    while (i < _numTracks)
+    {
+        sfe_xm125_track_t &track = _tracks[i].track;
+
+        if (track.age < UINT16_MAX)
+            track.age++;
+
+        if (!trackHit[i])
+        {
+            if (track.misses < UINT8_MAX)
+                track.misses++;
+
+            if (!track.confirmed || track.misses > _maxMisses)
+            {
+                _numTracks--;
+                _tracks[i] = _tracks[_numTracks];
+                trackHit[i] = trackHit[_numTracks];
+                continue;
+            }
+
+            // A coasting track reports its predicted distance
+            track.distance = positionToMm(_tracks[i].positionUm);
+        }
+
+        confirmed += track.confirmed ? 1 : 0;
+        i++;
+    }
+
+    // Start a track for each peak left over
+    for (uint8_t p = 0; p < numPeaks; p++)
+    {
+        if (peakTrack[p] >= 0 || _numTracks >= SFE_XM125_TRACKER_MAX_TRACKS)
+            continue;
+
+        track_state_t &state = _tracks[_numTracks++];
+        state.positionUm = (int32_t)distance[p] * 1000;
+        state.velocity = 0;
+
+        state.track.id = _nextId;
+        state.track.distance = distance[p];
+        state.track.velocity = 0;
+        state.track.strength = strength[p];
+        state.track.age = 1;
+        state.track.hits = 1;
+        state.track.misses = 0;
+        state.track.confirmed = _confirmHits <= 1;
+
+        // IDs are never 0
+        if (++_nextId == 0)
+            _nextId = 1;
+
+        confirmed += state.track.confirmed ? 1 : 0;
+    }
+
+    return confirmed;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125PeakTracker::associate(const uint16_t *distance, uint8_t numPeaks, bool confirmed, int8_t *peakTrack,
+                                      bool *trackHit)
+{
+    uint32_t gateUm = (uint32_t)_gateMm * 1000;
+
+    // Greedy nearest neighbour - take the closest free pair within the gate until none is left
+    for (;;)
+    {
+        uint32_t best = UINT32_MAX;
+        int8_t bestTrack = -1;
+        int8_t bestPeak = -1;
+
+        for (uint8_t t = 0; t < _numTracks; t++)
+        {
+            if (trackHit[t] || _tracks[t].track.confirmed != confirmed)
+                continue;
+
+            for (uint8_t p = 0; p < numPeaks; p++)
+            {
+                if (peakTrack[p] >= 0)
+                    continue;
+
+                int32_t residual = (int32_t)distance[p] * 1000 - _tracks[t].positionUm;
+                uint32_t gap = residual < 0 ? (uint32_t)-residual : (uint32_t)residual;
+
+                if (gap <= gateUm && gap < best)
+                {
+                    best = gap;
+                    bestTrack = (int8_t)t;
+                    bestPeak = (int8_t)p;
+                }
+            }
+        }
+
+        if (bestTrack < 0)
+            return;
+
+        peakTrack[bestPeak] = bestTrack;
+        trackHit[bestTrack] = true;
+    }
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125PeakTracker::correct(track_state_t &state, uint16_t distance, int16_t strength, uint32_t dtMs)
+{
+    int32_t residual = (int32_t)distance * 1000 - state.positionUm;
+
+    // Alpha-beta update - um, and um per ms for the velocity
+    state.positionUm += (int32_t)((int64_t)residual * _alpha / 1000);
+    if (state.positionUm < 0)
+        state.positionUm = 0;
+
+    if (dtMs > 0)
+    {
+        state.velocity += (int32_t)((int64_t)residual * _beta / ((int64_t)dtMs * 1000));
+        if (state.velocity > SFE_XM125_TRACKER_MAX_VELOCITY)
+            state.velocity = SFE_XM125_TRACKER_MAX_VELOCITY;
+        else if (state.velocity < -SFE_XM125_TRACKER_MAX_VELOCITY)
+            state.velocity = -SFE_XM125_TRACKER_MAX_VELOCITY;
+    }
+
+    state.track.distance = positionToMm(state.positionUm);
+    state.track.velocity = (int16_t)state.velocity;
+    state.track.strength = strength;
+    state.track.misses = 0;
+    if (state.track.hits < UINT8_MAX)
+        state.track.hits++;
+    if (state.track.hits >= _confirmHits)
+        state.track.confirmed = true;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file sfDevXM125PeakTracker.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the header of the distance peak tracker. The distance detector reports up to
+ * ten peaks per frame with no identity from one frame to the next. The tracker associates the peaks
+ * of each frame with a fixed set of tracks, smooths their distance with an alpha-beta filter and
+ * estimates their radial velocity. Each track keeps its ID for as long as it lives.
+ *
+ * A peak starts a tentative track, which is confirmed after a few associated frames. A tentative
+ * track is dropped on its first missed frame, a confirmed one after several missed frames in a row -
+ * until then it coasts on its velocity. All memory is part of the object; integer math only.
+ *
+ *     radarSensor.readFrame(frame);
+ *     tracker.update(frame);
+ *     for (uint8_t i = 0; i < tracker.numTracks(); i++)
+ *         if (tracker.track(i).confirmed)
+ *             ...
+ *
+ * Like the packet format, the tracker does not depend on the toolkit or on Arduino, so recorded
+ * frames can be replayed through it on a host (see tools/xm125_track).
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "sfDevXM125DistanceFlags.h"
+
+// Peaks of a frame, and tracks held at once - one per peak
+const uint8_t SFE_XM125_TRACKER_MAX_PEAKS = 10;
+const uint8_t SFE_XM125_TRACKER_MAX_TRACKS = SFE_XM125_TRACKER_MAX_PEAKS;
+
+// Frame flags of frames without valid peaks - the packet format carries the same flags
+const uint8_t SFE_XM125_TRACKER_SKIP_FLAGS =
+    SFE_XM125_DISTANCE_FRAME_CALIBRATION_NEEDED | SFE_XM125_DISTANCE_FRAME_MEASURE_ERROR;
+
+// Default filter gains in 1/1000 - a critically damped filter, beta = alpha^2 / (2 - alpha)
+const uint16_t SFE_XM125_TRACKER_ALPHA_DEFAULT = 500;
+const uint16_t SFE_XM125_TRACKER_BETA_DEFAULT = 167;
+
+// Default largest distance between the predicted distance of a track and a peak, in mm
+const uint16_t SFE_XM125_TRACKER_GATE_DEFAULT = 300;
+
+// Default associated frames that confirm a track, and missed frames in a row that drop it
+const uint8_t SFE_XM125_TRACKER_CONFIRM_DEFAULT = 3;
+const uint8_t SFE_XM125_TRACKER_MISSES_DEFAULT = 5;
+
+// Largest radial velocity of a track in mm/s, and largest time between frames used to predict in ms
+const int32_t SFE_XM125_TRACKER_MAX_VELOCITY = 20000;
+const uint32_t SFE_XM125_TRACKER_MAX_DT_MS = 10000;
+
+// A tracked target
+typedef struct
+{
+    uint16_t id;       // track ID, stable over the life of the track - never 0
+    uint16_t distance; // smoothed distance in mm
+    int16_t velocity;  // radial velocity in mm/s - positive when moving away
+    int16_t strength;  // strength of the last associated peak in 0.01 dB
+    uint16_t age;      // frames since the track started
+    uint8_t hits;      // frames a peak was associated with the track
+    uint8_t misses;    // frames in a row without a peak
+    bool confirmed;    // the track has been seen in enough frames to be reported
+} sfe_xm125_track_t;
+
+class sfDevXM125PeakTracker
+{
+  public:
+    sfDevXM125PeakTracker()
+        : _alpha{SFE_XM125_TRACKER_ALPHA_DEFAULT}, _beta{SFE_XM125_TRACKER_BETA_DEFAULT},
+          _gateMm{SFE_XM125_TRACKER_GATE_DEFAULT}, _confirmHits{SFE_XM125_TRACKER_CONFIRM_DEFAULT},
+          _maxMisses{SFE_XM125_TRACKER_MISSES_DEFAULT}, _numTracks{0}, _nextId{1}, _lastMs{0}, _started{false} {};
+
+    /// @brief Sets the filter gains. A larger alpha follows the measured distance more closely, a
+    ///  larger beta lets the velocity change faster - both smooth less.
+    /// @param alpha Distance gain in 1/1000, 1 - 1000
+    /// @param beta Velocity gain in 1/1000, 0 - 1000
+    void setGains(uint16_t alpha, uint16_t beta);
+
+    /// @brief Sets the largest distance between the predicted distance of a track and a peak that
+    ///  are associated
+    /// @param gateMm Distance in mm
+    void setGate(uint16_t gateMm)
+    {
+        _gateMm = gateMm;
+    }
+
+    /// @brief Sets how many frames confirm a track, and how many missed frames in a row drop it
+    /// @param confirmHits Associated frames that confirm a track - 1 confirms it right away
+    /// @param maxMisses Missed frames in a row a confirmed track survives
+    void setLifetime(uint8_t confirmHits, uint8_t maxMisses)
+    {
+        _confirmHits = confirmHits == 0 ? 1 : confirmHits;
+        _maxMisses = maxMisses;
+    }
+
+    /// @brief Drops all tracks. The IDs of new tracks keep counting.
+    void reset(void)
+    {
+        _numTracks = 0;
+        _started = false;
+    }
+
+    /// @brief Updates the tracks with the peaks of a frame. Frames with a measure error or that need
+    ///  a recalibration hold no valid peaks and are skipped.
+    /// @param frame Frame from readFrame(), or a decoded sfe_xm125_packet_frame_t - its timestamp is
+    ///  used to predict the tracks
+    /// @return Number of confirmed tracks
+    template <typename TFrame> uint8_t update(const TFrame &frame)
+    {
+        if (frame.flags & SFE_XM125_TRACKER_SKIP_FLAGS)
+            return numConfirmed();
+
+        return update(frame.distance, frame.strength, frame.num_peaks, frame.timestamp);
+    }
+
+    /// @brief Updates the tracks with the peaks of a frame
+    /// @param distance Peak distances in mm
+    /// @param strength Peak strengths in 0.01 dB
+    /// @param numPeaks Number of peaks, up to SFE_XM125_TRACKER_MAX_PEAKS are used
+    /// @param timeMs Time of the frame in ms
+    /// @return Number of confirmed tracks
+    uint8_t update(const uint16_t *distance, const int16_t *strength, uint8_t numPeaks, uint32_t timeMs);
+
+    /// @brief Returns the number of tracks, confirmed and tentative
+    uint8_t numTracks(void)
+    {
+        return _numTracks;
+    }
+
+    /// @brief Returns the number of confirmed tracks
+    uint8_t numConfirmed(void);
+
+    /// @brief Returns a track. The order changes as tracks are dropped - use the ID to follow one.
+    /// @param index Index 0 to numTracks() - 1
+    const sfe_xm125_track_t &track(uint8_t index)
+    {
+        return _tracks[index < _numTracks ? index : 0].track;
+    }
+
+    /// @brief Looks up a track by its ID
+    /// @param id Track ID
+    /// @param track Track found
+    /// @return true if the track is alive
+    bool findTrack(uint16_t id, sfe_xm125_track_t &track);
+
+  private:
+    typedef struct
+    {
+        sfe_xm125_track_t track;
+        int32_t positionUm; // filtered distance in um
+        int32_t velocity;   // filtered velocity in mm/s - um per ms
+    } track_state_t;
+
+    /// @brief Associates the unassigned peaks with the unassigned tracks of one kind, nearest pairs first
+    void associate(const uint16_t *distance, uint8_t numPeaks, bool confirmed, int8_t *peakTrack, bool *trackHit);
+
+    /// @brief Corrects a track with its associated peak
+    void correct(track_state_t &state, uint16_t distance, int16_t strength, uint32_t dtMs);
+
+    uint16_t _alpha;
+    uint16_t _beta;
+    uint16_t _gateMm;
+    uint8_t _confirmHits;
+    uint8_t _maxMisses;
+
+    track_state_t _tracks[SFE_XM125_TRACKER_MAX_TRACKS];
+    uint8_t _numTracks;
+    uint16_t _nextId;
+
+    // timestamp of the last frame
+    uint32_t _lastMs;
+    bool _started;
+};
@@ -12,6 +12,33 @@
  */
 #include "sfDevXM125Presence.h"
 
+// Bit fields of the presence detector registers
+typedef sfDevXM125PresenceFields Fields;
+
+// Detector status register layout, in setup order - the order getDetectorErrorStatus() checks the
+// errors in.
+static constexpr sfe_xm125_status_entry_t kPresenceStatusTable[] = {
+    // SFE_XM125_STATUS_RSS_REGISTER
+    {Fields::RssRegisterOk::offset, Fields::RssRegisterError::offset, 0, 1},
+    // SFE_XM125_STATUS_CONFIG_CREATE
+    {Fields::ConfigCreateOk::offset, Fields::ConfigCreateError::offset, 1, 2},
+    // SFE_XM125_STATUS_SENSOR_CREATE
+    {Fields::SensorCreateOk::offset, Fields::SensorCreateError::offset, 2, 3},
+    // SFE_XM125_STATUS_SENSOR_CALIBRATE
+    {Fields::SensorCalibrateOk::offset, Fields::SensorCalibrateError::offset, 3, 4},
+    // SFE_XM125_STATUS_DETECTOR_CREATE
+    {Fields::DetectorCreateOk::offset, Fields::DetectorCreateError::offset, 4, 5},
+    // SFE_XM125_STATUS_DETECTOR_BUFFER
+    {Fields::DetectorBufferOk::offset, Fields::DetectorBufferError::offset, 5, 6},
+    // SFE_XM125_STATUS_SENSOR_BUFFER
+    {Fields::SensorBufferOk::offset, Fields::SensorBufferError::offset, 6, 7},
+    // SFE_XM125_STATUS_CONFIG_APPLY
+    {Fields::ConfigApplyOk::offset, Fields::ConfigApplyError::offset, 8, 8},
+    // SFE_XM125_STATUS_DETECTOR
+    {SFE_XM125_STATUS_NO_BIT, Fields::DetectorRegError::offset, 10, 9},
+};
+static constexpr uint8_t kPresenceStatusTableSize = sizeof(kPresenceStatusTable) / sizeof(kPresenceStatusTable[0]);
+
 sfTkError_t sfDevXM125Presence::begin(sfTkII2C *theBus)
 {
     // call super to get the device connection working
@@ -37,16 +64,26 @@ sfTkError_t sfDevXM125Presence::detectorStart(uint32_t startValue, uint32_t endV
     // *** Presence Sensor Setup ***
     uint32_t errorStatus = 0;
 
+    // A setup leaves the detector stopped - stop it first, however it was started
+    if (_detectorStarted && stopStreaming() != ksfTkErrOk)
+        return 1;
+
+    // Nothing to set up when the module still runs this configuration
+    if (fastRestart(startValue, endValue))
+        return ksfTkErrOk;
+
     // Reset sensor configuration to reapply configuration registers
     if (setCommand(SFE_XM125_PRESENCE_RESET_MODULE) != ksfTkErrOk)
         return 1;
 
-    sftk_delay_ms(100); // give time for command to set
+    settle(); // give time for command to set
 
-    // Check detector status error and busy bits
-    if (getDetectorErrorStatus(errorStatus) != ksfTkErrOk)
+    // Wait for the reset to complete
+    if (busyWait() != ksfTkErrOk)
         return 2;
 
+    // Check detector status error and busy bits - the busy wait has just read them
+    errorStatus = busyWaitErrorStatus();
     if (errorStatus != 0)
         return 3;
 
@@ -54,13 +91,22 @@ sfTkError_t sfDevXM125Presence::detectorStart(uint32_t startValue, uint32_t endV
     if (setStart(startValue) != ksfTkErrOk)
         return 4;
 
-    sftk_delay_ms(100); // give time for command to set
+    settle(); // give time for command to set
 
     // Set End register
     if (setEnd(endValue) != ksfTkErrOk)
         return 5;
 
-    sftk_delay_ms(100); // give time for command to set
+    settle(); // give time for command to set
+
+    // Do not apply a configuration that can not reach its frame rate - the registers now hold what
+    // the module is about to apply
+    if (_timingCheck)
+    {
+        sfe_xm125_timing_t timing;
+        if (estimateTiming(timing) == ksfTkErrXM125Timing)
+            return ksfTkErrXM125Timing;
+    }
 
     // Apply configuration
     if (setCommand(SFE_XM125_PRESENCE_APPLY_CONFIGURATION) != ksfTkErrOk)
@@ -70,21 +116,57 @@ sfTkError_t sfDevXM125Presence::detectorStart(uint32_t startValue, uint32_t endV
         return errorStatus != 0 ? 6 : 7;
     }
 
-    sftk_delay_ms(100); // give time for command to set
+    settle(); // give time for command to set
 
     // Poll detector status until busy bit is cleared
     if (busyWait() != ksfTkErrOk)
         return 8;
 
-    // Check detector error status
-    sfTkError_t retVal = getDetectorErrorStatus(errorStatus);
-    if (retVal != ksfTkErrOk || errorStatus != 0)
+    // Check detector error status, as read by the busy wait
+    errorStatus = busyWaitErrorStatus();
+    if (errorStatus != 0)
         return 9;
 
+    // Keep what was applied, for the next setup
+    rememberAppliedConfig();
+
     // If no errors, return 0
     return ksfTkErrOk;
 }
 
+//--------------------------------------------------------------------------------
+bool sfDevXM125Presence::fastRestart(uint32_t startValue, uint32_t endValue)
+{
+    if (!fastRestartPossible())
+        return false;
+
+    // Same range, and no configuration register changed since the last setup applied them
+    uint32_t regVals[SFE_XM125_PRESENCE_CONFIG_REGS + 1];
+    if (readConfigRegisters(regVals) != ksfTkErrOk)
+        return false;
+
+    if (regVals[SFE_XM125_PRESENCE_START - SFE_XM125_PRESENCE_SWEEPS_PER_FRAME] != startValue ||
+        regVals[SFE_XM125_PRESENCE_END - SFE_XM125_PRESENCE_SWEEPS_PER_FRAME] != endValue ||
+        !appliedConfigMatches(regVals))
+        return false;
+
+    // The module must still run it - applied, without errors. A module that was reset or power
+    // cycled since has not applied any configuration.
+    sfDevXM125Status status;
+    if (getStatus(status) != ksfTkErrOk)
+        return false;
+
+    // Let a command still running finish first
+    if (status.busy())
+    {
+        if (busyWait() != ksfTkErrOk)
+            return false;
+        decodeStatus(_lastStatus, status);
+    }
+
+    return !status.hasError() && status.completed(SFE_XM125_STATUS_CONFIG_APPLY);
+}
+
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getDistanceValuemm(uint32_t &presenceVal)
 {
@@ -100,15 +182,14 @@ sfTkError_t sfDevXM125Presence::getDistanceValuemm(uint32_t &presenceVal)
     if (setCommand(SFE_XM125_PRESENCE_START_DETECTOR) != ksfTkErrOk)
         return ksfTkErrFail;
 
-    sftk_delay_ms(100);
+    settle();
 
     // Poll detector status until busy bit is cleared
     if (busyWait() != ksfTkErrOk)
         return ksfTkErrFail;
 
-    // Verify that no error bits are set in the detector status register
-    retVal = getDetectorErrorStatus(errorStatus);
-    if (retVal != ksfTkErrOk || errorStatus != 0)
+    // Verify that no error bits are set in the detector status register read by the busy wait
+    if (busyWaitErrorStatus() != 0)
         return ksfTkErrFail;
 
     // Read from 16-Bit Register to get the presence detection status
@@ -116,8 +197,7 @@ sfTkError_t sfDevXM125Presence::getDistanceValuemm(uint32_t &presenceVal)
         return ksfTkErrFail;
 
     // Presence detected NOW or since last check (sticky)
-    bool bPresenceDetected = ((presenceStatus & SFE_XM125_PRESENCE_DETECTED_MASK) != 0) ||
-                             ((presenceStatus & SFE_XM125_PRESENCE_DETECTED_STICKY_MASK) != 0);
+    bool bPresenceDetected = Fields::Detected::get(presenceStatus) || Fields::DetectedSticky::get(presenceStatus);
 
     // If presence or a sticky presence is detected, get the distance and return
     if (bPresenceDetected)
@@ -128,20 +208,205 @@ sfTkError_t sfDevXM125Presence::getDistanceValuemm(uint32_t &presenceVal)
     return ksfTkErrOk;
 }
 
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::startStreaming()
+{
+    uint32_t errorStatus = 0;
+
+    sfTkError_t retVal = getDetectorErrorStatus(errorStatus);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    if (errorStatus != 0)
+        return ksfTkErrFail;
+
+    // Frames are reported as the measure counter advances - start from the current count
+    retVal = getMeasureCounter(_lastMeasureCounter);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    retVal = start();
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    retVal = busyWait();
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    _streaming = true;
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::stopStreaming()
+{
+    _streaming = false;
+
+    sfTkError_t retVal = stop();
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    return busyWait();
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::readStream(sfe_xm125_presence_frame_t &frame, bool &newFrame)
+{
+    newFrame = false;
+
+    if (!_streaming)
+        return ksfTkErrFail;
+
+    uint32_t counter = 0;
+    sfTkError_t retVal = getMeasureCounter(counter);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    // No new frame - nothing else to read
+    if (counter == _lastMeasureCounter)
+        return ksfTkErrOk;
+
+    retVal = readFrame(frame);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    _lastMeasureCounter = counter;
+    frame.measure_counter = counter;
+
+    newFrame = true;
+
+    return frame.detector_error ? ksfTkErrFail : ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::pollFrame(sfe_xm125_presence_poll_t &poll)
+{
+    poll.ready = false;
+
+    // The measure counter and detector status registers are adjacent - one read
+    uint32_t regVals[2];
+    sfTkError_t retVal = readRegisterBlock(SFE_XM125_PRESENCE_MEASURE_COUNTER, regVals, 2);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    sfDevXM125Status status;
+    decodeStatus(regVals[1], status);
+
+    poll.status = regVals[1];
+    poll.status_errors = status.errorFlags();
+    poll.busy = status.busy();
+
+    if (status.hasError())
+        return ksfTkErrXM125Detector;
+
+    // Still busy, or no frame since the last ready one - nothing else to read
+    if (poll.busy || regVals[0] == poll.frame.measure_counter)
+        return ksfTkErrOk;
+
+    retVal = readFrame(poll.frame);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    poll.frame.measure_counter = regVals[0];
+    poll.ready = true;
+
+    return poll.frame.detector_error ? ksfTkErrXM125Detector : ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::readFrame(sfe_xm125_presence_frame_t &frame)
+{
+    // Result, distance, intra and inter score registers are contiguous
+    uint32_t regVals[4];
+    sfTkError_t retVal = readRegisterBlock(SFE_XM125_PRESENCE_RESULT, regVals, 4);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    frame.measure_counter = 0;
+    frame.detected = Fields::Detected::get(regVals[0]);
+    frame.detected_sticky = Fields::DetectedSticky::get(regVals[0]);
+    frame.detector_error = Fields::DetectorError::get(regVals[0]);
+    frame.temperature = Fields::Temperature::get(regVals[0]);
+    frame.distance = regVals[1];
+    frame.intra_score = regVals[2];
+    frame.inter_score = regVals[3];
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::enableGPIOEvents(sfe_xm125_presence_event_cb_t callback, void *user)
+{
+    _eventCallback = callback;
+    _eventUser = user;
+    _eventPending = false;
+
+    // The GPIO setting is used when the detector starts
+    sfTkError_t retVal = stopStreaming();
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    retVal = setDetectionOnGPIO(1);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    retVal = startStreaming();
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    // Report the current state once, edges report the changes
+    _eventPending = true;
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::disableGPIOEvents()
+{
+    _eventCallback = nullptr;
+    _eventPending = false;
+
+    sfTkError_t retVal = stopStreaming();
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    return setDetectionOnGPIO(0);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::serviceEvents()
+{
+    if (!_eventPending)
+        return ksfTkErrOk;
+
+    // Clear first - an edge during the read is serviced on the next call
+    _eventPending = false;
+
+    sfe_xm125_presence_frame_t frame;
+    sfTkError_t retVal = readFrame(frame);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    if (_eventCallback != nullptr)
+        _eventCallback(frame, _eventUser);
+
+    return frame.detector_error ? ksfTkErrFail : ksfTkErrOk;
+}
+
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getDetectorVersion(uint32_t &major, uint32_t &minor, uint32_t &patch)
 {
     sfTkError_t retVal;
     uint32_t regVal = 0;
 
-    // Read from 16-Bit Register
-    size_t readBytes = 0;
-    retVal = _theBus->readRegister(SFE_XM125_PRESENCE_VERSION, (uint8_t *)&regVal, sizeof(regVal), readBytes);
+    // Read from the Register
+    retVal = _theBus->readRegister(SFE_XM125_PRESENCE_VERSION, regVal);
 
     // Mask unused bits from register
-    major = (regVal & SFE_XM125_PRESENCE_MAJOR_VERSION_MASK) >> SFE_XM125_PRESENCE_MAJOR_VERSION_MASK_SHIFT;
-    minor = (regVal & SFE_XM125_PRESENCE_MINOR_VERSION_MASK) >> SFE_XM125_PRESENCE_MINOR_VERSION_MASK_SHIFT;
-    patch = regVal & SFE_XM125_PRESENCE_PATCH_VERSION_MASK;
+    major = Fields::MajorVersion::get(regVal);
+    minor = Fields::MinorVersion::get(regVal);
+    patch = Fields::PatchVersion::get(regVal);
 
     return retVal;
 }
@@ -163,100 +428,68 @@ sfTkError_t sfDevXM125Presence::getDetectorStatus(uint32_t &status)
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getDetectorErrorStatus(uint32_t &status)
 {
-    sfTkError_t retVal = 0;
     uint32_t regVal = 0;
-    retVal = _theBus->readRegister(SFE_XM125_PRESENCE_DETECTOR_STATUS, regVal);
+    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_PRESENCE_DETECTOR_STATUS, regVal);
 
     // clear out status
     status = 0;
 
     if (retVal != ksfTkErrOk)
         return retVal;
-    // Any errors - if not, skip the  big bit check pachinko if-else  below
-    if ((regVal & SFE_XM125_PRESENCE_ALL_ERROR_MASK) == 0)
-        return ksfTkErrOk;
-
-    // Check for errors
-    if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_PRESENCE_RSS_REGISTER_ERROR_MASK))
-        status = 1;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_PRESENCE_CONFIG_CREATE_ERROR_MASK))
-        status = 2;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_PRESENCE_SENSOR_CREATE_ERROR_MASK))
-        status = 3;
 
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_PRESENCE_SENSOR_CALIBRATE_ERROR_MASK))
-        status = 4;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_PRESENCE_DETECTOR_CREATE_ERROR_MASK))
-        status = 5;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_PRESENCE_DETECTOR_BUFFER_ERROR_MASK))
-        status = 6;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_PRESENCE_SENSOR_BUFFER_ERROR_MASK))
-        status = 7;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_PRESENCE_CONFIG_APPLY_ERROR_MASK))
-        status = 8;
-
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_PRESENCE_DETECTOR_REG_ERROR_MASK))
-        status = 9;
+    status = statusErrorCode(regVal, kPresenceStatusTable, kPresenceStatusTableSize, Fields::Busy::mask,
+                             SFE_XM125_PRESENCE_BUSY_ERROR_CODE);
+    return ksfTkErrOk;
+}
 
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_PRESENCE_DETECTOR_ERROR_MASK))
-        status = 10;
+//--------------------------------------------------------------------------------
+uint32_t sfDevXM125Presence::busyWaitErrorStatus(void)
+{
+    return statusErrorCode(_lastStatus, kPresenceStatusTable, kPresenceStatusTableSize, Fields::Busy::mask,
+                           SFE_XM125_PRESENCE_BUSY_ERROR_CODE);
+}
 
-    else if (SFTK_CHECK_BITS_SET(regVal, SFE_XM125_PRESENCE_BUSY_MASK))
-        status = 11;
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::getStatus(sfDevXM125Status &status)
+{
+    uint32_t regVal = 0;
+    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_PRESENCE_DETECTOR_STATUS, regVal);
+    if (retVal != ksfTkErrOk)
+        return retVal;
 
-    // return 0 with no errors
+    decodeStatus(regVal, status);
     return ksfTkErrOk;
 }
 
 //--------------------------------------------------------------------------------
-sfTkError_t sfDevXM125Presence::getDetectorPresenceDetected(uint32_t &detected)
+void sfDevXM125Presence::decodeStatus(uint32_t regVal, sfDevXM125Status &status)
 {
-    // Read from 16-Bit Register
-    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_PRESENCE_RESULT, detected);
-
-    // Mask unused bits from register
-    if (retVal == ksfTkErrOk)
-        detected = (detected & SFE_XM125_PRESENCE_DETECTED_MASK);
+    status.decode(regVal, kPresenceStatusTable, kPresenceStatusTableSize, Fields::Busy::mask);
+}
 
-    return retVal;
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::getDetectorPresenceDetected(uint32_t &detected)
+{
+    return readField<Fields::Detected>(detected);
 }
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getDetectorPresenceStickyDetected(uint32_t &sticky)
 {
-
-    // Read from 16-Bit Register
-    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_PRESENCE_RESULT, sticky);
-
-    // Mask unused bits from register
-    if (retVal == ksfTkErrOk)
-        sticky = (sticky & SFE_XM125_PRESENCE_DETECTED_STICKY_MASK) >> 1;
-
-    return retVal;
+    return readField<Fields::DetectedSticky>(sticky);
 }
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getDetectorRegError(uint32_t &error)
 {
-    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_PRESENCE_RESULT, error);
-
-    // Mask unused bits from register
-    if (retVal == ksfTkErrOk)
-        error = (error & SFE_XM125_PRESENCE_DETECTOR_ERROR_MASK) >> SFE_XM125_PRESENCE_DETECTOR_ERROR_MASK_SHIFT;
-
-    return retVal;
+    return readField<Fields::DetectorError>(error);
 }
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getTemperature(uint32_t &temp)
 {
-    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_PRESENCE_DISTANCE, temp);
-
-    // Mask unused bits from register
-    temp = (temp & SFE_XM125_PRESENCE_TEMPERATURE_MASK) >> SFE_XM125_PRESENCE_TEMPERATURE_MASK_SHIFT;
+    // The raw 16 bits of the temperature field of the result register
+    int16_t temperature = 0;
+    sfTkError_t retVal = readField<Fields::Temperature>(temperature);
+    if (retVal == ksfTkErrOk)
+        temp = static_cast<uint16_t>(temperature);
 
     return retVal;
 }
@@ -278,33 +511,31 @@ sfTkError_t sfDevXM125Presence::getInterPresenceScore(uint32_t &inter)
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getSweepsPerFrame(uint32_t &sweeps)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_SWEEPS_PER_FRAME, sweeps);
+    return readConfigRegister(SFE_XM125_PRESENCE_SWEEPS_PER_FRAME, sweeps);
 }
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setSweepsPerFrame(uint32_t sweeps)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_SWEEPS_PER_FRAME, sweeps);
+    return writeConfigRegister(SFE_XM125_PRESENCE_SWEEPS_PER_FRAME, sweeps);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getInterFramePresenceTimeout(uint32_t &time)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_INTER_FRAME_TIMEOUT, time);
+    return readConfigRegister(SFE_XM125_PRESENCE_INTER_FRAME_TIMEOUT, time);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setInterFramePresenceTimeout(uint32_t time)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_INTER_FRAME_TIMEOUT, time);
+    return writeConfigRegister(SFE_XM125_PRESENCE_INTER_FRAME_TIMEOUT, time);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getInterPhaseBoostEnabled(bool &en)
 {
-    size_t readBytes = 0;
     uint8_t value;
-    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_PRESENCE_INTER_PHASE_BOOST_ENABLED, (uint8_t *)&value,
-                                               sizeof(uint8_t), readBytes);
+    sfTkError_t retVal = readConfigRegisterUInt8(SFE_XM125_PRESENCE_INTER_PHASE_BOOST_ENABLED, value);
     en = (value != 0);
     return retVal;
 }
@@ -313,14 +544,14 @@ sfTkError_t sfDevXM125Presence::getInterPhaseBoostEnabled(bool &en)
 sfTkError_t sfDevXM125Presence::setInterPhaseBoostEnabled(bool en)
 {
     uint8_t value = en ? 1 : 0;
-    return _theBus->writeRegisterUInt8(SFE_XM125_PRESENCE_INTER_PHASE_BOOST_ENABLED, value);
+    return writeConfigRegisterUInt8(SFE_XM125_PRESENCE_INTER_PHASE_BOOST_ENABLED, value);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getIntraDetectionEnabled(bool &en)
 {
     uint8_t value;
-    sfTkError_t retVal = _theBus->readRegisterUInt8(SFE_XM125_PRESENCE_INTRA_DETECTION_ENABLED, value);
+    sfTkError_t retVal = readConfigRegisterUInt8(SFE_XM125_PRESENCE_INTRA_DETECTION_ENABLED, value);
 
     en = (value != 0);
     return retVal;
@@ -330,124 +561,122 @@ sfTkError_t sfDevXM125Presence::getIntraDetectionEnabled(bool &en)
 sfTkError_t sfDevXM125Presence::setInterDetectionEnabled(bool en)
 {
     uint8_t value = en ? 1 : 0;
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_INTRA_DETECTION_ENABLED, (uint8_t *)&value, sizeof(uint8_t));
+    return writeConfigRegisterUInt8(SFE_XM125_PRESENCE_INTRA_DETECTION_ENABLED, value);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getFrameRate(uint32_t &rate)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_FRAME_RATE, rate);
+    return readConfigRegister(SFE_XM125_PRESENCE_FRAME_RATE, rate);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setFrameRate(uint32_t rate)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_FRAME_RATE, rate);
+    return writeConfigRegister(SFE_XM125_PRESENCE_FRAME_RATE, rate);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getIntraDetectionThreshold(uint32_t &thresh)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_INTRA_DETECTION_THRESHOLD, thresh);
+    return readConfigRegister(SFE_XM125_PRESENCE_INTRA_DETECTION_THRESHOLD, thresh);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setIntraDetectionThreshold(uint32_t thresh)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_INTRA_DETECTION_THRESHOLD, thresh);
+    return writeConfigRegister(SFE_XM125_PRESENCE_INTRA_DETECTION_THRESHOLD, thresh);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getInterDetectionThreshold(uint32_t &thresh)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_INTER_DETECTION_THRESHOLD, thresh);
+    return readConfigRegister(SFE_XM125_PRESENCE_INTER_DETECTION_THRESHOLD, thresh);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setInterDetectionThreshold(uint32_t thresh)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_INTER_DETECTION_THRESHOLD, thresh);
+    return writeConfigRegister(SFE_XM125_PRESENCE_INTER_DETECTION_THRESHOLD, thresh);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getInterFrameDeviationTime(uint32_t &time)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_INTER_FRAME_DEVIATION, time);
+    return readConfigRegister(SFE_XM125_PRESENCE_INTER_FRAME_DEVIATION, time);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setInterFrameDeviationTime(uint32_t time)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_INTER_FRAME_DEVIATION, time);
+    return writeConfigRegister(SFE_XM125_PRESENCE_INTER_FRAME_DEVIATION, time);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getInterFrameFastCutoff(uint32_t &cut)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_INTER_FRAME_FAST_CUTOFF, cut);
+    return readConfigRegister(SFE_XM125_PRESENCE_INTER_FRAME_FAST_CUTOFF, cut);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setInterFrameFastCutoff(uint32_t cut)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_INTER_FRAME_FAST_CUTOFF, cut);
+    return writeConfigRegister(SFE_XM125_PRESENCE_INTER_FRAME_FAST_CUTOFF, cut);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getInterFrameSlowCutoff(uint32_t &cut)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_INTER_FRAME_SLOW_CUTOFF, cut);
+    return readConfigRegister(SFE_XM125_PRESENCE_INTER_FRAME_SLOW_CUTOFF, cut);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setInterFrameSlowCutoff(uint32_t cut)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_INTER_FRAME_SLOW_CUTOFF, cut);
+    return writeConfigRegister(SFE_XM125_PRESENCE_INTER_FRAME_SLOW_CUTOFF, cut);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getIntraFrameTimeConst(uint32_t &time)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_INTRA_FRAME_TIME_CONST, time);
+    return readConfigRegister(SFE_XM125_PRESENCE_INTRA_FRAME_TIME_CONST, time);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setIntraFrameTimeConst(uint32_t time)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_INTRA_FRAME_TIME_CONST, time);
+    return writeConfigRegister(SFE_XM125_PRESENCE_INTRA_FRAME_TIME_CONST, time);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getIntraOutputTimeConst(uint32_t &time)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_INTRA_OUTPUT_TIME_CONST, time);
+    return readConfigRegister(SFE_XM125_PRESENCE_INTRA_OUTPUT_TIME_CONST, time);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setIntraOutputTimeConst(uint32_t time)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_INTRA_OUTPUT_TIME_CONST, time);
+    return writeConfigRegister(SFE_XM125_PRESENCE_INTRA_OUTPUT_TIME_CONST, time);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getInterOutputTimeConst(uint32_t &time)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_INTER_OUTPUT_TIME_CONST, time);
+    return readConfigRegister(SFE_XM125_PRESENCE_INTER_OUTPUT_TIME_CONST, time);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setInterOutputTimeConst(uint32_t time)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_INTER_OUTPUT_TIME_CONST, time);
+    return writeConfigRegister(SFE_XM125_PRESENCE_INTER_OUTPUT_TIME_CONST, time);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getAutoProfileEn(bool &en)
 {
-    size_t readBytes = 0;
     uint8_t value;
-    sfTkError_t retVal =
-        _theBus->readRegister(SFE_XM125_PRESENCE_AUTO_PROFILE_ENABLED, (uint8_t *)&value, sizeof(uint8_t), readBytes);
+    sfTkError_t retVal = readConfigRegisterUInt8(SFE_XM125_PRESENCE_AUTO_PROFILE_ENABLED, value);
     en = (value != 0);
     return retVal;
 }
@@ -456,16 +685,14 @@ sfTkError_t sfDevXM125Presence::getAutoProfileEn(bool &en)
 sfTkError_t sfDevXM125Presence::setAutoProfileEn(bool en)
 {
     uint8_t value = en ? 1 : 0;
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_AUTO_PROFILE_ENABLED, (uint8_t *)&value, sizeof(uint8_t));
+    return writeConfigRegisterUInt8(SFE_XM125_PRESENCE_AUTO_PROFILE_ENABLED, value);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getAutoStepLengthEn(bool &en)
 {
-    size_t readBytes = 0;
     uint8_t value;
-    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_PRESENCE_AUTO_STEP_LENGTH_ENABLED, (uint8_t *)&value,
-                                               sizeof(uint8_t), readBytes);
+    sfTkError_t retVal = readConfigRegisterUInt8(SFE_XM125_PRESENCE_AUTO_STEP_LENGTH_ENABLED, value);
     en = (value != 0);
     return retVal;
 }
@@ -474,65 +701,62 @@ sfTkError_t sfDevXM125Presence::getAutoStepLengthEn(bool &en)
 sfTkError_t sfDevXM125Presence::setAutoStepLengthEn(bool en)
 {
     uint8_t value = en ? 1 : 0;
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_AUTO_STEP_LENGTH_ENABLED, (uint8_t *)&value, sizeof(uint8_t));
+    return writeConfigRegisterUInt8(SFE_XM125_PRESENCE_AUTO_STEP_LENGTH_ENABLED, value);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getManualProfile(uint32_t &prof)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_MANUAL_PROFILE, prof);
+    return readConfigRegister(SFE_XM125_PRESENCE_MANUAL_PROFILE, prof);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setManualProfile(uint32_t prof)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_MANUAL_PROFILE, prof);
+    return writeConfigRegister(SFE_XM125_PRESENCE_MANUAL_PROFILE, prof);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getManualStepLength(uint32_t &length)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_MANUAL_STEP_LENGTH, length);
+    return readConfigRegister(SFE_XM125_PRESENCE_MANUAL_STEP_LENGTH, length);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setManualStepLength(uint32_t length)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_MANUAL_STEP_LENGTH, length);
+    return writeConfigRegister(SFE_XM125_PRESENCE_MANUAL_STEP_LENGTH, length);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getStart(uint32_t &start)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_START, start);
+    return readConfigRegister(SFE_XM125_PRESENCE_START, start);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setStart(uint32_t start)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_START, start);
+    return writeConfigRegister(SFE_XM125_PRESENCE_START, start);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getEnd(uint32_t &end)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_END, end);
+    return readConfigRegister(SFE_XM125_PRESENCE_END, end);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setEnd(uint32_t end)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_END, end);
+    return writeConfigRegister(SFE_XM125_PRESENCE_END, end);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getResetFilters(bool &reset)
 {
-
-    size_t readBytes = 0;
     uint8_t value;
-    sfTkError_t retVal =
-        _theBus->readRegister(SFE_XM125_PRESENCE_RESET_FILTERS_ON_PREPARE, &value, sizeof(uint8_t), readBytes);
+    sfTkError_t retVal = readConfigRegisterUInt8(SFE_XM125_PRESENCE_RESET_FILTERS_ON_PREPARE, value);
     reset = (value != 0);
     return retVal;
 }
@@ -541,36 +765,225 @@ sfTkError_t sfDevXM125Presence::getResetFilters(bool &reset)
 sfTkError_t sfDevXM125Presence::setResetFilters(bool reset)
 {
     uint8_t value = reset ? 1 : 0;
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_RESET_FILTERS_ON_PREPARE, &value, sizeof(uint8_t));
+    return writeConfigRegisterUInt8(SFE_XM125_PRESENCE_RESET_FILTERS_ON_PREPARE, value);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getHWAAS(uint32_t &avg)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_HWAAS, avg);
+    return readConfigRegister(SFE_XM125_PRESENCE_HWAAS, avg);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setHWAAS(uint32_t avg)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_HWAAS, avg);
+    return writeConfigRegister(SFE_XM125_PRESENCE_HWAAS, avg);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::getDetectionOnGPIO(uint32_t &detected)
 {
-    return _theBus->readRegister(SFE_XM125_PRESENCE_DETECTION_ON_GPIO, detected);
+    return readConfigRegister(SFE_XM125_PRESENCE_DETECTION_ON_GPIO, detected);
 }
 
 //--------------------------------------------------------------------------------
 sfTkError_t sfDevXM125Presence::setDetectionOnGPIO(uint32_t detected)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_DETECTION_ON_GPIO, detected);
+    return writeConfigRegister(SFE_XM125_PRESENCE_DETECTION_ON_GPIO, detected);
 }
 
 sfTkError_t sfDevXM125Presence::setCommand(uint32_t cmd)
 {
-    return _theBus->writeRegister(SFE_XM125_PRESENCE_COMMAND, cmd);
+    // Flush any cached configuration changes before the device uses them
+    if (cmd == SFE_XM125_PRESENCE_APPLY_CONFIGURATION || cmd == SFE_XM125_PRESENCE_START_DETECTOR)
+    {
+        sfTkError_t retVal = commit();
+        if (retVal != ksfTkErrOk)
+            return retVal;
+    }
+
+    // A reset or an apply replaces the applied configuration - the next setup runs in full
+    if (cmd == SFE_XM125_PRESENCE_RESET_MODULE || cmd == SFE_XM125_PRESENCE_APPLY_CONFIGURATION)
+        forgetAppliedConfig();
+
+    sfTkError_t retVal = _theBus->writeRegister(SFE_XM125_PRESENCE_COMMAND, cmd);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    // The detector runs from a start until a stop or a module reset
+    if (cmd == SFE_XM125_PRESENCE_START_DETECTOR)
+        _detectorStarted = true;
+    else if (cmd == SFE_XM125_PRESENCE_STOP_DETECTOR || cmd == SFE_XM125_PRESENCE_RESET_MODULE)
+        _detectorStarted = false;
+
+    // A module reset returns the configuration to its defaults - cached values are no longer known
+    if (cmd == SFE_XM125_PRESENCE_RESET_MODULE)
+        invalidateShadowCache();
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Presence::getDefaultConfig(sfe_xm125_presence_config_t &config)
+{
+    config.sweeps_per_frame = sfe_xm125_presence_sweeps_per_frame_default;
+    config.inter_frame_timeout = sfe_xm125_presence_inter_frame_timeout_default;
+    config.inter_phase_boost = sfe_xm125_presence_inter_phase_boost_enabled_default;
+    config.intra_detection = sfe_xm125_presence_intra_detection_enabled_default;
+    config.inter_detection = sfe_xm125_presence_inter_detection_enabled_default;
+    config.frame_rate = sfe_xm125_presence_frame_rate_default;
+    config.intra_detection_threshold = sfe_xm125_presence_intra_detection_threshold_default;
+    config.inter_detection_threshold = sfe_xm125_presence_inter_detection_threshold_default;
+    config.inter_frame_deviation_time = sfe_xm125_presence_inter_frame_deviation_default;
+    config.inter_frame_fast_cutoff = sfe_xm125_presence_inter_frame_fast_cutoff_default;
+    config.inter_frame_slow_cutoff = sfe_xm125_presence_inter_frame_slow_cutoff_default;
+    config.intra_frame_time_const = sfe_xm125_presence_intra_frame_time_const_default;
+    config.intra_output_time_const = sfe_xm125_presence_intra_output_time_const_default;
+    config.inter_output_time_const = sfe_xm125_presence_inter_output_time_const_default;
+    config.auto_profile = sfe_xm125_presence_auto_profile_enabled_default;
+    config.auto_step_length = sfe_xm125_presence_auto_step_length_enabled_default;
+    config.manual_profile = XM125_PRESENCE_PROFILE4;
+    config.manual_step_length = sfe_xm125_presence_manual_step_length_default;
+    config.start = sfe_xm125_presence_start_default;
+    config.end = sfe_xm125_presence_end_default;
+    config.reset_filters_on_prepare = sfe_xm125_presence_reset_filters_on_prepare_default;
+    config.hwaas = sfe_xm125_presence_hwaas_default;
+    config.detection_on_gpio = sfe_xm125_presence_detection_on_gpio_default ? 1 : 0;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::writeConfigBlock(const sfe_xm125_presence_config_t &config)
+{
+    uint32_t regVals[SFE_XM125_PRESENCE_CONFIG_REGS] = {config.sweeps_per_frame,
+                                                        config.inter_frame_timeout,
+                                                        config.inter_phase_boost ? 1u : 0u,
+                                                        config.intra_detection ? 1u : 0u,
+                                                        config.inter_detection ? 1u : 0u,
+                                                        config.frame_rate,
+                                                        config.intra_detection_threshold,
+                                                        config.inter_detection_threshold,
+                                                        config.inter_frame_deviation_time,
+                                                        config.inter_frame_fast_cutoff,
+                                                        config.inter_frame_slow_cutoff,
+                                                        config.intra_frame_time_const,
+                                                        config.intra_output_time_const,
+                                                        config.inter_output_time_const,
+                                                        config.auto_profile ? 1u : 0u,
+                                                        config.auto_step_length ? 1u : 0u,
+                                                        config.manual_profile,
+                                                        config.manual_step_length,
+                                                        config.start,
+                                                        config.end,
+                                                        config.reset_filters_on_prepare ? 1u : 0u,
+                                                        config.hwaas};
+
+    sfTkError_t retVal =
+        writeConfigRegisterBlock(SFE_XM125_PRESENCE_SWEEPS_PER_FRAME, regVals, SFE_XM125_PRESENCE_CONFIG_REGS);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    // Detection on GPIO is outside the configuration block
+    return setDetectionOnGPIO(config.detection_on_gpio);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::readConfigBlock(sfe_xm125_presence_config_t &config)
+{
+    uint32_t regVals[SFE_XM125_PRESENCE_CONFIG_REGS];
+
+    sfTkError_t retVal =
+        readRegisterBlock(SFE_XM125_PRESENCE_SWEEPS_PER_FRAME, regVals, SFE_XM125_PRESENCE_CONFIG_REGS);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    config.sweeps_per_frame = regVals[0];
+    config.inter_frame_timeout = regVals[1];
+    config.inter_phase_boost = regVals[2] != 0;
+    config.intra_detection = regVals[3] != 0;
+    config.inter_detection = regVals[4] != 0;
+    config.frame_rate = regVals[5];
+    config.intra_detection_threshold = regVals[6];
+    config.inter_detection_threshold = regVals[7];
+    config.inter_frame_deviation_time = regVals[8];
+    config.inter_frame_fast_cutoff = regVals[9];
+    config.inter_frame_slow_cutoff = regVals[10];
+    config.intra_frame_time_const = regVals[11];
+    config.intra_output_time_const = regVals[12];
+    config.inter_output_time_const = regVals[13];
+    config.auto_profile = regVals[14] != 0;
+    config.auto_step_length = regVals[15] != 0;
+    config.manual_profile = regVals[16];
+    config.manual_step_length = regVals[17];
+    config.start = regVals[18];
+    config.end = regVals[19];
+    config.reset_filters_on_prepare = regVals[20] != 0;
+    config.hwaas = regVals[21];
+
+    return getDetectionOnGPIO(config.detection_on_gpio);
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Presence::timingConfig(const sfe_xm125_presence_config_t &config,
+                                      sfe_xm125_timing_config_t &timingConfig)
+{
+    sfDevXM125Timing::defaultConfig(timingConfig);
+
+    timingConfig.start = config.start;
+    timingConfig.end = config.end;
+    timingConfig.profile = config.auto_profile ? SFE_XM125_PRESENCE_ESTIMATE_AUTO_PROFILE : config.manual_profile;
+    timingConfig.step_length = config.auto_step_length ? 0 : config.manual_step_length;
+    timingConfig.hwaas = config.hwaas;
+    timingConfig.sweeps_per_frame = config.sweeps_per_frame;
+    timingConfig.frame_rate = config.frame_rate;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::estimateTiming(const sfe_xm125_presence_config_t &config, sfe_xm125_timing_t &timing)
+{
+    sfe_xm125_timing_config_t settings;
+    timingConfig(config, settings);
+
+    return sfDevXM125Timing::estimate(settings, timing);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::estimateTiming(sfe_xm125_timing_t &timing)
+{
+    sfe_xm125_presence_config_t config;
+
+    sfTkError_t retVal = readConfigBlock(config);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    return estimateTiming(config, timing);
+}
+
+//--------------------------------------------------------------------------------
+uint32_t sfDevXM125Presence::estimateFrameMs(const sfe_xm125_presence_config_t &config)
+{
+    sfe_xm125_timing_t timing;
+
+    // A missed frame rate still has a timing - the frames just come slower
+    sfTkError_t retVal = estimateTiming(config, timing);
+    if (retVal != ksfTkErrOk && retVal != ksfTkErrXM125Timing)
+        return 0;
+
+    uint32_t frameUs = timing.frame_period_us > timing.frame_us ? timing.frame_period_us : timing.frame_us;
+
+    return (frameUs + 999) / 1000;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::estimateFrameMs(uint32_t &frameMs)
+{
+    sfe_xm125_presence_config_t config;
+
+    sfTkError_t retVal = readConfigBlock(config);
+    if (retVal != ksfTkErrOk)
+        return retVal;
+
+    frameMs = estimateFrameMs(config);
+    return ksfTkErrOk;
 }
 
 //--------------------------------------------------------------------------------
@@ -610,28 +1023,25 @@ sfTkError_t sfDevXM125Presence::logConfiguration()
 }
 
 //--------------------------------------------------------------------------------
-sfTkError_t sfDevXM125Presence::getBusy(uint32_t &busy)
+sfTkError_t sfDevXM125Presence::reset()
 {
-    // Read from 16-Bit Register
-
-    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_PRESENCE_DETECTOR_STATUS, busy);
-
-    // Mask unused bits from register
-    busy = (busy & SFE_XM125_PRESENCE_BUSY_MASK) >> SFE_XM125_PRESENCE_BUSY_MASK_SHIFT;
-
-    return retVal;
+    return setCommand(SFE_XM125_PRESENCE_RESET_MODULE);
 }
 
 //--------------------------------------------------------------------------------
-sfTkError_t sfDevXM125Presence::busyWait()
+sfTkError_t sfDevXM125Presence::getBusy(uint32_t &busy)
 {
-    uint32_t regVal = 0;
-
-    sfTkError_t retVal = _theBus->readRegister(SFE_XM125_PRESENCE_DETECTOR_STATUS, regVal);
+    return readField<Fields::Busy>(busy);
+}
 
-    // Poll Detector Status until Busy bit is cleared
-    while (((regVal & SFE_XM125_PRESENCE_BUSY_MASK) >> 30) != 0)
-        retVal = _theBus->readRegister(SFE_XM125_PRESENCE_DETECTOR_STATUS, regVal);
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::busyWait(uint32_t timeoutMs, sfe_xm125_poll_strategy_t strategy, uint32_t expectedMs)
+{
+    return busyWaitStatus(Fields::Busy::reg, Fields::Busy::mask, timeoutMs, strategy, expectedMs);
+}
 
-    return retVal;
-}
\ No newline at end of file
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Presence::pollBusy(sfe_xm125_busy_poll_t &poll)
+{
+    return pollBusyStatus(Fields::Busy::reg, Fields::Busy::mask, poll);
+}
@@ -19,58 +19,6 @@
 // defines and data structs
 /* ****************************** Presence Values ****************************** */
 
-const uint32_t SFE_XM125_PRESENCE_DETECTOR_STATUS_MASK = 0b10010000111111110000000011111111;
-
-const uint32_t SFE_XM125_PRESENCE_DETECTED_MASK = 0x00000001;
-const uint32_t SFE_XM125_PRESENCE_DETECTED_STICKY_MASK = 0x00000002;
-const uint32_t SFE_XM125_PRESENCE_DETECTOR_ERROR_MASK = 0x00008000;
-const uint32_t SFE_XM125_PRESENCE_TEMPERATURE_MASK = 0xffff0000;
-const uint32_t SFE_XM125_PRESENCE_MAJOR_VERSION_MASK = 0xffff0000;
-const uint32_t SFE_XM125_PRESENCE_MINOR_VERSION_MASK = 0x0000ff00;
-const uint32_t SFE_XM125_PRESENCE_PATCH_VERSION_MASK = 0x000000ff;
-
-const uint32_t SFE_XM125_PRESENCE_RSS_REGISTER_OK_MASK = 0x00000001;
-const uint32_t SFE_XM125_PRESENCE_CONFIG_CREATE_OK_MASK = 0x00000002;
-const uint32_t SFE_XM125_PRESENCE_SENSOR_CREATE_OK_MASK = 0x00000004;
-const uint32_t SFE_XM125_PRESENCE_SENSOR_CALIBRATE_OK_MASK = 0x00000008;
-const uint32_t SFE_XM125_PRESENCE_DETECTOR_CREATE_OK_MASK = 0x00000010;
-const uint32_t SFE_XM125_PRESENCE_DETECTOR_BUFFER_OK_MASK = 0x00000020;
-const uint32_t SFE_XM125_PRESENCE_SENSOR_BUFFER_OK_MASK = 0x00000040;
-const uint32_t SFE_XM125_PRESENCE_CONFIG_APPLY_OK_MASK = 0x00000080;
-const uint32_t SFE_XM125_PRESENCE_RSS_REGISTER_ERROR_MASK = 0x00010000;
-const uint32_t SFE_XM125_PRESENCE_CONFIG_CREATE_ERROR_MASK = 0x00020000;
-const uint32_t SFE_XM125_PRESENCE_SENSOR_CREATE_ERROR_MASK = 0x00040000;
-const uint32_t SFE_XM125_PRESENCE_SENSOR_CALIBRATE_ERROR_MASK = 0x00080000;
-const uint32_t SFE_XM125_PRESENCE_DETECTOR_CREATE_ERROR_MASK = 0x00100000;
-const uint32_t SFE_XM125_PRESENCE_DETECTOR_BUFFER_ERROR_MASK = 0x00200000;
-const uint32_t SFE_XM125_PRESENCE_SENSOR_BUFFER_ERROR_MASK = 0x00400000;
-const uint32_t SFE_XM125_PRESENCE_CONFIG_APPLY_ERROR_MASK = 0x00800000;
-const uint32_t SFE_XM125_PRESENCE_DETECTOR_REG_ERROR_MASK = 0x10000000;
-const uint32_t SFE_XM125_PRESENCE_BUSY_MASK = 0x80000000;
-
-const uint32_t SFE_XM125_PRESENCE_ALL_ERROR_MASK =
-    (SFE_XM125_PRESENCE_RSS_REGISTER_ERROR_MASK | SFE_XM125_PRESENCE_CONFIG_CREATE_ERROR_MASK |
-     SFE_XM125_PRESENCE_SENSOR_CREATE_ERROR_MASK | SFE_XM125_PRESENCE_SENSOR_CALIBRATE_ERROR_MASK |
-     SFE_XM125_PRESENCE_DETECTOR_CREATE_ERROR_MASK | SFE_XM125_PRESENCE_DETECTOR_BUFFER_ERROR_MASK |
-     SFE_XM125_PRESENCE_SENSOR_BUFFER_ERROR_MASK | SFE_XM125_PRESENCE_CONFIG_APPLY_ERROR_MASK |
-     SFE_XM125_PRESENCE_DETECTOR_REG_ERROR_MASK | SFE_XM125_PRESENCE_DETECTOR_ERROR_MASK |
-     SFE_XM125_PRESENCE_BUSY_MASK);
-
-const uint32_t SFE_XM125_PRESENCE_MAJOR_VERSION_MASK_SHIFT = 16;
-const uint32_t SFE_XM125_PRESENCE_MINOR_VERSION_MASK_SHIFT = 8;
-const uint32_t SFE_XM125_PRESENCE_RSS_REGISTER_ERROR_MASK_SHIFT = 15;
-const uint32_t SFE_XM125_PRESENCE_CONFIG_CREATE_ERROR_MASK_SHIFT = 16;
-const uint32_t SFE_XM125_PRESENCE_SENSOR_CREATE_ERROR_MASK_SHIFT = 17;
-const uint32_t SFE_XM125_PRESENCE_SENSOR_CALIBRATE_ERROR_MASK_SHIFT = 18;
-const uint32_t SFE_XM125_PRESENCE_DETECTOR_CREATE_ERROR_MASK_SHIFT = 19;
-const uint32_t SFE_XM125_PRESENCE_DETECTOR_BUFFER_ERROR_MASK_SHIFT = 20;
-const uint32_t SFE_XM125_PRESENCE_SENSOR_BUFFER_ERROR_MASK_SHIFT = 21;
-const uint32_t SFE_XM125_PRESENCE_CONFIG_APPLY_ERROR_MASK_SHIFT = 22;
-const uint32_t SFE_XM125_PRESENCE_DETECTOR_REG_ERROR_MASK_SHIFT = 27;
-const uint32_t SFE_XM125_PRESENCE_DETECTOR_ERROR_MASK_SHIFT = 14;
-const uint32_t SFE_XM125_PRESENCE_TEMPERATURE_MASK_SHIFT = 16;
-const uint32_t SFE_XM125_PRESENCE_BUSY_MASK_SHIFT = 30;
-
 const uint16_t SFE_XM125_PRESENCE_VERSION = 0x00;
 typedef struct
 {
@@ -129,10 +77,131 @@ typedef struct
     uint32_t presence_temperature : 16;
 } sfe_xm125_presence_result_t;
 
+// Bit fields of the version, detector status and result registers - sfDevXM125Field<register, offset, width, type>
+struct sfDevXM125PresenceFields
+{
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_VERSION, 16, 16> MajorVersion;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_VERSION, 8, 8> MinorVersion;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_VERSION, 0, 8> PatchVersion;
+
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 0, 1, bool> RssRegisterOk;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 1, 1, bool> ConfigCreateOk;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 2, 1, bool> SensorCreateOk;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 3, 1, bool> SensorCalibrateOk;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 4, 1, bool> DetectorCreateOk;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 5, 1, bool> DetectorBufferOk;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 6, 1, bool> SensorBufferOk;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 7, 1, bool> ConfigApplyOk;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 16, 1, bool> RssRegisterError;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 17, 1, bool> ConfigCreateError;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 18, 1, bool> SensorCreateError;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 19, 1, bool> SensorCalibrateError;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 20, 1, bool> DetectorCreateError;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 21, 1, bool> DetectorBufferError;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 22, 1, bool> SensorBufferError;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 23, 1, bool> ConfigApplyError;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 28, 1, bool> DetectorRegError;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_DETECTOR_STATUS, 31, 1, bool> Busy;
+
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_RESULT, 0, 1, bool> Detected;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_RESULT, 1, 1, bool> DetectedSticky;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_RESULT, 15, 1, bool> DetectorError;
+    typedef sfDevXM125Field<SFE_XM125_PRESENCE_RESULT, 16, 16, int16_t> Temperature;
+};
+
+// Masks and shifts of the register fields, kept for existing code - generated from the fields above
+const uint32_t SFE_XM125_PRESENCE_DETECTED_MASK = sfDevXM125PresenceFields::Detected::mask;
+const uint32_t SFE_XM125_PRESENCE_DETECTED_STICKY_MASK = sfDevXM125PresenceFields::DetectedSticky::mask;
+const uint32_t SFE_XM125_PRESENCE_DETECTOR_ERROR_MASK = sfDevXM125PresenceFields::DetectorError::mask;
+const uint32_t SFE_XM125_PRESENCE_TEMPERATURE_MASK = sfDevXM125PresenceFields::Temperature::mask;
+const uint32_t SFE_XM125_PRESENCE_MAJOR_VERSION_MASK = sfDevXM125PresenceFields::MajorVersion::mask;
+const uint32_t SFE_XM125_PRESENCE_MINOR_VERSION_MASK = sfDevXM125PresenceFields::MinorVersion::mask;
+const uint32_t SFE_XM125_PRESENCE_PATCH_VERSION_MASK = sfDevXM125PresenceFields::PatchVersion::mask;
+const uint32_t SFE_XM125_PRESENCE_RSS_REGISTER_OK_MASK = sfDevXM125PresenceFields::RssRegisterOk::mask;
+const uint32_t SFE_XM125_PRESENCE_CONFIG_CREATE_OK_MASK = sfDevXM125PresenceFields::ConfigCreateOk::mask;
+const uint32_t SFE_XM125_PRESENCE_SENSOR_CREATE_OK_MASK = sfDevXM125PresenceFields::SensorCreateOk::mask;
+const uint32_t SFE_XM125_PRESENCE_SENSOR_CALIBRATE_OK_MASK = sfDevXM125PresenceFields::SensorCalibrateOk::mask;
+const uint32_t SFE_XM125_PRESENCE_DETECTOR_CREATE_OK_MASK = sfDevXM125PresenceFields::DetectorCreateOk::mask;
+const uint32_t SFE_XM125_PRESENCE_DETECTOR_BUFFER_OK_MASK = sfDevXM125PresenceFields::DetectorBufferOk::mask;
+const uint32_t SFE_XM125_PRESENCE_SENSOR_BUFFER_OK_MASK = sfDevXM125PresenceFields::SensorBufferOk::mask;
+const uint32_t SFE_XM125_PRESENCE_CONFIG_APPLY_OK_MASK = sfDevXM125PresenceFields::ConfigApplyOk::mask;
+const uint32_t SFE_XM125_PRESENCE_RSS_REGISTER_ERROR_MASK = sfDevXM125PresenceFields::RssRegisterError::mask;
+const uint32_t SFE_XM125_PRESENCE_CONFIG_CREATE_ERROR_MASK = sfDevXM125PresenceFields::ConfigCreateError::mask;
+const uint32_t SFE_XM125_PRESENCE_SENSOR_CREATE_ERROR_MASK = sfDevXM125PresenceFields::SensorCreateError::mask;
+const uint32_t SFE_XM125_PRESENCE_SENSOR_CALIBRATE_ERROR_MASK = sfDevXM125PresenceFields::SensorCalibrateError::mask;
+const uint32_t SFE_XM125_PRESENCE_DETECTOR_CREATE_ERROR_MASK = sfDevXM125PresenceFields::DetectorCreateError::mask;
+const uint32_t SFE_XM125_PRESENCE_DETECTOR_BUFFER_ERROR_MASK = sfDevXM125PresenceFields::DetectorBufferError::mask;
+const uint32_t SFE_XM125_PRESENCE_SENSOR_BUFFER_ERROR_MASK = sfDevXM125PresenceFields::SensorBufferError::mask;
+const uint32_t SFE_XM125_PRESENCE_CONFIG_APPLY_ERROR_MASK = sfDevXM125PresenceFields::ConfigApplyError::mask;
+const uint32_t SFE_XM125_PRESENCE_DETECTOR_REG_ERROR_MASK = sfDevXM125PresenceFields::DetectorRegError::mask;
+const uint32_t SFE_XM125_PRESENCE_BUSY_MASK = sfDevXM125PresenceFields::Busy::mask;
+
+const uint32_t SFE_XM125_PRESENCE_ALL_ERROR_MASK =
+    (SFE_XM125_PRESENCE_RSS_REGISTER_ERROR_MASK | SFE_XM125_PRESENCE_CONFIG_CREATE_ERROR_MASK |
+     SFE_XM125_PRESENCE_SENSOR_CREATE_ERROR_MASK | SFE_XM125_PRESENCE_SENSOR_CALIBRATE_ERROR_MASK |
+     SFE_XM125_PRESENCE_DETECTOR_CREATE_ERROR_MASK | SFE_XM125_PRESENCE_DETECTOR_BUFFER_ERROR_MASK |
+     SFE_XM125_PRESENCE_SENSOR_BUFFER_ERROR_MASK | SFE_XM125_PRESENCE_CONFIG_APPLY_ERROR_MASK |
+     SFE_XM125_PRESENCE_DETECTOR_REG_ERROR_MASK | SFE_XM125_PRESENCE_BUSY_MASK);
+
+// All defined bits of the detector status register
+const uint32_t SFE_XM125_PRESENCE_DETECTOR_STATUS_MASK =
+    SFE_XM125_PRESENCE_ALL_ERROR_MASK | SFE_XM125_PRESENCE_RSS_REGISTER_OK_MASK |
+    SFE_XM125_PRESENCE_CONFIG_CREATE_OK_MASK | SFE_XM125_PRESENCE_SENSOR_CREATE_OK_MASK |
+    SFE_XM125_PRESENCE_SENSOR_CALIBRATE_OK_MASK | SFE_XM125_PRESENCE_DETECTOR_CREATE_OK_MASK |
+    SFE_XM125_PRESENCE_DETECTOR_BUFFER_OK_MASK | SFE_XM125_PRESENCE_SENSOR_BUFFER_OK_MASK |
+    SFE_XM125_PRESENCE_CONFIG_APPLY_OK_MASK;
+
+const uint32_t SFE_XM125_PRESENCE_MAJOR_VERSION_MASK_SHIFT = sfDevXM125PresenceFields::MajorVersion::offset;
+const uint32_t SFE_XM125_PRESENCE_MINOR_VERSION_MASK_SHIFT = sfDevXM125PresenceFields::MinorVersion::offset;
+const uint32_t SFE_XM125_PRESENCE_RSS_REGISTER_ERROR_MASK_SHIFT = sfDevXM125PresenceFields::RssRegisterError::offset;
+const uint32_t SFE_XM125_PRESENCE_CONFIG_CREATE_ERROR_MASK_SHIFT = sfDevXM125PresenceFields::ConfigCreateError::offset;
+const uint32_t SFE_XM125_PRESENCE_SENSOR_CREATE_ERROR_MASK_SHIFT = sfDevXM125PresenceFields::SensorCreateError::offset;
+const uint32_t SFE_XM125_PRESENCE_SENSOR_CALIBRATE_ERROR_MASK_SHIFT =
+    sfDevXM125PresenceFields::SensorCalibrateError::offset;
+const uint32_t SFE_XM125_PRESENCE_DETECTOR_CREATE_ERROR_MASK_SHIFT =
+    sfDevXM125PresenceFields::DetectorCreateError::offset;
+const uint32_t SFE_XM125_PRESENCE_DETECTOR_BUFFER_ERROR_MASK_SHIFT =
+    sfDevXM125PresenceFields::DetectorBufferError::offset;
+const uint32_t SFE_XM125_PRESENCE_SENSOR_BUFFER_ERROR_MASK_SHIFT = sfDevXM125PresenceFields::SensorBufferError::offset;
+const uint32_t SFE_XM125_PRESENCE_CONFIG_APPLY_ERROR_MASK_SHIFT = sfDevXM125PresenceFields::ConfigApplyError::offset;
+const uint32_t SFE_XM125_PRESENCE_DETECTOR_REG_ERROR_MASK_SHIFT = sfDevXM125PresenceFields::DetectorRegError::offset;
+const uint32_t SFE_XM125_PRESENCE_DETECTOR_ERROR_MASK_SHIFT = sfDevXM125PresenceFields::DetectorError::offset;
+const uint32_t SFE_XM125_PRESENCE_TEMPERATURE_MASK_SHIFT = sfDevXM125PresenceFields::Temperature::offset;
+const uint32_t SFE_XM125_PRESENCE_BUSY_MASK_SHIFT = sfDevXM125PresenceFields::Busy::offset;
+
+// Code returned by getDetectorErrorStatus() when no error but the busy bit is set
+const uint32_t SFE_XM125_PRESENCE_BUSY_ERROR_CODE = 11;
+
 const uint16_t SFE_XM125_PRESENCE_DISTANCE = 0x11;
 const uint16_t SFE_XM125_INTRA_PRESENCE_SCORE = 0x12;
 const uint16_t SFE_XM125_INTER_PRESENCE = 0x13;
 
+// Decoded values of a single presence frame - the result, distance and score registers (0x10 - 0x13)
+typedef struct
+{
+    uint32_t measure_counter; // measure counter value of this frame
+    bool detected;            // presence detected in this frame
+    bool detected_sticky;     // presence detected since the last read of the result register
+    bool detector_error;      // the presence detector failed
+    int16_t temperature;      // relative sensor temperature
+    uint32_t distance;        // distance to the detected presence in mm
+    uint32_t intra_score;     // measure of fast motion
+    uint32_t inter_score;     // measure of slow motion
+} sfe_xm125_presence_frame_t;
+
+// State and result of pollFrame() - keep it between calls, zero initialized before the first
+typedef struct
+{
+    bool ready;                       // a new frame has been measured - frame is valid
+    bool busy;                        // the detector is still busy
+    uint32_t status;                  // detector status register value
+    uint16_t status_errors;           // failed steps (SFE_XM125_STATUS_* flags), 0 if none
+    sfe_xm125_presence_frame_t frame; // the last ready frame
+} sfe_xm125_presence_poll_t;
+
+// Called by serviceEvents() with the frame read after a detection GPIO edge
+typedef void (*sfe_xm125_presence_event_cb_t)(const sfe_xm125_presence_frame_t &frame, void *user);
+
 const uint16_t SFE_XM125_PRESENCE_SWEEPS_PER_FRAME = 0x40;
 const uint16_t sfe_xm125_presence_sweeps_per_frame_default = 16;
 
@@ -209,6 +278,40 @@ const uint16_t sfe_xm125_presence_hwaas_default = 32;
 const uint16_t SFE_XM125_PRESENCE_DETECTION_ON_GPIO = 0x80;
 const bool sfe_xm125_presence_detection_on_gpio_default = false;
 
+// Number of consecutive configuration registers (0x40 - 0x55)
+const uint8_t SFE_XM125_PRESENCE_CONFIG_REGS = 22;
+
+// Profile assumed for frame time estimation when the detector selects the profile
+const uint32_t SFE_XM125_PRESENCE_ESTIMATE_AUTO_PROFILE = XM125_PRESENCE_PROFILE3;
+
+// Full detector configuration - fields are in register order, starting at SFE_XM125_PRESENCE_SWEEPS_PER_FRAME
+typedef struct
+{
+    uint32_t sweeps_per_frame;            // sweeps per frame
+    uint32_t inter_frame_timeout;         // inter frame presence timeout in seconds, 0 to disable
+    bool inter_phase_boost;               // enable inter phase boost
+    bool intra_detection;                 // enable intra frame (fast motion) detection
+    bool inter_detection;                 // enable inter frame (slow motion) detection
+    uint32_t frame_rate;                  // frame rate in mHz
+    uint32_t intra_detection_threshold;   // intra detection threshold
+    uint32_t inter_detection_threshold;   // inter detection threshold
+    uint32_t inter_frame_deviation_time;  // inter frame deviation time constant
+    uint32_t inter_frame_fast_cutoff;     // inter frame fast cutoff frequency
+    uint32_t inter_frame_slow_cutoff;     // inter frame slow cutoff frequency
+    uint32_t intra_frame_time_const;      // intra frame time constant
+    uint32_t intra_output_time_const;     // intra output time constant
+    uint32_t inter_output_time_const;     // inter output time constant
+    bool auto_profile;                    // enable automatic profile selection
+    bool auto_step_length;                // enable automatic step length
+    uint32_t manual_profile;              // profile used when auto profile is off (sfe_xm125_presence_manual_profile_t)
+    uint32_t manual_step_length;          // step length used when auto step length is off
+    uint32_t start;                       // start of measured interval in mm
+    uint32_t end;                         // end of measured interval in mm
+    bool reset_filters_on_prepare;        // reset the presence filters on prepare
+    uint32_t hwaas;                       // hardware accelerated average samples
+    uint32_t detection_on_gpio;           // presence detection output on GPIO (register 0x80)
+} sfe_xm125_presence_config_t;
+
 const uint16_t SFE_XM125_PRESENCE_COMMAND = 0x100;
 typedef enum
 {
@@ -234,6 +337,11 @@ const uint32_t SFE_XM125_PRESENCE_RESET_MODULE = 1381192737;
 class sfDevXM125Presence : public sfDevXM125Core
 {
   public:
+    /// @brief Initializer
+    sfDevXM125Presence()
+        : sfDevXM125Core(SFE_XM125_PRESENCE_HWAAS), _streaming{false}, _detectorStarted{false}, _lastMeasureCounter{0},
+          _eventCallback{nullptr}, _eventUser{nullptr}, _eventPending{false} {};
+
     /**
      * @brief Initializes the Presence detector device.
      *
@@ -249,7 +357,15 @@ class sfDevXM125Presence : public sfDevXM125Core
     ///  example to be run on the device for presence sensing.
     /// @param start Start value for presence sensing in mm  - default value is 1000
     /// @param end End value for presence sensing in mm - default value is 5000
-    /// @return ksfTkErrOk on success, or error code (value < -1)
+    ///  A detector left running - by start(), getDistanceValuemm() or startStreaming() - is stopped
+    ///  first, so the detector is stopped after the setup either way.
+    ///  With the fast restart enabled, a repeated setup with the same range skips the module reset -
+    ///  see enableFastRestart().
+    ///  With the timing check enabled, a configuration that can not reach its frame rate is not
+    ///  applied - see enableTimingCheck(). The check reads the registers after the module reset and
+    ///  the range are written, as the module would apply them.
+    /// @return ksfTkErrOk on success, ksfTkErrXM125Timing when the frame rate can not be reached,
+    ///  or error code (value < -1)
     sfTkError_t detectorStart(uint32_t start = 1000, uint32_t end = 5000);
 
     /// @brief This function returns the presence value of the register
@@ -257,6 +373,72 @@ class sfDevXM125Presence : public sfDevXM125Core
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t getDistanceValuemm(uint32_t &presenceVal);
 
+    /// @brief This function starts the presence detector once for continuous
+    ///  measurements at the configured frame rate. Use readStream() to collect
+    ///  frames as the detector produces them.
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t startStreaming();
+
+    /// @brief This function stops continuous measurements started with startStreaming()
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t stopStreaming();
+
+    /// @brief This function checks the measure counter and, only when it has advanced,
+    ///  reads the result, distance and score registers in a single transaction.
+    ///  An idle call costs one register read.
+    /// @param frame Frame values, updated when a new frame is available
+    /// @param newFrame Set to true when frame holds a new measurement
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readStream(sfe_xm125_presence_frame_t &frame, bool &newFrame);
+
+    /// @brief Checks for a new frame with as few reads as possible - one burst read of the
+    ///  adjacent measure counter and detector status registers (0x02 - 0x03), and only when a new
+    ///  frame has been measured, one burst read of the result, distance and score registers.
+    ///  Unlike readStream(), this also reports detector status errors.
+    /// @param poll Poll state and result - keep it between calls
+    /// @return ksfTkErrOk on success - check poll.ready - ksfTkErrXM125Detector when the detector
+    ///  status shows an error (see poll.status_errors), or error code (value < -1)
+    sfTkError_t pollFrame(sfe_xm125_presence_poll_t &poll);
+
+    /// @brief Returns true while continuous measurements are running
+    bool isStreaming(void)
+    {
+        return _streaming;
+    }
+
+    /// @brief This function enables presence detection on the module GPIO and (re)starts
+    ///  continuous measurements. The host calls signalGPIOEvent() on each edge of the pin,
+    ///  and serviceEvents() then reads the frame and passes it to the callback - the bus
+    ///  stays idle between edges.
+    /// @param callback Function called with each event frame
+    /// @param user Pointer passed to the callback
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t enableGPIOEvents(sfe_xm125_presence_event_cb_t callback, void *user = nullptr);
+
+    /// @brief This function stops continuous measurements and presence detection on the GPIO
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t disableGPIOEvents();
+
+    /// @brief Records an edge of the detection GPIO. Does not use the bus, so it is safe
+    ///  to call from an interrupt handler.
+    void signalGPIOEvent(void)
+    {
+        _eventPending = true;
+    }
+
+    /// @brief Returns true when an edge has been signaled and not yet serviced
+    bool eventPending(void)
+    {
+        return _eventPending;
+    }
+
+    /// @brief This function reads the result, distance and score registers in a single
+    ///  transaction if an edge was signaled, and passes the frame to the event callback.
+    ///  Without a pending edge it returns immediately.
+    ///  Note: The measure counter is not read - measure_counter is 0 in event frames
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t serviceEvents();
+
     /// @brief This function returns the RSS version number
     /// @param version Version number
     /// @param patch Patch version number
@@ -291,6 +473,18 @@ class sfDevXM125Presence : public sfDevXM125Core
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t getDetectorErrorStatus(uint32_t &status);
 
+    /// @brief This function reads the detector status register once and decodes all of its
+    ///  flags - every completed and failed setup step, and the busy bit.
+    /// @param status Decoded status
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t getStatus(sfDevXM125Status &status);
+
+    /// @brief Decodes a detector status register value without reading the device - for
+    ///  example the status left in sfe_xm125_busy_poll_t::status by pollBusy().
+    /// @param regVal Value of the detector status register
+    /// @param status Decoded status
+    static void decodeStatus(uint32_t regVal, sfDevXM125Status &status);
+
     /// @brief This function returns if there was presence detected
     /// @param detected Presence Detected
     /// @return ksfTkErrOk on success, or error code (value < -1)
@@ -660,6 +854,54 @@ class sfDevXM125Presence : public sfDevXM125Core
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t setCommand(uint32_t cmd);
 
+    /// @brief This function fills a configuration structure with the device default values
+    /// @param config Configuration to fill
+    void getDefaultConfig(sfe_xm125_presence_config_t &config);
+
+    /// @brief This function writes a complete detector configuration. The configuration
+    ///  registers are written with auto-incrementing block writes instead of one
+    ///  transaction per register. The configuration still needs to be applied.
+    /// @param config Configuration to write
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeConfigBlock(const sfe_xm125_presence_config_t &config);
+
+    /// @brief This function reads the complete detector configuration in a single
+    ///  block read, plus the detection on GPIO register.
+    /// @param config Configuration read from the device
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readConfigBlock(sfe_xm125_presence_config_t &config);
+
+    /// @brief This function fills the sensor settings of the timing model from a detector
+    ///  configuration. An automatic profile is assumed to be SFE_XM125_PRESENCE_ESTIMATE_AUTO_PROFILE.
+    /// @param config Detector configuration
+    /// @param timingConfig Timing model settings to fill
+    static void timingConfig(const sfe_xm125_presence_config_t &config, sfe_xm125_timing_config_t &timingConfig);
+
+    /// @brief This function estimates the sweep and frame timing of a detector configuration
+    /// @param config Detector configuration
+    /// @param timing Estimated timing
+    /// @return ksfTkErrOk on success, ksfTkErrXM125Timing when the frame rate can not be reached,
+    ///  or error code (value < -1)
+    static sfTkError_t estimateTiming(const sfe_xm125_presence_config_t &config, sfe_xm125_timing_t &timing);
+
+    /// @brief This function estimates the sweep and frame timing with the configuration of the device
+    /// @param timing Estimated timing
+    /// @return ksfTkErrOk on success, ksfTkErrXM125Timing when the frame rate can not be reached,
+    ///  or error code (value < -1)
+    sfTkError_t estimateTiming(sfe_xm125_timing_t &timing);
+
+    /// @brief This function estimates the time between presence frames from a detector
+    ///  configuration - the frame period, or the duration of the sweeps when these take longer.
+    /// @param config Detector configuration
+    /// @return Estimated frame time in milliseconds, 0 for a configuration the sensor does not accept
+    static uint32_t estimateFrameMs(const sfe_xm125_presence_config_t &config);
+
+    /// @brief This function estimates the time between presence frames with the configuration
+    ///  of the device.
+    /// @param frameMs Estimated frame time in milliseconds
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t estimateFrameMs(uint32_t &frameMs);
+
     /// @brief This function applies the configuration to the device by
     ///  writing the defined value to the presence command register
     /// @return ksfTkErrOk on success, or error code (value < -1)
@@ -700,9 +942,44 @@ class sfDevXM125Presence : public sfDevXM125Core
     /// @return ksfTkErrOk on success, or error code (value < -1)
     sfTkError_t getBusy(uint32_t &busy);
 
-    /// @brief Completes a busy wait loop while the device is uploading
-    ///  information by waiting for the status. Checks the error status register
-    ///  to wait until errors are completed/gone
-    /// @return ksfTkErrOk on success, or error code (value < -1)
-    sfTkError_t busyWait();
+    /// @brief Waits while the device is busy by polling the busy bit of the detector
+    ///  status register. The wait is bounded by a timeout, and the poll rate is set by
+    ///  the polling strategy.
+    /// @param timeoutMs Time allowed for the device to clear the busy bit
+    /// @param strategy How the status register is polled
+    /// @param expectedMs Expected command duration, used by XM125_POLL_EXPECTED
+    /// @return ksfTkErrOk on success, ksfTkErrXM125Timeout on timeout, or error code (value < -1)
+    sfTkError_t busyWait(uint32_t timeoutMs = SFE_XM125_BUSY_WAIT_TIMEOUT_DEFAULT,
+                         sfe_xm125_poll_strategy_t strategy = XM125_POLL_FIXED, uint32_t expectedMs = 0);
+
+    /// @brief Non-blocking busy wait step for cooperative schedulers. Start the wait with
+    ///  startBusyPoll(), then call this until it returns a value other than ksfTkErrXM125Busy.
+    ///  The bus is only accessed when a poll is due.
+    /// @param poll Busy wait state from startBusyPoll()
+    /// @return ksfTkErrOk when not busy, ksfTkErrXM125Busy while busy, ksfTkErrXM125Timeout on timeout,
+    ///  or error code (value < -1)
+    sfTkError_t pollBusy(sfe_xm125_busy_poll_t &poll);
+
+  private:
+    /// @brief Reads and decodes the result, distance and score registers in one transaction
+    sfTkError_t readFrame(sfe_xm125_presence_frame_t &frame);
+
+    /// @brief Returns the getDetectorErrorStatus() code of the status register value read by the
+    ///  last busy wait, so a finished command is checked without reading the register again
+    uint32_t busyWaitErrorStatus(void);
+
+    /// @brief Fast restart of detectorStart() - succeeds when the module still runs the
+    ///  configuration the setup would apply
+    /// @return true if the setup is done, false if it must run in full
+    bool fastRestart(uint32_t startValue, uint32_t endValue);
+
+    // continuous measurement state
+    bool _streaming;
+    bool _detectorStarted; // started by any command, until stopped or reset - not only by startStreaming()
+    uint32_t _lastMeasureCounter;
+
+    // detection GPIO events
+    sfe_xm125_presence_event_cb_t _eventCallback;
+    void *_eventUser;
+    volatile bool _eventPending;
 };
\ No newline at end of file
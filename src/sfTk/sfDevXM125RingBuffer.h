@@ -0,0 +1,307 @@
+/**
+ * @file sfDevXM125RingBuffer.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains fixed capacity, allocation free ring buffers for measurement frames. Frames
+ * are filled in place - reserve() a slot, read the device into it and commit() it - and consumers
+ * get spans of the stored frames without copying them.
+ *
+ * sfDevXM125RingBuffer is used from a single context. sfDevXM125SpscRingBuffer is lock free for one
+ * producer and one consumer running in different contexts, for example an interrupt handler and the
+ * main loop, or two tasks.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "sfDevXM125Atomic.h"
+
+/// @brief A run of consecutive items inside a ring buffer
+template <class T> struct sfDevXM125Span
+{
+    T *data;
+    uint16_t size;
+};
+
+/// @brief Ring buffer for use from a single context. N must be a power of two.
+template <class T, uint16_t N> class sfDevXM125RingBuffer
+{
+    static_assert(N > 0 && N <= 32768 && (N & (N - 1)) == 0, "sfDevXM125RingBuffer: N must be a power of two");
+
+  public:
+    sfDevXM125RingBuffer() : _head{0}, _tail{0}, _dropped{0}, _overwrite{false}
+    {
+    }
+
+    /// @brief Sets what happens when an item is added to a full buffer - with overwrite set
+    ///  the oldest item is dropped, otherwise the new item is.
+    /// @param overwrite Drop the oldest item when full
+    void setOverwrite(bool overwrite)
+    {
+        _overwrite = overwrite;
+    }
+
+    /// @brief Returns the slot for the next item, to be filled in place and then added with
+    ///  commit(). Reserving again without a commit returns the same slot. When the buffer is full
+    ///  and overwrite is set, the slot is that of the oldest item, which commit() drops.
+    /// @return The slot, or nullptr if the buffer is full and overwrite is not set
+    T *reserve(void)
+    {
+        if (full() && !_overwrite)
+        {
+            _dropped++;
+            return nullptr;
+        }
+
+        return &_items[_head & (N - 1)];
+    }
+
+    /// @brief Adds the item filled in the slot returned by reserve(). When the buffer is full, the
+    ///  oldest item is dropped to make room.
+    void commit(void)
+    {
+        if (full())
+        {
+            // reserve() returned no slot
+            if (!_overwrite)
+                return;
+
+            _dropped++;
+            _tail++;
+        }
+
+        _head++;
+    }
+
+    /// @brief Adds a copy of an item
+    /// @param item Item to add
+    /// @return true if the item was added
+    bool push(const T &item)
+    {
+        T *slot = reserve();
+        if (slot == nullptr)
+            return false;
+
+        *slot = item;
+        commit();
+        return true;
+    }
+
+    /// @brief Returns the oldest items that are stored consecutively. When the stored items
+    ///  wrap around the end of the buffer, call again after consume() for the rest.
+    sfDevXM125Span<const T> peek(void)
+    {
+        uint16_t first = _tail & (N - 1);
+        uint16_t run = N - first;
+        uint16_t count = size();
+
+        sfDevXM125Span<const T> span = {&_items[first], count < run ? count : run};
+        return span;
+    }
+
+    /// @brief Returns the oldest item, or nullptr if the buffer is empty
+    const T *front(void)
+    {
+        return empty() ? nullptr : &_items[_tail & (N - 1)];
+    }
+
+    /// @brief Returns a stored item
+    /// @param index Position of the item - 0 is the oldest, must be less than size()
+    const T &at(uint16_t index)
+    {
+        return _items[(uint16_t)(_tail + index) & (N - 1)];
+    }
+
+    /// @brief Removes the oldest items
+    /// @param count Number of items to remove
+    void consume(uint16_t count)
+    {
+        _tail += count < size() ? count : size();
+    }
+
+    /// @brief Copies and removes the oldest item
+    /// @param item Copy of the removed item
+    /// @return true if an item was removed
+    bool pop(T &item)
+    {
+        if (empty())
+            return false;
+
+        item = _items[_tail & (N - 1)];
+        _tail++;
+        return true;
+    }
+
+    /// @brief Returns the number of stored items
+    uint16_t size(void)
+    {
+        return (uint16_t)(_head - _tail);
+    }
+
+    /// @brief Returns the number of items the buffer holds
+    uint16_t capacity(void)
+    {
+        return N;
+    }
+
+    bool empty(void)
+    {
+        return _head == _tail;
+    }
+
+    bool full(void)
+    {
+        return size() == N;
+    }
+
+    /// @brief Returns the number of items dropped because the buffer was full
+    uint32_t dropped(void)
+    {
+        return _dropped;
+    }
+
+    /// @brief Removes all items
+    void clear(void)
+    {
+        _tail = _head;
+    }
+
+  private:
+    T _items[N];
+
+    // Free running indices - the difference is the number of stored items
+    uint16_t _head;
+    uint16_t _tail;
+    uint32_t _dropped;
+    bool _overwrite;
+};
+
+/// @brief Lock free ring buffer for one producer and one consumer in different contexts. N must be
+///  a power of two no larger than 128, so the indices are single bytes, which are read and written
+///  atomically on every platform (see sfDevXM125Atomic.h). The producer only calls reserve(), commit() and push(); the
+///  consumer only calls peek(), front(), consume() and pop().
+template <class T, uint8_t N> class sfDevXM125SpscRingBuffer
+{
+    static_assert(N > 0 && N <= 128 && (N & (N - 1)) == 0, "sfDevXM125SpscRingBuffer: N must be a power of two");
+
+  public:
+    /// @brief Producer - returns the slot for the next item, to be filled in place and then
+    ///  published with commit()
+    /// @return The slot, or nullptr if the buffer is full
+    T *reserve(void)
+    {
+        // Acquiring the tail makes sure the consumer has finished with the slot
+        uint8_t head = _head.loadRelaxed();
+        if ((uint8_t)(head - _tail.load()) == N)
+        {
+            _dropped.store((sfe_xm125_atomic_word_t)(_dropped.loadRelaxed() + 1));
+            return nullptr;
+        }
+
+        return &_items[head & (N - 1)];
+    }
+
+    /// @brief Producer - publishes the item filled in the slot returned by reserve()
+    void commit(void)
+    {
+        // Releasing the head makes the item visible to the consumer
+        _head.store((uint8_t)(_head.loadRelaxed() + 1));
+    }
+
+    /// @brief Producer - adds a copy of an item
+    /// @param item Item to add
+    /// @return true if the item was added
+    bool push(const T &item)
+    {
+        T *slot = reserve();
+        if (slot == nullptr)
+            return false;
+
+        *slot = item;
+        commit();
+        return true;
+    }
+
+    /// @brief Consumer - returns the oldest items that are stored consecutively. When the
+    ///  stored items wrap around the end of the buffer, call again after consume() for the rest.
+    sfDevXM125Span<const T> peek(void)
+    {
+        uint8_t count = size();
+        uint8_t first = _tail.loadRelaxed() & (N - 1);
+        uint8_t run = N - first;
+
+        sfDevXM125Span<const T> span = {&_items[first], (uint16_t)(count < run ? count : run)};
+        return span;
+    }
+
+    /// @brief Consumer - returns the oldest item, or nullptr if the buffer is empty
+    const T *front(void)
+    {
+        if (empty())
+            return nullptr;
+
+        return &_items[_tail.loadRelaxed() & (N - 1)];
+    }
+
+    /// @brief Consumer - removes the oldest items, handing their slots back to the producer
+    /// @param count Number of items to remove
+    void consume(uint8_t count)
+    {
+        uint8_t stored = size();
+
+        // Releasing the tail hands the slots back only after the items have been read
+        _tail.store((uint8_t)(_tail.loadRelaxed() + (count < stored ? count : stored)));
+    }
+
+    /// @brief Consumer - copies and removes the oldest item
+    /// @param item Copy of the removed item
+    /// @return true if an item was removed
+    bool pop(T &item)
+    {
+        const T *oldest = front();
+        if (oldest == nullptr)
+            return false;
+
+        item = *oldest;
+        consume(1);
+        return true;
+    }
+
+    /// @brief Returns the number of stored items. Acquiring the head makes the published items
+    ///  visible to the consumer.
+    uint8_t size(void)
+    {
+        return (uint8_t)(_head.load() - _tail.load());
+    }
+
+    uint8_t capacity(void)
+    {
+        return N;
+    }
+
+    bool empty(void)
+    {
+        return size() == 0;
+    }
+
+    /// @brief Returns the number of items the producer dropped because the buffer was full,
+    ///  wrapping around - can be read from either side
+    sfe_xm125_atomic_word_t dropped(void)
+    {
+        return _dropped.load();
+    }
+
+  private:
+    T _items[N];
+
+    // Free running indices - the head is only written by the producer, the tail by the consumer
+    sfDevXM125Atomic<uint8_t> _head;
+    sfDevXM125Atomic<uint8_t> _tail;
+    sfDevXM125Atomic<sfe_xm125_atomic_word_t> _dropped;
+};
@@ -0,0 +1,358 @@
+/**
+ * @file sfDevXM125Scheduler.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains a round-robin measurement scheduler for several XM125 modules. The scheduler
+ * knows the expected frame time of each module - estimated from its configuration, then refined from
+ * the measured frame times - and only touches the bus when a module is due: it staggers the start
+ * commands, reads whichever module is due next and starts it again, so the modules measure in
+ * parallel instead of one after the other.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "sfDevXM125Core.h"
+#include "sfDevXM125Measurement.h"
+
+// Largest number of modules a scheduler can hold
+const uint8_t SFE_XM125_SCHEDULER_MAX_SENSORS = 16;
+
+/// @brief Schedules measurements on up to N modules. TDevice is sfDevXM125Distance or
+///  sfDevXM125Presence - any class with start(), pollBusy(), getMeasureCounter() and
+///  estimateFrameMs() will do.
+template <class TDevice, uint8_t N> class sfDevXM125Scheduler
+{
+    static_assert(N > 0 && N <= SFE_XM125_SCHEDULER_MAX_SENSORS, "sfDevXM125Scheduler: unsupported number of sensors");
+
+  public:
+    /// @brief Called by service() when a module has a new frame - index is the index returned by
+    ///  addSensor()
+    typedef typename sfDevXM125Measurement<TDevice>::readout_cb_t readout_cb_t;
+
+    sfDevXM125Scheduler() : _count{0}, _last{N - 1}, _timeoutMs{SFE_XM125_BUSY_WAIT_TIMEOUT_DEFAULT}
+    {
+    }
+
+    /// @brief Adds a configured module and estimates its frame time from its configuration.
+    /// @param device The module - must be set up, and outlive the scheduler
+    /// @param index Index of the added module
+    /// @param freeRunning Set for modules that measure continuously once started, like the
+    ///  presence detector. Other modules are started again after each readout. A free running
+    ///  module is read out when its measure counter shows a new frame, and its frame clock follows
+    ///  the frames as they arrive.
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t addSensor(TDevice &device, uint8_t &index, bool freeRunning = false)
+    {
+        if (_count >= N)
+            return ksfTkErrFail;
+
+        uint32_t frameMs = 0;
+        sfTkError_t retVal = device.estimateFrameMs(frameMs);
+        if (retVal != ksfTkErrOk)
+            return retVal;
+
+        index = _count++;
+
+        sensor_t &s = _sensors[index];
+        s.device = &device;
+        s.freeRunning = freeRunning;
+        s.state = kIdle;
+        s.frameMs = frameMs > 0 ? frameMs : 1;
+        s.measurement = sfDevXM125Measurement<TDevice>();
+
+        return ksfTkErrOk;
+    }
+
+    /// @brief Returns the number of modules added
+    uint8_t count(void)
+    {
+        return _count;
+    }
+
+    /// @brief Overrides the frame time of a module
+    /// @param index Index of the module
+    /// @param frameMs Frame time in milliseconds
+    void setFrameTime(uint8_t index, uint32_t frameMs)
+    {
+        if (index < _count)
+            _sensors[index].frameMs = frameMs > 0 ? frameMs : 1;
+    }
+
+    /// @brief Returns the frame time of a module, refined with each measured frame
+    /// @param index Index of the module
+    uint32_t frameTime(uint8_t index)
+    {
+        return index < _count ? _sensors[index].frameMs : 0;
+    }
+
+    /// @brief Sets the time allowed for a measurement
+    /// @param timeoutMs Timeout in milliseconds
+    void setTimeout(uint32_t timeoutMs)
+    {
+        _timeoutMs = timeoutMs;
+    }
+
+    /// @brief Schedules the start of all modules. The start commands are staggered over one
+    ///  frame time, so the modules become due one after the other instead of all at once.
+    void startAll(void)
+    {
+        uint32_t now = sftk_ticks_ms();
+
+        for (uint8_t i = 0; i < _count; i++)
+        {
+            sensor_t &s = _sensors[i];
+            s.state = kStartPending;
+            s.dueMs = now + i * (s.frameMs / _count);
+        }
+    }
+
+    /// @brief Stops scheduling a module. A free running module keeps measuring until stopped
+    ///  with its stop() method.
+    /// @param index Index of the module
+    void stop(uint8_t index)
+    {
+        if (index < _count)
+            _sensors[index].state = kIdle;
+    }
+
+    /// @brief Handles every module that is due, in the order they became due - starts it, reads
+    ///  it out through the callback or checks whether it is done. Modules that are not due are
+    ///  not accessed. Call this from the main loop; nextDueMs() tells how long it can sleep.
+    ///  A module that fails is no longer scheduled - see lastError().
+    /// @param callback Called for each module with a new frame
+    /// @param user User pointer passed to the callback
+    /// @return Number of frames read out in this pass
+    uint8_t service(readout_cb_t callback, void *user = nullptr)
+    {
+        uint8_t done = 0;
+
+        // Each module can become due at most twice in one pass - start, then read
+        for (uint8_t n = 0; n < 2 * N; n++)
+        {
+            int8_t i = nextDue();
+            if (i < 0 || (int32_t)(sftk_ticks_ms() - _sensors[i].dueMs) < 0)
+                break;
+
+            _last = (uint8_t)i;
+            if (step(_sensors[i], (uint8_t)i, callback, user))
+                done++;
+        }
+
+        return done;
+    }
+
+    /// @brief Returns the time until the next module is due
+    /// @return Milliseconds until the next module is due, 0 if one is due now, or
+    ///  SFE_XM125_BUSY_WAIT_TIMEOUT_DEFAULT if nothing is scheduled
+    uint32_t nextDueMs(void)
+    {
+        int8_t i = nextDue();
+        if (i < 0)
+            return SFE_XM125_BUSY_WAIT_TIMEOUT_DEFAULT;
+
+        int32_t wait = (int32_t)(_sensors[i].dueMs - sftk_ticks_ms());
+        return wait > 0 ? (uint32_t)wait : 0;
+    }
+
+    /// @brief Returns true while a module is scheduled
+    /// @param index Index of the module
+    bool running(uint8_t index)
+    {
+        return index < _count && _sensors[index].state != kIdle;
+    }
+
+    /// @brief Returns the number of frames read out from a module
+    /// @param index Index of the module
+    uint32_t frames(uint8_t index)
+    {
+        return index < _count ? _sensors[index].measurement.frames() : 0;
+    }
+
+    /// @brief Returns the result of the last start or measurement of a module
+    /// @param index Index of the module
+    sfTkError_t lastError(uint8_t index)
+    {
+        return index < _count ? _sensors[index].measurement.lastError() : ksfTkErrFail;
+    }
+
+  private:
+    typedef enum
+    {
+        kIdle = 0,         // not scheduled
+        kStartPending = 1, // start command due
+        kMeasuring = 2,    // waiting for the busy bit to clear
+        kFreeRunning = 3,  // started free running module, next frame due - checked on the measure counter
+    } state_t;
+
+    typedef struct
+    {
+        TDevice *device;
+        bool freeRunning;
+        uint8_t state; // state_t
+        uint32_t dueMs;
+        uint32_t frameMs;
+        uint32_t lastCounter; // measure counter of the last frame of a free running module
+        uint32_t lastFrameMs; // when that frame was found
+        bool waited;          // the frame was not there yet when due - it arrives about when found
+        sfDevXM125Measurement<TDevice> measurement;
+    } sensor_t;
+
+    // Returns the scheduled module that is due first, -1 if none. Ties go to the module after
+    // the one served last, so modules due together are served round-robin.
+    int8_t nextDue(void)
+    {
+        int8_t next = -1;
+
+        for (uint8_t n = 1; n <= _count; n++)
+        {
+            uint8_t i = (uint8_t)((_last + n) % _count);
+            if (_sensors[i].state == kIdle)
+                continue;
+
+            if (next < 0 || (int32_t)(_sensors[i].dueMs - _sensors[next].dueMs) < 0)
+                next = (int8_t)i;
+        }
+
+        return next;
+    }
+
+    void fail(sensor_t &s, sfTkError_t error)
+    {
+        s.measurement.fail(error);
+        s.state = kIdle;
+    }
+
+    void start(sensor_t &s)
+    {
+        if (s.measurement.start(*s.device, _timeoutMs, s.freeRunning ? 0 : s.frameMs) != ksfTkErrOk)
+        {
+            s.state = kIdle;
+            return;
+        }
+
+        s.dueMs = s.measurement.busyPoll().nextPollMs;
+        s.state = kMeasuring;
+    }
+
+    // Handles a due module, returns true if a frame was read out
+    bool step(sensor_t &s, uint8_t index, readout_cb_t callback, void *user)
+    {
+        if (s.state == kStartPending)
+        {
+            start(s);
+            return false;
+        }
+
+        if (s.state == kMeasuring)
+        {
+            if (!s.measurement.poll(*s.device))
+            {
+                s.dueMs = s.measurement.busyPoll().nextPollMs;
+                return false;
+            }
+            if (s.measurement.lastError() != ksfTkErrOk)
+            {
+                s.state = kIdle;
+                return false;
+            }
+
+            uint32_t now = sftk_ticks_ms();
+
+            // A free running module is now measuring - its first frame is one frame time away
+            if (s.freeRunning)
+            {
+                sfTkError_t retVal = s.device->getMeasureCounter(s.lastCounter);
+                if (retVal != ksfTkErrOk)
+                {
+                    fail(s, retVal);
+                    return false;
+                }
+
+                s.state = kFreeRunning;
+                s.lastFrameMs = now;
+                s.waited = false;
+                s.dueMs = now + s.frameMs;
+                return false;
+            }
+
+            // Refine the frame time. Done at the first poll means the estimate may be too long,
+            // so probe a shorter one; otherwise move towards the measured time.
+            const sfe_xm125_busy_poll_t &poll = s.measurement.busyPoll();
+            if (poll.polls <= 1)
+                s.frameMs -= s.frameMs > 1 ? (s.frameMs + 7) / 8 : 0;
+            else
+                s.frameMs = (3 * s.frameMs + (now - poll.startMs) + 3) / 4;
+
+            s.measurement.readout(*s.device, index, callback, user);
+            start(s);
+            return true;
+        }
+
+        return stepFreeRunning(s, index, callback, user);
+    }
+
+    // Free running - read the frame out only when the measure counter moved, and keep the frame
+    // clock on the frames as they arrive, so a module clock that runs faster or slower than the
+    // estimate neither repeats nor skips frames
+    bool stepFreeRunning(sensor_t &s, uint8_t index, readout_cb_t callback, void *user)
+    {
+        uint32_t counter = 0;
+        sfTkError_t retVal = s.device->getMeasureCounter(counter);
+        if (retVal != ksfTkErrOk)
+        {
+            fail(s, retVal);
+            return false;
+        }
+
+        uint32_t now = sftk_ticks_ms();
+
+        // Not there yet - check again shortly, and give up after the timeout
+        if (counter == s.lastCounter)
+        {
+            if (now - s.lastFrameMs >= s.frameMs + _timeoutMs)
+            {
+                fail(s, ksfTkErrXM125Timeout);
+                return false;
+            }
+
+            s.waited = true;
+            s.dueMs = now + SFE_XM125_POLL_INTERVAL_DEFAULT;
+            return false;
+        }
+
+        // Move the frame time towards the measured one. More than one new frame means a frame
+        // was missed - the frames come faster than expected, take the measured time right away.
+        uint32_t frames = counter - s.lastCounter;
+        uint32_t measuredMs = (now - s.lastFrameMs) / frames;
+        if (measuredMs == 0)
+            measuredMs = 1;
+        s.frameMs = frames > 1 ? measuredMs : (3 * s.frameMs + measuredMs + 3) / 4;
+
+        s.lastCounter = counter;
+        s.lastFrameMs = now;
+        s.measurement.clearError();
+
+        s.measurement.readout(*s.device, index, callback, user);
+
+        // A frame that was waited for arrived about now - align the clock to it. One that was
+        // already there arrived earlier, so check for the next one a little early.
+        s.dueMs = now + s.frameMs;
+        if (!s.waited)
+            s.dueMs -= (s.frameMs + 31) / 32;
+        s.waited = false;
+
+        return true;
+    }
+
+    sensor_t _sensors[N];
+    uint8_t _count;
+    uint8_t _last; // module served last
+    uint32_t _timeoutMs;
+};
@@ -0,0 +1,316 @@
+/**
+ * @file sfDevXM125SetupOp.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains resumable versions of the reset/apply/calibrate sequences of the detectors.
+ * An operation performs at most one bus transfer per step() call and never sleeps, so a main loop
+ * or RTOS task can do other work while the module is busy:
+ *
+ *     sfDevXM125DistanceSetupOp op;
+ *     op.beginSetup(radarSensor, 500, 5000);
+ *     while (!op.step())
+ *     {
+ *         // other work
+ *     }
+ *     if (op.error() != ksfTkErrOk) ...
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "sfDevXM125Core.h"
+#include "sfDevXM125Distance.h"
+#include "sfDevXM125Presence.h"
+
+// Stages of a setup operation, in the order they run
+typedef enum
+{
+    XM125_OP_IDLE = 0,         // no operation started
+    XM125_OP_RESET = 1,        // send the reset command
+    XM125_OP_WAIT_RESET = 2,   // wait for the reset to finish
+    XM125_OP_CHECK_RESET = 3,  // check the detector error flags after the reset, from the last busy poll
+    XM125_OP_SET_START = 4,    // write the start of the measured interval
+    XM125_OP_SET_END = 5,      // write the end of the measured interval
+    XM125_OP_COMMAND = 6,      // send the apply or calibrate command
+    XM125_OP_WAIT_COMMAND = 7, // wait for the command to finish
+    XM125_OP_CHECK = 8,        // check the detector error flags after the command, from the last busy poll
+    XM125_OP_REMEMBER = 9,     // record the applied configuration for the fast restart
+    XM125_OP_DONE = 10,        // finished without error
+    XM125_OP_FAILED = 11,      // finished with an error - see error() and failedStage()
+} sfe_xm125_op_stage_t;
+
+/// @brief Resumable setup sequence. TDevice is sfDevXM125Distance or sfDevXM125Presence.
+template <class TDevice> class sfDevXM125SetupOp
+{
+  public:
+    sfDevXM125SetupOp()
+        : _device{nullptr}, _command{nullptr}, _applies{false}, _stage{XM125_OP_IDLE}, _firstStage{XM125_OP_IDLE},
+          _failedStage{XM125_OP_IDLE}, _error{ksfTkErrOk}, _startMm{0}, _endMm{0},
+          _startedMs{0}, _readyMs{0}, _elapsedMs{0}, _timeoutMs{SFE_XM125_BUSY_WAIT_TIMEOUT_DEFAULT}
+    {
+    }
+
+    /// @brief Starts the full setup sequence of distanceSetup() and detectorStart() - reset
+    ///  the module, check for errors, set the measured interval, then apply the configuration.
+    ///  The presence detector is not started. Once done, the configuration is recorded for the
+    ///  fast restart of the next setup.
+    /// @param device The module
+    /// @param startMm Start of the measured interval in mm
+    /// @param endMm End of the measured interval in mm
+    void beginSetup(TDevice &device, uint32_t startMm, uint32_t endMm)
+    {
+        _startMm = startMm;
+        _endMm = endMm;
+        begin(device, &sfDevXM125SetupOp::applyCommand, true, XM125_OP_RESET);
+    }
+
+    /// @brief Starts applying the configuration already written to the module. The presence
+    ///  detector is not started.
+    /// @param device The module
+    void beginApply(TDevice &device)
+    {
+        begin(device, &sfDevXM125SetupOp::applyCommand, true, XM125_OP_COMMAND);
+    }
+
+    /// @brief Starts a calibration of the distance detector
+    /// @param device The module
+    void beginCalibrate(TDevice &device)
+    {
+        begin(device, &sfDevXM125SetupOp::calibrateCommand, false, XM125_OP_COMMAND);
+    }
+
+    /// @brief Starts a recalibration of the distance detector
+    /// @param device The module
+    void beginRecalibrate(TDevice &device)
+    {
+        begin(device, &sfDevXM125SetupOp::recalibrateCommand, false, XM125_OP_COMMAND);
+    }
+
+    /// @brief Sets the time allowed for the module to finish each command
+    /// @param timeoutMs Timeout in milliseconds
+    void setTimeout(uint32_t timeoutMs)
+    {
+        _timeoutMs = timeoutMs;
+    }
+
+    /// @brief Advances the operation. Each call performs at most one bus transfer, and none
+    ///  while the module is expected to be busy.
+    /// @return true once the operation has finished - check error()
+    bool step(void)
+    {
+        if (finished())
+            return true;
+
+        // Give the last command or register write time to take effect
+        if ((int32_t)(sftk_ticks_ms() - _readyMs) < 0)
+            return false;
+
+        sfTkError_t retVal;
+
+        switch (_stage)
+        {
+        case XM125_OP_RESET:
+            retVal = _device->reset();
+            if (retVal != ksfTkErrOk)
+                return fail(retVal);
+            wait(XM125_OP_WAIT_RESET);
+            break;
+
+        case XM125_OP_WAIT_RESET:
+        case XM125_OP_WAIT_COMMAND:
+            retVal = _device->pollBusy(_poll);
+            if (retVal == ksfTkErrXM125Busy)
+                break;
+            if (retVal != ksfTkErrOk)
+                return fail(retVal);
+            _stage = _stage == XM125_OP_WAIT_RESET ? XM125_OP_CHECK_RESET : XM125_OP_CHECK;
+            break;
+
+        case XM125_OP_CHECK_RESET:
+        case XM125_OP_CHECK:
+            // The busy poll already read the status register - decode it instead of reading it again
+            TDevice::decodeStatus(_poll.status, _status);
+            if (_status.hasError())
+                return fail(ksfTkErrXM125Detector);
+            if (_stage == XM125_OP_CHECK_RESET)
+                _stage = XM125_OP_SET_START;
+            else
+                _stage = _applies ? XM125_OP_REMEMBER : XM125_OP_DONE;
+            break;
+
+        case XM125_OP_REMEMBER:
+            _device->rememberAppliedConfig();
+            _stage = XM125_OP_DONE;
+            break;
+
+        case XM125_OP_SET_START:
+        case XM125_OP_SET_END:
+            retVal = _stage == XM125_OP_SET_START ? _device->setStart(_startMm) : _device->setEnd(_endMm);
+            if (retVal != ksfTkErrOk)
+                return fail(retVal);
+            _stage = _stage + 1;
+            settle();
+            break;
+
+        case XM125_OP_COMMAND:
+            retVal = _command(*_device);
+            if (retVal != ksfTkErrOk)
+                return fail(retVal);
+            wait(XM125_OP_WAIT_COMMAND);
+            break;
+
+        default:
+            return fail(ksfTkErrFail);
+        }
+
+        if (_stage != XM125_OP_DONE)
+            return false;
+
+        _elapsedMs = sftk_ticks_ms() - _startedMs;
+        return true;
+    }
+
+    /// @brief Returns true once the operation has finished, with or without an error
+    bool finished(void)
+    {
+        return _stage == XM125_OP_DONE || _stage == XM125_OP_FAILED || _stage == XM125_OP_IDLE;
+    }
+
+    /// @brief Returns the current stage (sfe_xm125_op_stage_t)
+    uint8_t stage(void)
+    {
+        return _stage;
+    }
+
+    /// @brief Returns the stage that failed (sfe_xm125_op_stage_t), XM125_OP_IDLE if none
+    uint8_t failedStage(void)
+    {
+        return _failedStage;
+    }
+
+    /// @brief Returns the progress of the operation in percent
+    uint8_t progress(void)
+    {
+        if (_stage == XM125_OP_DONE || _stage == XM125_OP_FAILED)
+            return 100;
+        if (_stage <= _firstStage)
+            return 0;
+
+        return (uint8_t)((_stage - _firstStage) * 100 / (XM125_OP_DONE - _firstStage));
+    }
+
+    /// @brief Returns the result of the operation - ksfTkErrOk, a bus error, ksfTkErrXM125Timeout
+    ///  or ksfTkErrXM125Detector when the detector reported an error (see detectorStatus())
+    sfTkError_t error(void)
+    {
+        return _error;
+    }
+
+    /// @brief Returns the detector status decoded by the last check - on ksfTkErrXM125Detector,
+    ///  its errorFlags() tell every step that failed
+    sfDevXM125Status detectorStatus(void)
+    {
+        return _status;
+    }
+
+    /// @brief Returns the time since the operation was started, or its duration once finished
+    uint32_t elapsedMs(void)
+    {
+        return finished() ? _elapsedMs : sftk_ticks_ms() - _startedMs;
+    }
+
+  private:
+    typedef sfTkError_t (*command_t)(TDevice &device);
+
+    // The command that applies the configuration of each detector - applyConfiguration() of the
+    // presence detector starts it instead
+    static sfTkError_t applyConfig(sfDevXM125Distance &device)
+    {
+        return device.applyConfiguration();
+    }
+
+    static sfTkError_t applyConfig(sfDevXM125Presence &device)
+    {
+        return device.setCommand(SFE_XM125_PRESENCE_APPLY_CONFIGURATION);
+    }
+
+    static sfTkError_t applyCommand(TDevice &device)
+    {
+        return applyConfig(device);
+    }
+
+    static sfTkError_t calibrateCommand(TDevice &device)
+    {
+        return device.calibrate();
+    }
+
+    static sfTkError_t recalibrateCommand(TDevice &device)
+    {
+        return device.recalibrate();
+    }
+
+    void begin(TDevice &device, command_t command, bool applies, uint8_t firstStage)
+    {
+        _device = &device;
+        _command = command;
+        _applies = applies;
+        _stage = firstStage;
+        _firstStage = firstStage;
+        _failedStage = XM125_OP_IDLE;
+        _error = ksfTkErrOk;
+        _status = sfDevXM125Status();
+        _startedMs = sftk_ticks_ms();
+        _readyMs = _startedMs;
+        _elapsedMs = 0;
+    }
+
+    // A command was sent - the module is polled from the next step on
+    void wait(uint8_t next)
+    {
+        settle();
+        _device->startBusyPoll(_poll, _timeoutMs);
+        _stage = next;
+    }
+
+    // Holds the next step for the fixed delay when the module uses XM125_WAIT_FIXED_DELAY
+    void settle(void)
+    {
+        _readyMs = sftk_ticks_ms();
+        if (_device->waitMode() == XM125_WAIT_FIXED_DELAY)
+            _readyMs += SFE_XM125_FIXED_DELAY_MS;
+    }
+
+    bool fail(sfTkError_t error)
+    {
+        _error = error;
+        _failedStage = _stage;
+        _stage = XM125_OP_FAILED;
+        _elapsedMs = sftk_ticks_ms() - _startedMs;
+        return true;
+    }
+
+    TDevice *_device;
+    command_t _command;
+    bool _applies;
+    uint8_t _stage;
+    uint8_t _firstStage;
+    uint8_t _failedStage;
+    sfTkError_t _error;
+    sfDevXM125Status _status;
+    uint32_t _startMm;
+    uint32_t _endMm;
+    uint32_t _startedMs;
+    uint32_t _readyMs;
+    uint32_t _elapsedMs;
+    uint32_t _timeoutMs;
+    sfe_xm125_busy_poll_t _poll;
+};
+
+typedef sfDevXM125SetupOp<sfDevXM125Distance> sfDevXM125DistanceSetupOp;
+typedef sfDevXM125SetupOp<sfDevXM125Presence> sfDevXM125PresenceSetupOp;
@@ -0,0 +1,637 @@
+/**
+ * @file sfDevXM125Sim.cpp
+ * @brief Implementation of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the implementation of a simulated XM125 module, used to run the
+ * library without a module attached.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "sfDevXM125Sim.h"
+
+// Power on values of the configuration registers, in register order
+static const uint32_t kDistanceConfigDefaults[SFE_XM125_DISTANCE_CONFIG_REGS] = {
+    sfe_xm125_distance_start_default,
+    sfe_xm125_distance_end_default,
+    sfe_xm125_distance_max_step_length_default,
+    sfe_xm125_distance_close_range_leakage_default,
+    sfe_xm125_distance_signal_quality_default,
+    XM125_DISTANCE_PROFILE5,
+    XM125_DISTANCE_CFAR,
+    XM125_DISTANCE_STRONGEST,
+    sfe_xm125_distance_num_frames_recorded_thresh_default,
+    sfe_xm125_distance_fixed_amp_thresh_val_default,
+    sfe_xm125_distance_threshold_sensitivity_default,
+    XM125_DISTANCE_GENERIC,
+    sfe_xm125_distance_fixed_strength_threshold_val_default};
+
+static const uint32_t kPresenceConfigDefaults[SFE_XM125_PRESENCE_CONFIG_REGS] = {
+    sfe_xm125_presence_sweeps_per_frame_default,
+    sfe_xm125_presence_inter_frame_timeout_default,
+    sfe_xm125_presence_inter_phase_boost_enabled_default,
+    sfe_xm125_presence_intra_detection_enabled_default,
+    sfe_xm125_presence_inter_detection_enabled_default,
+    sfe_xm125_presence_frame_rate_default,
+    sfe_xm125_presence_intra_detection_threshold_default,
+    sfe_xm125_presence_inter_detection_threshold_default,
+    sfe_xm125_presence_inter_frame_deviation_default,
+    sfe_xm125_presence_inter_frame_fast_cutoff_default,
+    sfe_xm125_presence_inter_frame_slow_cutoff_default,
+    sfe_xm125_presence_intra_frame_time_const_default,
+    sfe_xm125_presence_intra_output_time_const_default,
+    sfe_xm125_presence_inter_output_time_const_default,
+    sfe_xm125_presence_auto_profile_enabled_default,
+    sfe_xm125_presence_auto_step_length_enabled_default,
+    XM125_PRESENCE_PROFILE4,
+    sfe_xm125_presence_manual_step_length_default,
+    sfe_xm125_presence_start_default,
+    sfe_xm125_presence_end_default,
+    sfe_xm125_presence_reset_filters_on_prepare_default,
+    sfe_xm125_presence_hwaas_default};
+
+// Detector status after power on - the register map, configuration and sensor are created
+static const uint32_t kStatusPowerOn = SFE_XM125_DISTANCE_RSS_REGISTER_OK_MASK |
+                                       SFE_XM125_DISTANCE_CONFIG_CREATE_OK_MASK |
+                                       SFE_XM125_DISTANCE_SENSOR_CREATE_OK_MASK;
+
+// Detector status bits set by a successful apply configuration
+static const uint32_t kDistanceStatusApplied =
+    SFE_XM125_DISTANCE_DETECTOR_CREATE_OK_MASK | SFE_XM125_DISTANCE_DETECTOR_BUFFER_OK_MASK |
+    SFE_XM125_DISTANCE_SENSOR_BUFFER_OK_MASK | SFE_XM125_DISTANCE_CALIBRATION_BUFFER_OK_MASK |
+    SFE_XM125_DISTANCE_CONFIG_APPLY_OK_MASK;
+static const uint32_t kDistanceStatusCalibrated =
+    SFE_XM125_DISTANCE_SENSOR_CALIBRATE_OK_MASK | SFE_XM125_DISTANCE_DETECTOR_CALIBRATE_OK_MASK;
+static const uint32_t kPresenceStatusApplied =
+    SFE_XM125_PRESENCE_SENSOR_CALIBRATE_OK_MASK | SFE_XM125_PRESENCE_DETECTOR_CREATE_OK_MASK |
+    SFE_XM125_PRESENCE_DETECTOR_BUFFER_OK_MASK | SFE_XM125_PRESENCE_SENSOR_BUFFER_OK_MASK |
+    SFE_XM125_PRESENCE_CONFIG_APPLY_OK_MASK;
+
+// Offsets of the start and end registers in each configuration block
+static const uint8_t kDistanceStartIndex = SFE_XM125_DISTANCE_START - SFE_XM125_SHADOW_BLOCK_START;
+static const uint8_t kDistanceEndIndex = SFE_XM125_DISTANCE_END - SFE_XM125_SHADOW_BLOCK_START;
+static const uint8_t kPresenceStartIndex = SFE_XM125_PRESENCE_START - SFE_XM125_SHADOW_BLOCK_START;
+static const uint8_t kPresenceEndIndex = SFE_XM125_PRESENCE_END - SFE_XM125_SHADOW_BLOCK_START;
+
+// Time comparison that survives the millisecond counter wrapping
+static bool timeReached(uint32_t now, uint32_t when)
+{
+    return (int32_t)(now - when) >= 0;
+}
+
+//--------------------------------------------------------------------------------
+sfDevXM125Sim::sfDevXM125Sim(sfe_xm125_sim_app_t app)
+    : sfTkII2C(SFE_XM125_I2C_ADDRESS), _app{app}, _timing(SFE_XM125_SIM_TIMING_DEFAULT), _clock{sftk_ticks_ms},
+      _connected{true}, _awake{true}, _waking{false}, _wakeDoneMs{0}, _nTargets{0}, _present{false},
+      _presenceDistance{0}, _intraScore{0}, _interScore{0}, _temperature{25}
+{
+    powerOn();
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Sim::powerOn(void)
+{
+    _protocolStatus = 0;
+    _measureCounter = 0;
+    _detectorStatus = kStatusPowerOn;
+
+    for (uint8_t i = 0; i < sizeof(_result) / sizeof(_result[0]); i++)
+        _result[i] = 0;
+
+    setDefaultConfig();
+
+    _op = SIM_OP_NONE;
+    _opDoneMs = 0;
+    _applied = false;
+    _calibrated = false;
+    _calibrationNeeded = false;
+    _running = false;
+    _nextFrameMs = 0;
+    _transfers = 0;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Sim::setDefaultConfig(void)
+{
+    const uint32_t *defaults = _app == XM125_SIM_DISTANCE ? kDistanceConfigDefaults : kPresenceConfigDefaults;
+
+    for (uint8_t i = 0; i < SFE_XM125_SHADOW_BLOCK_MAX; i++)
+        _config[i] = i < configRegs() ? defaults[i] : 0;
+
+    // measure on wakeup and detection on GPIO are both off by default
+    _configExtra = 0;
+}
+
+//--------------------------------------------------------------------------------
+uint8_t sfDevXM125Sim::configRegs(void)
+{
+    return _app == XM125_SIM_DISTANCE ? SFE_XM125_DISTANCE_CONFIG_REGS : SFE_XM125_PRESENCE_CONFIG_REGS;
+}
+
+//--------------------------------------------------------------------------------
+uint32_t sfDevXM125Sim::resultRegs(void)
+{
+    // distance: result plus the peak registers, presence: result, distance and the two scores
+    return _app == XM125_SIM_DISTANCE ? 1 + SFE_XM125_DISTANCE_MAX_PEAKS * 2 : 4;
+}
+
+//--------------------------------------------------------------------------------
+uint32_t sfDevXM125Sim::configValue(uint16_t devReg)
+{
+    return _config[devReg - SFE_XM125_SHADOW_BLOCK_START];
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125Sim::configValid(void)
+{
+    if (_app == XM125_SIM_DISTANCE)
+        return _config[kDistanceStartIndex] < _config[kDistanceEndIndex];
+
+    return _config[kPresenceStartIndex] < _config[kPresenceEndIndex] &&
+           configValue(SFE_XM125_PRESENCE_SWEEPS_PER_FRAME) != 0;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Sim::setTargets(const uint32_t *distance, const int32_t *strength, uint8_t count)
+{
+    if (distance == nullptr || strength == nullptr)
+        count = 0;
+
+    _nTargets = count > SFE_XM125_SIM_MAX_TARGETS ? SFE_XM125_SIM_MAX_TARGETS : count;
+    for (uint8_t i = 0; i < _nTargets; i++)
+    {
+        _targetDistance[i] = distance[i];
+        _targetStrength[i] = strength[i];
+    }
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Sim::setPresence(bool present, uint32_t distance, uint32_t intraScore, uint32_t interScore)
+{
+    _present = present;
+    _presenceDistance = distance;
+    _intraScore = intraScore;
+    _interScore = interScore;
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125Sim::gpioLevel(void)
+{
+    update();
+
+    return _app == XM125_SIM_PRESENCE && _configExtra != 0 && (_result[0] & SFE_XM125_PRESENCE_DETECTED_MASK);
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Sim::setWakeUp(bool level)
+{
+    update();
+
+    if (level == _awake)
+        return;
+
+    _awake = level;
+
+    if (!level)
+    {
+        // Hibernating keeps the configuration and calibration, but drops what the module was doing
+        _op = SIM_OP_NONE;
+        _detectorStatus &= ~SFE_XM125_DISTANCE_BUSY_MASK;
+        _running = false;
+        _waking = false;
+        return;
+    }
+
+    _waking = true;
+    _wakeDoneMs = now() + _timing.wakeMs;
+
+    // Measure on wakeup - the measurement follows the wake up
+    if (_app == XM125_SIM_DISTANCE && _configExtra != 0 && _applied && _calibrated)
+        beginOp(SIM_OP_MEASURE, _timing.wakeMs + _timing.measureMs);
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125Sim::mcuIntLevel(void)
+{
+    update();
+
+    return responding() && !busy();
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125Sim::responding(void)
+{
+    return _connected && _awake && !_waking;
+}
+
+//--------------------------------------------------------------------------------
+uint32_t sfDevXM125Sim::framePeriodMs(void)
+{
+    // frame rate is in mHz - 0 means frames are measured back to back
+    uint32_t rate = configValue(SFE_XM125_PRESENCE_FRAME_RATE);
+    uint32_t period = rate == 0 ? _timing.measureMs : 1000000UL / rate;
+
+    return period == 0 ? 1 : period;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Sim::update(void)
+{
+    uint32_t t = now();
+
+    if (_waking && timeReached(t, _wakeDoneMs))
+        _waking = false;
+
+    if (busy() && timeReached(t, _opDoneMs))
+        completeOp();
+
+    if (!_running || !timeReached(t, _nextFrameMs))
+        return;
+
+    // Count frames the host did not look at without simulating each one
+    uint32_t period = framePeriodMs();
+    uint32_t missed = (t - _nextFrameMs) / period;
+
+    _measureCounter += missed;
+    measurePresence();
+    _nextFrameMs += (missed + 1) * period;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Sim::beginOp(sim_op_t op, uint32_t durationMs)
+{
+    _op = op;
+    _opDoneMs = now() + durationMs;
+    _detectorStatus |= SFE_XM125_DISTANCE_BUSY_MASK;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Sim::completeOp(void)
+{
+    sim_op_t op = _op;
+
+    _op = SIM_OP_NONE;
+    _detectorStatus &= ~SFE_XM125_DISTANCE_BUSY_MASK;
+
+    if (op == SIM_OP_RESET)
+    {
+        // A module reset keeps the simulator statistics
+        uint32_t transfers = _transfers;
+        powerOn();
+        _transfers = transfers;
+        return;
+    }
+
+    if (op == SIM_OP_MEASURE)
+    {
+        measureDistance();
+        return;
+    }
+
+    if (op == SIM_OP_APPLY || op == SIM_OP_APPLY_CALIBRATE || (op == SIM_OP_START && !_applied))
+    {
+        bool distance = _app == XM125_SIM_DISTANCE;
+
+        _applied = configValid();
+        _calibrated = false;
+
+        if (_applied)
+        {
+            _detectorStatus &= ~(SFE_XM125_DISTANCE_ALL_ERROR_MASK | kDistanceStatusCalibrated);
+            _detectorStatus |= distance ? kDistanceStatusApplied : kPresenceStatusApplied;
+        }
+        else
+            _detectorStatus |= (distance ? SFE_XM125_DISTANCE_CONFIG_APPLY_ERROR_MASK
+                                         : SFE_XM125_PRESENCE_CONFIG_APPLY_ERROR_MASK) |
+                               SFE_XM125_DISTANCE_DETECTOR_ERROR_MASK;
+    }
+
+    if (op == SIM_OP_CALIBRATE || (op == SIM_OP_APPLY_CALIBRATE && _applied))
+    {
+        if (_applied)
+        {
+            _calibrated = true;
+            _calibrationNeeded = false;
+            _detectorStatus |= kDistanceStatusCalibrated;
+        }
+        else
+            _detectorStatus |=
+                SFE_XM125_DISTANCE_DETECTOR_CALIBRATE_ERROR_MASK | SFE_XM125_DISTANCE_DETECTOR_ERROR_MASK;
+    }
+
+    if (op == SIM_OP_START && _applied)
+    {
+        _running = true;
+        measurePresence();
+        _nextFrameMs = now() + framePeriodMs();
+    }
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Sim::runCommand(uint32_t command)
+{
+    // A reset is accepted at any time
+    if (command == SFE_XM125_DISTANCE_RESET_MODULE)
+    {
+        _running = false;
+        beginOp(SIM_OP_RESET, _timing.resetMs);
+        return;
+    }
+
+    // Log commands only affect the UART output of the module
+    if (command >= SFE_XM125_PRESENCE_ENABLE_UART_LOGS && command <= SFE_XM125_PRESENCE_LOG_CONFIGURATION)
+        return;
+
+    if (busy())
+    {
+        _protocolStatus |= SFE_XM125_SIM_PROTOCOL_STATE_ERROR;
+        return;
+    }
+
+    if (_app == XM125_SIM_DISTANCE)
+    {
+        switch (command)
+        {
+        case XM125_DISTANCE_APPLY_CONFIG_AND_CALIBRATE:
+            beginOp(SIM_OP_APPLY_CALIBRATE, _timing.applyMs + _timing.calibrateMs);
+            break;
+
+        case XM125_DISTANCE_MEASURE_DISTANCE:
+            if (_applied && _calibrated)
+                beginOp(SIM_OP_MEASURE, _timing.measureMs);
+            else
+            {
+                _result[0] |= SFE_XM125_DISTANCE_MEASURE_DISTANCE_ERROR_MASK;
+                _detectorStatus |= SFE_XM125_DISTANCE_DETECTOR_ERROR_MASK;
+            }
+            break;
+
+        case XM125_DISTANCE_APPLY_CONFIGURATION:
+            beginOp(SIM_OP_APPLY, _timing.applyMs);
+            break;
+
+        case XM125_DISTANCE_CALIBRATE:
+        case XM125_DISTANCE_RECALIBRATE:
+            beginOp(SIM_OP_CALIBRATE, _timing.calibrateMs);
+            break;
+
+        default:
+            _protocolStatus |= SFE_XM125_SIM_WRITE_FAILED;
+            break;
+        }
+        return;
+    }
+
+    switch (command)
+    {
+    case XM125_PRESENCE_APPLY_CONFIGURATION:
+        if (_running)
+            _protocolStatus |= SFE_XM125_SIM_PROTOCOL_STATE_ERROR;
+        else
+            beginOp(SIM_OP_APPLY, _timing.applyMs);
+        break;
+
+    case XM125_PRESENCE_START_DETECTOR:
+        // Starting applies the configuration first when needed - starting a running detector has no effect
+        if (!_running)
+            beginOp(SIM_OP_START, _timing.startMs + (_applied ? 0 : _timing.applyMs));
+        break;
+
+    case XM125_PRESENCE_STOP_DETECTOR:
+        _running = false;
+        break;
+
+    default:
+        _protocolStatus |= SFE_XM125_SIM_WRITE_FAILED;
+        break;
+    }
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Sim::measureDistance(void)
+{
+    uint32_t start = _config[kDistanceStartIndex];
+    uint32_t end = _config[kDistanceEndIndex];
+    bool closest = configValue(SFE_XM125_DISTANCE_PEAK_SORTING) == XM125_DISTANCE_CLOSEST;
+    bool nearStartEdge = false;
+
+    uint32_t distance[SFE_XM125_SIM_MAX_TARGETS];
+    int32_t strength[SFE_XM125_SIM_MAX_TARGETS];
+    uint8_t count = 0;
+
+    // Keep the objects inside the measured interval, in peak sorting order
+    for (uint8_t i = 0; i < _nTargets; i++)
+    {
+        if (_targetDistance[i] < start)
+        {
+            nearStartEdge = true;
+            continue;
+        }
+        if (_targetDistance[i] > end)
+            continue;
+
+        uint8_t pos = count++;
+        for (; pos > 0; pos--)
+        {
+            bool before = closest ? _targetDistance[i] < distance[pos - 1] : _targetStrength[i] > strength[pos - 1];
+            if (!before)
+                break;
+            distance[pos] = distance[pos - 1];
+            strength[pos] = strength[pos - 1];
+        }
+        distance[pos] = _targetDistance[i];
+        strength[pos] = _targetStrength[i];
+    }
+
+    if (count > SFE_XM125_DISTANCE_MAX_PEAKS)
+        count = SFE_XM125_DISTANCE_MAX_PEAKS;
+
+    _result[0] = sfDevXM125DistanceFields::NumDistances::set(0, count);
+    _result[0] = sfDevXM125DistanceFields::NearStartEdge::set(_result[0], nearStartEdge);
+    _result[0] = sfDevXM125DistanceFields::CalibrationNeeded::set(_result[0], _calibrationNeeded);
+    _result[0] = sfDevXM125DistanceFields::Temperature::set(_result[0], _temperature);
+
+    for (uint8_t i = 0; i < SFE_XM125_DISTANCE_MAX_PEAKS; i++)
+    {
+        _result[1 + i] = i < count ? distance[i] : 0;
+        _result[1 + SFE_XM125_DISTANCE_MAX_PEAKS + i] = i < count ? (uint32_t)strength[i] : 0;
+    }
+
+    _measureCounter++;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Sim::measurePresence(void)
+{
+    bool inRange =
+        _presenceDistance >= _config[kPresenceStartIndex] && _presenceDistance <= _config[kPresenceEndIndex];
+    bool intra = configValue(SFE_XM125_PRESENCE_INTRA_DETECTION_ENABLED) != 0 &&
+                 _intraScore >= configValue(SFE_XM125_PRESENCE_INTRA_DETECTION_THRESHOLD);
+    bool inter = configValue(SFE_XM125_PRESENCE_INTER_DETECTION_ENABLED) != 0 &&
+                 _interScore >= configValue(SFE_XM125_PRESENCE_INTER_DETECTION_THRESHOLD);
+    bool detected = _present && inRange && (intra || inter);
+
+    // The sticky flag holds until the result register is read
+    uint32_t sticky = _result[0] & SFE_XM125_PRESENCE_DETECTED_STICKY_MASK;
+
+    _result[0] = (detected ? SFE_XM125_PRESENCE_DETECTED_MASK | SFE_XM125_PRESENCE_DETECTED_STICKY_MASK : sticky);
+    _result[0] = sfDevXM125PresenceFields::Temperature::set(_result[0], _temperature);
+    _result[1] = detected ? _presenceDistance : 0;
+    _result[2] = _present ? _intraScore : 0;
+    _result[3] = _present ? _interScore : 0;
+
+    _measureCounter++;
+}
+
+//--------------------------------------------------------------------------------
+bool sfDevXM125Sim::readWord(uint16_t devReg, uint32_t &value)
+{
+    value = 0;
+
+    if (devReg == SFE_XM125_DISTANCE_VERSION)
+        value = SFE_XM125_SIM_VERSION;
+    else if (devReg == SFE_XM125_DISTANCE_PROTOCOL_STATUS)
+        value = _protocolStatus;
+    else if (devReg == SFE_XM125_DISTANCE_MEASURE_COUNTER)
+        value = _measureCounter;
+    else if (devReg == SFE_XM125_DISTANCE_DETECTOR_STATUS)
+        value = _detectorStatus;
+    else if (devReg >= SFE_XM125_DISTANCE_RESULT && devReg < SFE_XM125_DISTANCE_RESULT + resultRegs())
+    {
+        value = _result[devReg - SFE_XM125_DISTANCE_RESULT];
+
+        if (_app == XM125_SIM_PRESENCE && devReg == SFE_XM125_PRESENCE_RESULT)
+            _result[0] &= ~SFE_XM125_PRESENCE_DETECTED_STICKY_MASK;
+    }
+    else if (devReg >= SFE_XM125_SHADOW_BLOCK_START && devReg < SFE_XM125_SHADOW_BLOCK_START + configRegs())
+        value = configValue(devReg);
+    else if (devReg == SFE_XM125_SHADOW_EXTRA_REG)
+        value = _configExtra;
+    else
+    {
+        _protocolStatus |= SFE_XM125_SIM_ADDRESS_ERROR;
+        return false;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Sim::writeWord(uint16_t devReg, uint32_t value)
+{
+    if (devReg == SFE_XM125_DISTANCE_COMMAND)
+        runCommand(value);
+    else if (devReg >= SFE_XM125_SHADOW_BLOCK_START && devReg < SFE_XM125_SHADOW_BLOCK_START + configRegs())
+    {
+        if (busy() || _running)
+            _protocolStatus |= busy() ? SFE_XM125_SIM_WRITE_FAILED : SFE_XM125_SIM_PROTOCOL_STATE_ERROR;
+        else
+            _config[devReg - SFE_XM125_SHADOW_BLOCK_START] = value;
+    }
+    else if (devReg == SFE_XM125_SHADOW_EXTRA_REG)
+        _configExtra = value;
+    else if (devReg <= SFE_XM125_DISTANCE_DETECTOR_STATUS ||
+             (devReg >= SFE_XM125_DISTANCE_RESULT && devReg < SFE_XM125_DISTANCE_RESULT + resultRegs()))
+        _protocolStatus |= SFE_XM125_SIM_WRITE_TO_READ_ONLY;
+    else
+        _protocolStatus |= SFE_XM125_SIM_ADDRESS_ERROR;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Sim::ping()
+{
+    update();
+
+    return responding() ? ksfTkErrOk : ksfTkErrFail;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Sim::writeData(const uint8_t *data, size_t length)
+{
+    if (data == nullptr || length < 2)
+        return ksfTkErrFail;
+
+    return writeRegister((uint16_t)(((uint16_t)data[0] << 8) | data[1]), data + 2, length - 2);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Sim::writeRegister(uint8_t devReg, const uint8_t *data, size_t length)
+{
+    return writeRegister((uint16_t)devReg, data, length);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Sim::writeRegister(uint16_t devReg, const uint8_t *data, size_t length)
+{
+    if (data == nullptr && length > 0)
+        return ksfTkErrFail;
+
+    update();
+    if (!responding())
+        return ksfTkErrFail;
+
+    _transfers++;
+
+    // Registers are whole big-endian words - the module rejects any other length
+    if (length % sizeof(uint32_t) != 0)
+    {
+        _protocolStatus |= SFE_XM125_SIM_PACKET_LENGTH_ERROR;
+        return ksfTkErrFail;
+    }
+
+    // The register address auto-increments after each big-endian word
+    for (size_t i = 0; i < length; i += sizeof(uint32_t), devReg++)
+        writeWord(devReg, ((uint32_t)data[i] << 24) | ((uint32_t)data[i + 1] << 16) | ((uint32_t)data[i + 2] << 8) |
+                              (uint32_t)data[i + 3]);
+
+    return ksfTkErrOk;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Sim::readRegister(uint8_t devReg, uint8_t *data, size_t numBytes, size_t &readBytes,
+                                        uint32_t read_delay)
+{
+    return readRegister((uint16_t)devReg, data, numBytes, readBytes, read_delay);
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Sim::readRegister(uint16_t devReg, uint8_t *data, size_t numBytes, size_t &readBytes,
+                                        uint32_t read_delay)
+{
+    (void)read_delay;
+
+    readBytes = 0;
+
+    if (data == nullptr)
+        return ksfTkErrFail;
+
+    update();
+    if (!responding())
+        return ksfTkErrFail;
+
+    _transfers++;
+
+    // Registers are whole big-endian words - the module rejects any other length
+    if (numBytes == 0 || numBytes % sizeof(uint32_t) != 0)
+    {
+        _protocolStatus |= SFE_XM125_SIM_PACKET_LENGTH_ERROR;
+        return ksfTkErrFail;
+    }
+
+    uint32_t value;
+
+    // The register address auto-increments after each big-endian word
+    for (; readBytes < numBytes; readBytes += sizeof(uint32_t), devReg++)
+    {
+        readWord(devReg, value);
+        data[readBytes] = (uint8_t)(value >> 24);
+        data[readBytes + 1] = (uint8_t)(value >> 16);
+        data[readBytes + 2] = (uint8_t)(value >> 8);
+        data[readBytes + 3] = (uint8_t)value;
+    }
+
+    return ksfTkErrOk;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file sfDevXM125Sim.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the header of a simulated XM125 module. The simulator implements the toolkit
+ * I2C bus interface and models the distance or presence application register map - the command
+ * register, busy and error bits in the detector status, the measure counter, the result registers
+ * and reset/apply semantics - so the library can be exercised without a module.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include "sfDevXM125Distance.h"
+#include "sfDevXM125Presence.h"
+
+// Application the simulated module runs
+typedef enum
+{
+    XM125_SIM_DISTANCE = 0,
+    XM125_SIM_PRESENCE = 1,
+} sfe_xm125_sim_app_t;
+
+// Time the simulated module stays busy for each operation, in milliseconds
+typedef struct
+{
+    uint32_t resetMs;     // RESET_MODULE
+    uint32_t applyMs;     // apply configuration
+    uint32_t calibrateMs; // distance calibration, added to applyMs for APPLY_CONFIG_AND_CALIBRATE
+    uint32_t measureMs;   // one distance measurement
+    uint32_t startMs;     // presence START_DETECTOR, before the first frame is measured
+    uint32_t wakeMs;      // WAKE_UP raised, before the module answers on the bus
+} sfe_xm125_sim_timing_t;
+
+const sfe_xm125_sim_timing_t SFE_XM125_SIM_TIMING_DEFAULT = {50, 20, 60, 20, 10, 5};
+
+// Version reported by the simulated application - 1.0.0
+const uint32_t SFE_XM125_SIM_VERSION = 0x00010000;
+
+// Protocol status bits set by the simulated module
+const uint32_t SFE_XM125_SIM_PROTOCOL_STATE_ERROR = 0x00000001;
+const uint32_t SFE_XM125_SIM_PACKET_LENGTH_ERROR = 0x00000002;
+const uint32_t SFE_XM125_SIM_ADDRESS_ERROR = 0x00000004;
+const uint32_t SFE_XM125_SIM_WRITE_FAILED = 0x00000008;
+const uint32_t SFE_XM125_SIM_WRITE_TO_READ_ONLY = 0x00000010;
+
+// Largest number of targets in a simulated distance scene
+const uint8_t SFE_XM125_SIM_MAX_TARGETS = 16;
+
+// Time source for the simulator - returns milliseconds
+typedef uint32_t (*sfe_xm125_sim_clock_t)(void);
+
+class sfDevXM125Sim : public sfTkII2C
+{
+  public:
+    /// @brief Creates a simulated module in its power on state
+    /// @param app Application the simulated module runs
+    sfDevXM125Sim(sfe_xm125_sim_app_t app = XM125_SIM_DISTANCE);
+
+    // Make the typed register helpers of the bus interface visible next to the overrides below
+    using sfTkIBus::readRegister;
+    using sfTkIBus::writeRegister;
+
+    /// @brief Checks if the simulated module responds
+    /// @return ksfTkErrOk if connected, ksfTkErrFail otherwise
+    sfTkError_t ping() override;
+
+    /// @brief Writes raw bytes - the first two bytes are the big-endian register address
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeData(const uint8_t *data, size_t length) override;
+
+    /// @brief Writes to a register - the module only has 16-bit addresses
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeRegister(uint8_t devReg, const uint8_t *data, size_t length) override;
+
+    /// @brief Writes big-endian register values, auto-incrementing the address after each word
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t writeRegister(uint16_t devReg, const uint8_t *data, size_t length) override;
+
+    /// @brief Reads from a register - the module only has 16-bit addresses
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readRegister(uint8_t devReg, uint8_t *data, size_t numBytes, size_t &readBytes,
+                             uint32_t read_delay = 0) override;
+
+    /// @brief Reads big-endian register values, auto-incrementing the address after each word
+    /// @return ksfTkErrOk on success, or error code (value < -1)
+    sfTkError_t readRegister(uint16_t devReg, uint8_t *data, size_t numBytes, size_t &readBytes,
+                             uint32_t read_delay = 0) override;
+
+    /// @brief Returns the module to its power on state, keeping the scene, timing and clock
+    void powerOn(void);
+
+    /// @brief Returns the application the simulated module runs
+    sfe_xm125_sim_app_t app(void)
+    {
+        return _app;
+    }
+
+    /// @brief Sets how long the simulated module stays busy for each operation
+    /// @param timing Operation times in milliseconds
+    void setTiming(const sfe_xm125_sim_timing_t &timing)
+    {
+        _timing = timing;
+    }
+
+    /// @brief Sets the time source of the simulator. Defaults to sftk_ticks_ms(); a host
+    ///  test can pass a virtual clock to run without real delays.
+    /// @param clock Function returning the current time in milliseconds
+    void setClock(sfe_xm125_sim_clock_t clock)
+    {
+        _clock = clock == nullptr ? sftk_ticks_ms : clock;
+    }
+
+    /// @brief Connects or disconnects the simulated module - when disconnected every transfer fails
+    /// @param connected True to respond on the bus
+    void setConnected(bool connected)
+    {
+        _connected = connected;
+    }
+
+    /// @brief Sets the objects seen by the distance detector. Objects outside the configured
+    ///  interval are not reported; the rest are sorted by the configured peak sorting.
+    /// @param distance Distance of each object in mm
+    /// @param strength Strength of each object (factor 1000 larger than RSS)
+    /// @param count Number of objects, up to SFE_XM125_SIM_MAX_TARGETS
+    void setTargets(const uint32_t *distance, const int32_t *strength, uint8_t count);
+
+    /// @brief Sets the motion seen by the presence detector
+    /// @param present True when someone is in the measured interval
+    /// @param distance Distance of the presence in mm
+    /// @param intraScore Fast motion score
+    /// @param interScore Slow motion score
+    void setPresence(bool present, uint32_t distance, uint32_t intraScore, uint32_t interScore);
+
+    /// @brief Sets the temperature reported in the result register
+    /// @param temperature Relative temperature
+    void setTemperature(int16_t temperature)
+    {
+        _temperature = temperature;
+    }
+
+    /// @brief Marks the distance calibration as outdated - measurements report calibration
+    ///  needed until the module is recalibrated
+    void requireCalibration(void)
+    {
+        _calibrationNeeded = true;
+    }
+
+    /// @brief Returns the level of the presence detection GPIO - high while presence is
+    ///  detected and detection on GPIO is enabled
+    bool gpioLevel(void);
+
+    /// @brief Drives the WAKE_UP pin. Low lets the module hibernate - it keeps its configuration
+    ///  and calibration but does not answer on the bus. High wakes it up; with measure on wakeup
+    ///  set, a calibrated distance detector measures right away.
+    /// @param level Pin level
+    void setWakeUp(bool level);
+
+    /// @brief Returns the level of the MCU_INT pin - high while the module is awake and ready,
+    ///  which includes having finished the measurement on wakeup
+    bool mcuIntLevel(void);
+
+    /// @brief Returns the number of measurements completed since power on
+    uint32_t measureCounter(void)
+    {
+        return _measureCounter;
+    }
+
+    /// @brief Returns the number of bus transfers handled since power on
+    uint32_t transfers(void)
+    {
+        return _transfers;
+    }
+
+  private:
+    // Operation the module is busy with
+    typedef enum
+    {
+        SIM_OP_NONE = 0,
+        SIM_OP_RESET,
+        SIM_OP_APPLY,
+        SIM_OP_APPLY_CALIBRATE,
+        SIM_OP_CALIBRATE,
+        SIM_OP_MEASURE,
+        SIM_OP_START,
+    } sim_op_t;
+
+    uint32_t now(void)
+    {
+        return _clock();
+    }
+
+    bool busy(void)
+    {
+        return _op != SIM_OP_NONE;
+    }
+
+    bool responding(void);
+
+    void setDefaultConfig(void);
+    uint8_t configRegs(void);
+    uint32_t resultRegs(void);
+    bool configValid(void);
+    uint32_t configValue(uint16_t devReg);
+
+    void update(void);
+    void beginOp(sim_op_t op, uint32_t durationMs);
+    void completeOp(void);
+    void runCommand(uint32_t command);
+    void measureDistance(void);
+    void measurePresence(void);
+    uint32_t framePeriodMs(void);
+
+    bool readWord(uint16_t devReg, uint32_t &value);
+    void writeWord(uint16_t devReg, uint32_t value);
+
+    sfe_xm125_sim_app_t _app;
+    sfe_xm125_sim_timing_t _timing;
+    sfe_xm125_sim_clock_t _clock;
+    bool _connected;
+    bool _awake;
+    bool _waking;
+    uint32_t _wakeDoneMs;
+
+    // device registers
+    uint32_t _protocolStatus;
+    uint32_t _measureCounter;
+    uint32_t _detectorStatus;
+    uint32_t _result[1 + SFE_XM125_DISTANCE_MAX_PEAKS * 2];
+    uint32_t _config[SFE_XM125_SHADOW_BLOCK_MAX];
+    uint32_t _configExtra;
+
+    // device state
+    sim_op_t _op;
+    uint32_t _opDoneMs;
+    bool _applied;
+    bool _calibrated;
+    bool _calibrationNeeded;
+    bool _running;
+    uint32_t _nextFrameMs;
+    uint32_t _transfers;
+
+    // scene
+    uint32_t _targetDistance[SFE_XM125_SIM_MAX_TARGETS];
+    int32_t _targetStrength[SFE_XM125_SIM_MAX_TARGETS];
+    uint8_t _nTargets;
+    bool _present;
+    uint32_t _presenceDistance;
+    uint32_t _intraScore;
+    uint32_t _interScore;
+    int16_t _temperature;
+};
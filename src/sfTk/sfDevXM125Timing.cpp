@@ -0,0 +1,158 @@
+/**
+ * @file sfDevXM125Timing.cpp
+ * @brief Implementation of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains the implementation of the A121 sensor timing model. The constants are the
+ * approximate values of the timing chapter of the A121 handbook.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include "sfDevXM125Timing.h"
+#include "sfDevXM125Core.h"
+
+// Sample duration and point overhead in ns, for profile 1, 2 and 3 - 5 (rows) and each PRF (columns,
+// 19.5MHz to 5.2MHz). 0 marks a combination the sensor does not support.
+static const uint16_t kSampleNs[3][6] = {
+    {1487, 1795, 2103, 3026, 3949, 4872},
+    {0, 1344, 1600, 2369, 3138, 3908},
+    {0, 1026, 1231, 1846, 2462, 3077},
+};
+static const uint16_t kPointOverheadNs[3][6] = {
+    {1744, 2102, 2462, 3539, 4615, 5692},
+    {0, 1612, 1920, 2844, 3766, 4689},
+    {0, 1282, 1539, 2308, 3077, 3846},
+};
+
+// Farthest interval end of each PRF in mm
+static const uint16_t kMaxDistanceMm[6] = {3100, 5100, 7000, 12700, 18500, 24300};
+
+// Time to go from one idle state (row) to another (column) in us - deep sleep, sleep, ready
+static const uint16_t kIdleTransitionUs[3][3] = {
+    {0, 615, 670},
+    {0, 0, 55},
+    {0, 0, 0},
+};
+
+// Fixed subsweep, sweep and frame overheads in us, in normal and in high speed mode
+static const uint16_t kSubsweepOverheadUs[2] = {22, 0};
+static const uint16_t kSweepOverheadUs[2] = {10, 0};
+static const uint16_t kFrameOverheadUs[2] = {4, 36};
+
+//--------------------------------------------------------------------------------
+void sfDevXM125Timing::defaultConfig(sfe_xm125_timing_config_t &config)
+{
+    config.start = 250;
+    config.end = 3000;
+    config.profile = 3;
+    config.prf = XM125_PRF_AUTO;
+    config.step_length = 0;
+    config.hwaas = 8;
+    config.sweeps_per_frame = 1;
+    config.sweep_rate = 0;
+    config.frame_rate = 0;
+    config.inter_frame_idle = XM125_IDLE_DEEP_SLEEP;
+    config.inter_sweep_idle = XM125_IDLE_READY;
+    config.processing_us = 0;
+}
+
+//--------------------------------------------------------------------------------
+uint32_t sfDevXM125Timing::maxDistanceMm(uint8_t prf)
+{
+    if (prf < XM125_PRF_19_5_MHZ || prf > XM125_PRF_5_2_MHZ)
+        return 0;
+
+    return kMaxDistanceMm[prf - XM125_PRF_19_5_MHZ];
+}
+
+//--------------------------------------------------------------------------------
+uint8_t sfDevXM125Timing::selectPrf(uint8_t profile, uint32_t endMm)
+{
+    // 19.5MHz is only available with profile 1
+    uint8_t prf = profile == 1 ? XM125_PRF_19_5_MHZ : XM125_PRF_15_6_MHZ;
+
+    for (; prf <= XM125_PRF_5_2_MHZ; prf++)
+    {
+        if (endMm <= maxDistanceMm(prf))
+            return prf;
+    }
+
+    return XM125_PRF_AUTO;
+}
+
+//--------------------------------------------------------------------------------
+sfTkError_t sfDevXM125Timing::estimate(const sfe_xm125_timing_config_t &config, sfe_xm125_timing_t &timing)
+{
+    if (config.profile < 1 || config.profile > 5 || config.hwaas == 0 || config.hwaas > SFE_XM125_HWAAS_MAX ||
+        config.sweeps_per_frame == 0 || config.end < config.start)
+        return ksfTkErrFail;
+
+    // The sensor idles at least as deep between frames as between sweeps
+    if (config.inter_sweep_idle > XM125_IDLE_READY || config.inter_frame_idle > config.inter_sweep_idle)
+        return ksfTkErrFail;
+
+    uint8_t prf = config.prf == XM125_PRF_AUTO ? selectPrf(config.profile, config.end) : config.prf;
+    if (config.end > maxDistanceMm(prf))
+        return ksfTkErrFail;
+
+    uint8_t row = config.profile < 3 ? config.profile - 1 : 2;
+    uint8_t column = prf - XM125_PRF_19_5_MHZ;
+    if (kSampleNs[row][column] == 0)
+        return ksfTkErrFail;
+
+    // High speed mode needs profile 3 - 5 and the ready state between sweeps - one subsweep and no
+    // continuous sweep mode always hold here
+    bool highSpeed = config.profile >= 3 && config.inter_sweep_idle == XM125_IDLE_READY;
+
+    timing.prf = prf;
+    timing.high_speed = highSpeed;
+    timing.step_length = config.step_length > 0 ? config.step_length : SFE_XM125_AUTO_STEP_LENGTH[config.profile - 1];
+    timing.points = (config.end - config.start) * 1000 / (SFE_XM125_POINT_SPACING_UM * timing.step_length) + 1;
+    timing.sample_ns = kSampleNs[row][column];
+    timing.point_ns = config.hwaas * timing.sample_ns + kPointOverheadNs[row][column];
+
+    uint64_t subsweepNs = (uint64_t)timing.points * timing.point_ns + 3 * timing.sample_ns;
+    uint64_t sweepUs = kIdleTransitionUs[config.inter_sweep_idle][XM125_IDLE_READY] + (subsweepNs + 999) / 1000 +
+                       kSubsweepOverheadUs[highSpeed] + kSweepOverheadUs[highSpeed];
+
+    bool rateMissed = false;
+
+    // A sweep rate makes the sensor idle between sweeps
+    uint64_t sweepPeriodUs = sweepUs;
+    if (config.sweep_rate > 0)
+    {
+        uint64_t periodUs = 1000000000ULL / config.sweep_rate;
+        if (periodUs < sweepUs)
+            rateMissed = true;
+        else
+            sweepPeriodUs = periodUs;
+    }
+
+    uint64_t frameUs = kIdleTransitionUs[config.inter_frame_idle][config.inter_sweep_idle] +
+                       (config.sweeps_per_frame - 1) * sweepPeriodUs + sweepUs + kFrameOverheadUs[highSpeed];
+
+    // The next frame can start once this one is measured and processed
+    uint64_t busyUs = frameUs + config.processing_us;
+
+    uint64_t framePeriodUs = busyUs;
+    if (config.frame_rate > 0)
+    {
+        uint64_t periodUs = 1000000000ULL / config.frame_rate;
+        if (periodUs < busyUs)
+            rateMissed = true;
+        else
+            framePeriodUs = periodUs;
+    }
+
+    timing.sweep_us = (uint32_t)sweepUs;
+    timing.sweep_period_us = (uint32_t)sweepPeriodUs;
+    timing.frame_us = frameUs > UINT32_MAX ? UINT32_MAX : (uint32_t)frameUs;
+    timing.frame_period_us = framePeriodUs > UINT32_MAX ? UINT32_MAX : (uint32_t)framePeriodUs;
+    timing.max_frame_rate = (uint32_t)(1000000000ULL / (busyUs > 0 ? busyUs : 1));
+    timing.duty_cycle_permille = (uint16_t)(frameUs * 1000 / framePeriodUs);
+
+    return rateMissed ? ksfTkErrXM125Timing : ksfTkErrOk;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file sfDevXM125Timing.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains a host side model of the A121 sensor timing, following the timing chapter of
+ * the Acconeer A121 handbook. From the profile, PRF, HWAAS, step length, sweeps per frame, rates
+ * and idle states it estimates the sample, point, sweep and frame durations, the highest frame rate
+ * the sensor can reach and its measuring duty cycle - so a configuration can be checked before it
+ * is applied:
+ *
+ *     t_point    = HWAAS * t_sample + t_point_overhead
+ *     t_subsweep = points * t_point + 3 * t_sample + C_subsweep
+ *     t_sweep    = t_sweep_idle->ready + t_subsweep + C_sweep
+ *     t_frame    = t_frame_idle->sweep_idle + (sweeps - 1) * T_sweep + t_sweep + C_frame
+ *
+ * The handbook gives these as approximations. The detectors on the module add their own processing
+ * and choose some settings themselves, so treat the results as estimates.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <sfTk/sfToolkit.h>
+
+// Distance points are 2.5mm apart, times the step length
+const uint32_t SFE_XM125_POINT_SPACING_UM = 2500;
+
+// Step length used by the automatic step length selection for profiles 1 - 5
+const uint8_t SFE_XM125_AUTO_STEP_LENGTH[5] = {4, 6, 12, 24, 24};
+
+// Largest HWAAS the sensor accepts
+const uint16_t SFE_XM125_HWAAS_MAX = 511;
+
+// Pulse repetition frequency of the sensor. A lower PRF reaches further, but each sample takes longer.
+typedef enum
+{
+    XM125_PRF_AUTO = 0,     // highest PRF that reaches the end of the interval - how the detectors pick it
+    XM125_PRF_19_5_MHZ = 1, // profile 1 only, up to 3.1m
+    XM125_PRF_15_6_MHZ = 2, // up to 5.1m
+    XM125_PRF_13_0_MHZ = 3, // up to 7.0m
+    XM125_PRF_8_7_MHZ = 4,  // up to 12.7m
+    XM125_PRF_6_5_MHZ = 5,  // up to 18.5m
+    XM125_PRF_5_2_MHZ = 6,  // up to 24.3m
+} sfe_xm125_prf_t;
+
+// State the sensor idles in between sweeps or frames - deeper states save power, but take longer to leave
+typedef enum
+{
+    XM125_IDLE_DEEP_SLEEP = 0,
+    XM125_IDLE_SLEEP = 1,
+    XM125_IDLE_READY = 2,
+} sfe_xm125_idle_state_t;
+
+// Sensor settings the timing depends on. Rates are in mHz, like the presence frame rate register.
+typedef struct
+{
+    uint32_t start;            // start of measured interval in mm
+    uint32_t end;              // end of measured interval in mm
+    uint8_t profile;           // profile 1 - 5
+    uint8_t prf;               // sfe_xm125_prf_t
+    uint16_t step_length;      // step length in points, 0 for the automatic step length of the profile
+    uint16_t hwaas;            // hardware accelerated average samples, 1 - 511
+    uint16_t sweeps_per_frame; // sweeps per frame
+    uint32_t sweep_rate;       // sweep rate in mHz, 0 for as fast as possible
+    uint32_t frame_rate;       // frame rate in mHz, 0 for as fast as the host starts them
+    uint8_t inter_frame_idle;  // sfe_xm125_idle_state_t between frames
+    uint8_t inter_sweep_idle;  // sfe_xm125_idle_state_t between sweeps, not deeper than between frames
+    uint32_t processing_us;    // processing on the module before a frame can be read
+} sfe_xm125_timing_config_t;
+
+// Estimated timing of a configuration. Durations are in microseconds.
+typedef struct
+{
+    uint8_t prf;                  // PRF used (sfe_xm125_prf_t)
+    uint16_t step_length;         // step length used
+    uint32_t points;              // distance points per sweep
+    uint32_t sample_ns;           // duration of one sample in ns
+    uint32_t point_ns;            // duration of one point, all HWAAS samples, in ns
+    uint32_t sweep_us;            // duration of one sweep
+    uint32_t sweep_period_us;     // time between the start of two sweeps in a frame
+    uint32_t frame_us;            // duration of a frame, from leaving the idle state to the last sweep
+    uint32_t frame_period_us;     // time between the start of two frames
+    uint32_t max_frame_rate;      // highest frame rate the configuration reaches, in mHz
+    uint16_t duty_cycle_permille; // share of the frame period the sensor is measuring, in 1/1000
+    bool high_speed;              // the sensor runs in high speed mode
+} sfe_xm125_timing_t;
+
+class sfDevXM125Timing
+{
+  public:
+    /// @brief Fills a timing configuration with the sensor defaults - profile 3, automatic PRF and
+    ///  step length, 8 HWAAS, one sweep per frame, no rates, deep sleep between frames and ready
+    ///  between sweeps
+    /// @param config Configuration to fill
+    static void defaultConfig(sfe_xm125_timing_config_t &config);
+
+    /// @brief Estimates the timing of a configuration
+    /// @param config Sensor settings
+    /// @param timing Estimated timing - filled whenever the configuration is valid
+    /// @return ksfTkErrOk on success, ksfTkErrXM125Timing when the requested frame or sweep rate
+    ///  can not be reached - see timing.max_frame_rate - or ksfTkErrFail for an invalid configuration
+    static sfTkError_t estimate(const sfe_xm125_timing_config_t &config, sfe_xm125_timing_t &timing);
+
+    /// @brief Returns the farthest interval end a PRF reaches, in mm
+    /// @param prf PRF - XM125_PRF_19_5_MHZ to XM125_PRF_5_2_MHZ
+    static uint32_t maxDistanceMm(uint8_t prf);
+
+    /// @brief Returns the highest PRF that reaches the end of an interval with a profile
+    /// @param profile Profile 1 - 5
+    /// @param endMm End of the interval in mm
+    /// @return The PRF, or XM125_PRF_AUTO when no PRF reaches that far
+    static uint8_t selectPrf(uint8_t profile, uint32_t endMm);
+};
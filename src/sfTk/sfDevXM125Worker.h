@@ -0,0 +1,189 @@
+/**
+ * @file sfDevXM125Worker.h
+ * @brief Header of the SparkFun Qwiic XM125  Library.
+ *
+ * This file contains an acquisition worker that decouples reading an XM125 from using its results,
+ * for dual core parts like the ESP32 and RP2040. One core runs the acquisition loop and is the only
+ * one to touch the bus; the other core takes the frames without locks or waiting:
+ *
+ *     sfDevXM125Worker<sfDevXM125Distance, sfe_xm125_distance_frame_t, 8> worker;
+ *     worker.init(radarSensor);
+ *
+ *     // acquisition core
+ *     for (;;)
+ *         worker.acquire();
+ *
+ *     // application core - every frame, in order
+ *     while (worker.pop(frame)) ...
+ *
+ *     // or only the newest frame
+ *     if (worker.latest(frame)) ...
+ *
+ * Frames are published both through a lock free queue and a seqlock snapshot. A consumer uses one
+ * of them: the queue when it must see every frame, the snapshot when it only cares about the newest.
+ * Both are exercised by threads on a host in tools/xm125_stress.
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "sfDevXM125Atomic.h"
+#include "sfDevXM125Distance.h"
+#include "sfDevXM125Presence.h"
+#include "sfDevXM125RingBuffer.h"
+
+/// @brief Acquisition worker. TDevice and TFrame are sfDevXM125Distance with
+///  sfe_xm125_distance_frame_t, or sfDevXM125Presence with sfe_xm125_presence_frame_t. N is the
+///  queue length, a power of two no larger than 128. acquire() is called from one context, the
+///  consumer methods from one other context; the statistics can be read from any context. The
+///  counters wrap at the width of sfe_xm125_atomic_word_t, which is a single byte on AVR.
+template <class TDevice, class TFrame, uint8_t N> class sfDevXM125Worker
+{
+  public:
+    sfDevXM125Worker() : _device{nullptr}
+    {
+    }
+
+    /// @brief Sets the module to acquire from. It must be set up - started for continuous
+    ///  measurements in the case of the presence detector - and is then only accessed by acquire().
+    /// @param device The module
+    void init(TDevice &device)
+    {
+        _device = &device;
+    }
+
+    /// @brief Acquisition - acquires one frame, if available, and publishes it. For the distance
+    ///  detector this runs a full measurement; for the presence detector it reads the next frame of
+    ///  the continuous measurements when there is one.
+    /// @return ksfTkErrOk on success - also when there was no new frame - ksfTkErrXM125Detector when
+    ///  a distance measurement failed, or error code (value < -1)
+    sfTkError_t acquire(void)
+    {
+        if (_device == nullptr)
+            return ksfTkErrFail;
+
+        bool newFrame = false;
+        sfTkError_t retVal = read(*_device, _frame, newFrame);
+
+        _lastError.write(retVal);
+        if (retVal != ksfTkErrOk)
+        {
+            _errors.store(_errors.loadRelaxed() + 1);
+            return retVal;
+        }
+
+        if (newFrame)
+        {
+            _queue.push(_frame);
+            _latest.write(_frame);
+            _published.store(1);
+        }
+
+        return ksfTkErrOk;
+    }
+
+    /// @brief Consumer - copies and removes the oldest queued frame
+    /// @param frame Copy of the frame
+    /// @return true if a frame was removed
+    bool pop(TFrame &frame)
+    {
+        return _queue.pop(frame);
+    }
+
+    /// @brief Consumer - returns the oldest queued frames that are stored consecutively, without
+    ///  copying them. Release them with consume().
+    sfDevXM125Span<const TFrame> peek(void)
+    {
+        return _queue.peek();
+    }
+
+    /// @brief Consumer - removes the oldest queued frames
+    /// @param count Number of frames to remove
+    void consume(uint8_t count)
+    {
+        _queue.consume(count);
+    }
+
+    /// @brief Consumer - returns the number of queued frames
+    uint8_t available(void)
+    {
+        return _queue.size();
+    }
+
+    /// @brief Consumer - copies the newest frame, whether or not it was taken from the queue
+    /// @param frame Copy of the frame
+    /// @return true if frame holds a frame, false if none was published yet or the acquisition
+    ///  side kept replacing it while it was copied
+    bool latest(TFrame &frame)
+    {
+        return _published.load() != 0 && _latest.read(frame);
+    }
+
+    /// @brief Returns the number of frames published, wrapping around - compare to the value at
+    ///  the last read to tell whether there is a new frame
+    sfe_xm125_atomic_word_t published(void)
+    {
+        return _latest.version();
+    }
+
+    /// @brief Returns the number of frames that did not fit in the queue, wrapping around. They
+    ///  were still published as the newest frame.
+    sfe_xm125_atomic_word_t dropped(void)
+    {
+        return _queue.dropped();
+    }
+
+    /// @brief Returns the number of failed acquisitions, wrapping around
+    sfe_xm125_atomic_word_t errors(void)
+    {
+        return _errors.load();
+    }
+
+    /// @brief Returns the result of the last acquisition, or ksfTkErrXM125Busy when it is being
+    ///  stored - only seen from a context that interrupts acquire() on the same core
+    sfTkError_t lastError(void)
+    {
+        sfTkError_t error;
+        return _lastError.read(error) ? error : ksfTkErrXM125Busy;
+    }
+
+  private:
+    // Distance - each acquisition is one measurement. detectorReadingSetup() returns the step that
+    // failed, a positive value.
+    static sfTkError_t read(sfDevXM125Distance &device, sfe_xm125_distance_frame_t &frame, bool &newFrame)
+    {
+        if (device.detectorReadingSetup() != 0)
+            return ksfTkErrXM125Detector;
+
+        sfTkError_t retVal = device.readFrame(frame);
+        newFrame = retVal == ksfTkErrOk;
+        return retVal;
+    }
+
+    // Presence - the detector measures continuously, only new frames are published
+    static sfTkError_t read(sfDevXM125Presence &device, sfe_xm125_presence_frame_t &frame, bool &newFrame)
+    {
+        return device.readStream(frame, newFrame);
+    }
+
+    TDevice *_device;
+
+    // Acquired frame - only used by the acquisition side
+    TFrame _frame;
+
+    sfDevXM125SpscRingBuffer<TFrame, N> _queue;
+    sfDevXM125Seqlock<TFrame> _latest;
+
+    // Set by the first published frame - the snapshot version wraps around to 0
+    sfDevXM125Atomic<uint8_t> _published;
+    sfDevXM125Atomic<sfe_xm125_atomic_word_t> _errors;
+
+    // An error code is wider than the atomic word of AVR parts
+    sfDevXM125Seqlock<sfTkError_t> _lastError;
+};
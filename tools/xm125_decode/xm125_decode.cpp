@@ -0,0 +1,184 @@
+/**
+ * @file xm125_decode.cpp
+ * @brief Host decoder for the SparkFun Qwiic XM125  Library packet stream.
+ *
+ * Reads the packet stream written by sfDevXM125PacketEncoder (see Example12_DistanceBinaryStream)
+ * from stdin and prints one CSV line per frame to stdout. The decoder statistics are printed to
+ * stderr at the end of the stream.
+ *
+ * With --test, it instead checks the decoder against streams built in memory - clean, and with a
+ * corrupted length byte - and exits with status 1 if any check failed.
+ *
+ * Build on the host from this directory:
+ *
+ *     g++ -O2 -I../../src/sfTk -o xm125_decode xm125_decode.cpp ../../src/sfTk/sfDevXM125Packet.cpp
+ *
+ * Usage:
+ *
+ *     stty -F /dev/ttyACM0 921600 raw && ./xm125_decode < /dev/ttyACM0
+ *     ./xm125_decode --test
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "sfDevXM125Packet.h"
+
+//--------------------------------------------------------------------------------
+static void printDistance(const sfe_xm125_packet_frame_t &frame)
+{
+    printf("distance,%lu,%lu,%d,0x%02x,%u", (unsigned long)frame.measure_counter, (unsigned long)frame.timestamp,
+           frame.temperature, frame.flags, frame.num_peaks);
+
+    for (uint8_t i = 0; i < frame.num_peaks; i++)
+        printf(",%u,%.2f", frame.distance[i], frame.strength[i] / 100.0);
+
+    printf("\n");
+}
+
+//--------------------------------------------------------------------------------
+static void printPresence(const sfe_xm125_packet_frame_t &frame)
+{
+    printf("presence,%lu,%lu,%d,0x%02x,%lu,%lu,%lu\n", (unsigned long)frame.measure_counter,
+           (unsigned long)frame.timestamp, frame.temperature, frame.flags, (unsigned long)frame.presence_distance,
+           (unsigned long)frame.intra_score, (unsigned long)frame.inter_score);
+}
+
+//--------------------------------------------------------------------------------
+// Writes a distance packet with two peaks, numbered by its measure counter
+static size_t writeDistance(uint8_t *buffer, size_t size, uint32_t counter)
+{
+    sfDevXM125PacketWriter writer;
+    writer.begin(buffer, size, SFE_XM125_PACKET_TYPE_DISTANCE);
+    writer.putVarint(counter);
+    writer.putVarint(counter * 100);
+    writer.putSigned(-5);
+    writer.putByte(0);
+    writer.putByte(2);
+    writer.putVarint(1200);
+    writer.putSigned(350);
+    writer.putSigned(-1520);
+    writer.putSigned(-2380);
+
+    return writer.end();
+}
+
+//--------------------------------------------------------------------------------
+// Writes a presence packet, numbered by its measure counter
+static size_t writePresence(uint8_t *buffer, size_t size, uint32_t counter)
+{
+    sfDevXM125PacketWriter writer;
+    writer.begin(buffer, size, SFE_XM125_PACKET_TYPE_PRESENCE);
+    writer.putVarint(counter);
+    writer.putVarint(counter * 100);
+    writer.putByte(SFE_XM125_PACKET_PRESENCE_DETECTED);
+    writer.putSigned(-5);
+    writer.putVarint(900);
+    writer.putVarint(1500);
+    writer.putVarint(700);
+
+    return writer.end();
+}
+
+//--------------------------------------------------------------------------------
+// Feeds a stream of packets 1 to 4, with the length of packet 1 replaced when length is not negative.
+// Packets 2 to 4 must be decoded whole, and packet 1 only when its length is intact.
+static bool checkStream(const char *name, int length)
+{
+    uint8_t stream[4 * SFE_XM125_PACKET_DISTANCE_MAX_PACKET];
+    size_t size = 0;
+
+    for (uint32_t counter = 1; counter <= 4; counter++)
+    {
+        if (counter % 2 != 0)
+            size += writeDistance(&stream[size], sizeof(stream) - size, counter);
+        else
+            size += writePresence(&stream[size], sizeof(stream) - size, counter);
+    }
+
+    if (length >= 0)
+        stream[3] = (uint8_t)length;
+
+    sfDevXM125PacketDecoder decoder;
+    uint32_t expected = length >= 0 ? 2 : 1;
+    bool passed = true;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        if (!decoder.feed(stream[i]))
+            continue;
+
+        const sfe_xm125_packet_frame_t &frame = decoder.frame();
+        uint8_t type = frame.measure_counter % 2 != 0 ? SFE_XM125_PACKET_TYPE_DISTANCE : SFE_XM125_PACKET_TYPE_PRESENCE;
+
+        passed = passed && frame.measure_counter == expected && frame.type == type &&
+                 frame.timestamp == expected * 100 && frame.temperature == -5;
+        if (type == SFE_XM125_PACKET_TYPE_DISTANCE)
+            passed = passed && frame.num_peaks == 2 && frame.distance[0] == 1200 && frame.distance[1] == 1550 &&
+                     frame.strength[0] == -1520 && frame.strength[1] == -2380;
+        else
+            passed = passed && frame.presence_distance == 900 && frame.intra_score == 1500 && frame.inter_score == 700;
+
+        expected++;
+    }
+
+    uint32_t errors = decoder.crcErrors() + decoder.formatErrors();
+    passed = passed && expected == 5 && errors == (length >= 0 ? 1u : 0u);
+
+    printf("%-16s %lu frames, %lu crc errors, %lu format errors - %s\n", name, (unsigned long)decoder.frames(),
+           (unsigned long)decoder.crcErrors(), (unsigned long)decoder.formatErrors(), passed ? "ok" : "FAILED");
+
+    return passed;
+}
+
+//--------------------------------------------------------------------------------
+static bool selfTest(void)
+{
+    uint8_t packet[SFE_XM125_PACKET_DISTANCE_MAX_PACKET];
+    int length = (int)writeDistance(packet, sizeof(packet), 1);
+    length -= SFE_XM125_PACKET_HEADER_SIZE + SFE_XM125_PACKET_CRC_SIZE;
+
+    // Longer than the packet, swallowing the next one before the CRC fails; shorter; and longer than
+    // a distance payload can be
+    bool passed = checkStream("clean:", -1);
+    passed = checkStream("length longer:", length + 20) && passed;
+    passed = checkStream("length shorter:", length - 3) && passed;
+    passed = checkStream("length invalid:", 0xff) && passed;
+
+    return passed;
+}
+
+//--------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    if (argc > 1 && strcmp(argv[1], "--test") == 0)
+        return selfTest() ? 0 : 1;
+
+    sfDevXM125PacketDecoder decoder;
+    int c;
+
+    while ((c = getchar()) != EOF)
+    {
+        if (!decoder.feed((uint8_t)c))
+            continue;
+
+        const sfe_xm125_packet_frame_t &frame = decoder.frame();
+        if (frame.type == SFE_XM125_PACKET_TYPE_DISTANCE)
+            printDistance(frame);
+        else
+            printPresence(frame);
+
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "frames: %lu, crc errors: %lu, format errors: %lu, skipped bytes: %lu\n",
+            (unsigned long)decoder.frames(), (unsigned long)decoder.crcErrors(),
+            (unsigned long)decoder.formatErrors(), (unsigned long)decoder.skippedBytes());
+
+    return 0;
+}
@@ -0,0 +1,272 @@
+/**
+ * @file xm125_sim.cpp
+ * @brief Host run of the SparkFun Qwiic XM125  Library against the simulated module.
+ *
+ * Sets up the distance and the presence detector of the library on sfDevXM125Sim and checks the
+ * values read back against the simulated scene, then runs several simulated modules through the
+ * manager (sfDevXM125Manager.h) and the scheduler (sfDevXM125Scheduler.h). The toolkit platform
+ * functions are defined below on a virtual clock, so delays take no time and the run does not need
+ * a board - only the headers of the SparkFun Toolkit.
+ *
+ * The results are printed to stdout. The exit status is 1 if any check failed.
+ *
+ * Build on the host from this directory, with TOOLKIT the path of the SparkFun Toolkit library:
+ *
+ *     g++ -O2 -I$TOOLKIT/src -I../../src/sfTk -o xm125_sim xm125_sim.cpp ../../src/sfTk/sfDevXM125Core.cpp \
+ *         ../../src/sfTk/sfDevXM125Distance.cpp ../../src/sfTk/sfDevXM125Presence.cpp \
+ *         ../../src/sfTk/sfDevXM125Timing.cpp ../../src/sfTk/sfDevXM125Sim.cpp
+ *
+ * Usage:
+ *
+ *     ./xm125_sim
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stdio.h>
+
+#include "sfDevXM125Manager.h"
+#include "sfDevXM125Scheduler.h"
+#include "sfDevXM125Sim.h"
+
+// Simulated time the multi module checks run for
+static const uint32_t kRunMs = 2000;
+
+// Virtual time of the run in ms - advanced by the delays of the library only
+static uint32_t virtualMs = 0;
+
+//--------------------------------------------------------------------------------
+// Toolkit platform functions on the virtual clock
+sfTkByteOrder sftk_system_byteorder(void)
+{
+    const uint16_t one = 1;
+    return *(const uint8_t *)&one == 1 ? sfTkByteOrder::LittleEndian : sfTkByteOrder::BigEndian;
+}
+
+//--------------------------------------------------------------------------------
+void sftk_delay_ms(uint32_t ms)
+{
+    virtualMs += ms;
+}
+
+//--------------------------------------------------------------------------------
+uint32_t sftk_ticks_ms(void)
+{
+    return virtualMs;
+}
+
+//--------------------------------------------------------------------------------
+// Two objects inside a 250 - 3000 mm interval and one outside it. The detector must report the two
+// inside, strongest first.
+static bool checkDistance(void)
+{
+    const uint32_t distance[] = {800, 1500, 4000};
+    const int32_t strength[] = {-2000, 3000, 5000};
+
+    sfDevXM125Sim sim(XM125_SIM_DISTANCE);
+    sim.setTargets(distance, strength, 3);
+
+    sfDevXM125Distance device;
+    sfTkError_t error = device.begin(&sim);
+    if (error == ksfTkErrOk)
+        error = device.distanceSetup(250, 3000);
+
+    bool passed = error == ksfTkErrOk;
+    uint32_t count = 0;
+    sfe_xm125_distance_peaks_t peaks = {};
+
+    for (uint8_t frame = 0; passed && frame < 3; frame++)
+    {
+        passed = device.detectorReadingSetup() == ksfTkErrOk && device.getNumberDistances(count) == ksfTkErrOk &&
+                 device.readPeaks(peaks) == ksfTkErrOk;
+
+        passed = passed && count == 2 && peaks.distance[0] == 1500 && peaks.strength[0] == 3000 &&
+                 peaks.distance[1] == 800 && peaks.strength[1] == -2000;
+    }
+
+    printf("distance: setup %ld, %lu peaks, nearest %lu mm, %lu measurements - %s\n", (long)error,
+           (unsigned long)count, (unsigned long)peaks.distance[0], (unsigned long)sim.measureCounter(),
+           passed ? "ok" : "FAILED");
+
+    return passed;
+}
+
+//--------------------------------------------------------------------------------
+// Someone at 1200 mm, then nobody. Each getDistanceValuemm() runs the detector for a frame.
+static bool checkPresence(void)
+{
+    sfDevXM125Sim sim(XM125_SIM_PRESENCE);
+    sim.setPresence(true, 1200, 1500, 900);
+
+    sfDevXM125Presence device;
+    sfTkError_t error = device.begin(&sim);
+    if (error == ksfTkErrOk)
+        error = device.detectorStart(300, 2500);
+
+    uint32_t distance = 0;
+    uint32_t detected = 0;
+    bool passed = error == ksfTkErrOk && device.getDistanceValuemm(distance) == ksfTkErrOk &&
+                  device.getDetectorPresenceDetected(detected) == ksfTkErrOk && distance == 1200 && detected == 1;
+
+    uint32_t absent = 1;
+    sim.setPresence(false, 0, 0, 0);
+    passed = passed && device.getDistanceValuemm(absent) == ksfTkErrOk && absent == 0;
+
+    printf("presence: start %ld, detected %lu at %lu mm, then at %lu mm, %lu frames - %s\n", (long)error,
+           (unsigned long)detected, (unsigned long)distance, (unsigned long)absent,
+           (unsigned long)sim.measureCounter(), passed ? "ok" : "FAILED");
+
+    return passed;
+}
+
+//--------------------------------------------------------------------------------
+// Counts the frames read out of each module, and the readouts that did not see the scene
+typedef struct
+{
+    uint32_t frames[2];
+    uint32_t wrong;
+} readouts_t;
+
+//--------------------------------------------------------------------------------
+static void readDistance(uint8_t index, sfDevXM125Distance &device, void *user)
+{
+    readouts_t &readouts = *(readouts_t *)user;
+    uint32_t distance = 0;
+
+    readouts.frames[index]++;
+    if (device.getPeak0Distance(distance) != ksfTkErrOk || distance != 1000u + 500u * index)
+        readouts.wrong++;
+}
+
+//--------------------------------------------------------------------------------
+static void readPresence(uint8_t index, sfDevXM125Presence &device, void *user)
+{
+    readouts_t &readouts = *(readouts_t *)user;
+    uint32_t detected = 0;
+
+    readouts.frames[index]++;
+    if (device.getDetectorPresenceDetected(detected) != ksfTkErrOk || detected != 1)
+        readouts.wrong++;
+}
+
+//--------------------------------------------------------------------------------
+// Passes the simulated time to the modules while service() is called, for kRunMs
+template <class TDrivers, class TCallback> static void run(TDrivers &drivers, TCallback callback, readouts_t &readouts)
+{
+    uint32_t startMs = sftk_ticks_ms();
+
+    while (sftk_ticks_ms() - startMs < kRunMs)
+    {
+        drivers.service(callback, &readouts);
+        sftk_delay_ms(1);
+    }
+}
+
+//--------------------------------------------------------------------------------
+// Two distance modules, each with an object at its own distance, measured as a pipeline
+static bool checkManager(void)
+{
+    sfDevXM125Sim sims[2];
+    sfDevXM125Manager<sfDevXM125Distance, 2> manager;
+    readouts_t readouts = {};
+    bool passed = true;
+
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        const uint32_t distance = 1000u + 500u * i;
+        const int32_t strength = 4000;
+        sims[i].setTargets(&distance, &strength, 1);
+
+        uint8_t index;
+        passed = passed && manager.addSensor(&sims[i], index) == ksfTkErrOk && index == i &&
+                 manager.sensor(i).distanceSetup(500, 3000) == ksfTkErrOk;
+    }
+
+    passed = passed && manager.startAll() == ksfTkErrOk;
+    if (passed)
+        run(manager, readDistance, readouts);
+
+    passed = passed && readouts.frames[0] > 0 && readouts.frames[1] > 0 && readouts.wrong == 0 &&
+             manager.lastError(0) == ksfTkErrOk && manager.lastError(1) == ksfTkErrOk;
+
+    printf("manager:  %lu and %lu distance frames, %lu wrong - %s\n", (unsigned long)readouts.frames[0],
+           (unsigned long)readouts.frames[1], (unsigned long)readouts.wrong, passed ? "ok" : "FAILED");
+
+    return passed;
+}
+
+//--------------------------------------------------------------------------------
+// One scheduler for two distance modules, started after each frame, and one for two free running
+// presence modules, read on their measure counter
+static bool checkScheduler(void)
+{
+    sfDevXM125Sim distanceSims[2];
+    sfDevXM125Distance distances[2];
+    sfDevXM125Scheduler<sfDevXM125Distance, 2> distanceScheduler;
+
+    sfDevXM125Sim presenceSims[2] = {sfDevXM125Sim(XM125_SIM_PRESENCE), sfDevXM125Sim(XM125_SIM_PRESENCE)};
+    sfDevXM125Presence presences[2];
+    sfDevXM125Scheduler<sfDevXM125Presence, 2> presenceScheduler;
+
+    bool passed = true;
+
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        const uint32_t distance = 1000u + 500u * i;
+        const int32_t strength = 4000;
+        distanceSims[i].setTargets(&distance, &strength, 1);
+        presenceSims[i].setPresence(true, 1200, 1500, 900);
+
+        uint8_t index;
+        passed = passed && distances[i].begin(&distanceSims[i]) == ksfTkErrOk &&
+                 distances[i].distanceSetup(500, 3000) == ksfTkErrOk &&
+                 distanceScheduler.addSensor(distances[i], index) == ksfTkErrOk && index == i;
+
+        passed = passed && presences[i].begin(&presenceSims[i]) == ksfTkErrOk &&
+                 presences[i].detectorStart(300, 2500) == ksfTkErrOk &&
+                 presenceScheduler.addSensor(presences[i], index, true) == ksfTkErrOk && index == i;
+    }
+
+    readouts_t distanceReadouts = {};
+    readouts_t presenceReadouts = {};
+
+    if (passed)
+    {
+        distanceScheduler.startAll();
+        run(distanceScheduler, readDistance, distanceReadouts);
+
+        presenceScheduler.startAll();
+        run(presenceScheduler, readPresence, presenceReadouts);
+    }
+
+    // A free running module is read once per frame - never more often than it measured
+    uint32_t presenceFrames = presenceSims[0].measureCounter();
+
+    passed = passed && distanceReadouts.frames[0] > 0 && distanceReadouts.frames[1] > 0 &&
+             distanceReadouts.wrong == 0 && presenceReadouts.frames[0] > 0 && presenceReadouts.frames[1] > 0 &&
+             presenceReadouts.frames[0] <= presenceFrames && presenceReadouts.wrong == 0;
+    for (uint8_t i = 0; i < 2; i++)
+        passed = passed && distanceScheduler.lastError(i) == ksfTkErrOk && presenceScheduler.lastError(i) == ksfTkErrOk;
+
+    printf("scheduler: %lu and %lu distance frames, %lu and %lu presence frames of %lu, %lu wrong - %s\n",
+           (unsigned long)distanceReadouts.frames[0], (unsigned long)distanceReadouts.frames[1],
+           (unsigned long)presenceReadouts.frames[0], (unsigned long)presenceReadouts.frames[1],
+           (unsigned long)presenceFrames, (unsigned long)(distanceReadouts.wrong + presenceReadouts.wrong),
+           passed ? "ok" : "FAILED");
+
+    return passed;
+}
+
+//--------------------------------------------------------------------------------
+int main(void)
+{
+    bool passed = checkDistance();
+    passed = checkPresence() && passed;
+    passed = checkManager() && passed;
+    passed = checkScheduler() && passed;
+
+    return passed ? 0 : 1;
+}
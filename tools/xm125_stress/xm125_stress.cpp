@@ -0,0 +1,265 @@
+/**
+ * @file xm125_stress.cpp
+ * @brief Host stress test of the SparkFun Qwiic XM125  Library ring buffers and seqlock.
+ *
+ * Runs a producer and a consumer thread against sfDevXM125SpscRingBuffer, and a writer and a
+ * reader thread against sfDevXM125Seqlock - the two ways sfDevXM125Worker hands frames from one
+ * core to the other. Every frame is filled from its sequence number, so a torn copy shows up as
+ * words that do not match. The queue must deliver every frame once and in order; the seqlock must
+ * only return whole frames, never older than one returned before. The single context
+ * sfDevXM125RingBuffer is checked first, without threads.
+ *
+ * The results are printed to stdout. The exit status is 1 if any check failed. Run it on a host with
+ * several cores - on a single core the two threads seldom overlap.
+ *
+ * Build on the host from this directory:
+ *
+ *     g++ -O2 -pthread -I../../src/sfTk -o xm125_stress xm125_stress.cpp
+ *
+ * Usage:
+ *
+ *     ./xm125_stress [frames]
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+#include "sfDevXM125Atomic.h"
+#include "sfDevXM125RingBuffer.h"
+
+// Default number of frames sent through each structure
+static const unsigned long kFramesDefault = 1000000;
+
+// Words of a frame besides its sequence number - about the size of a distance frame
+static const uint8_t kFrameWords = 15;
+
+// Queue length - short, so the producer often finds it full
+static const uint8_t kQueueLength = 8;
+
+// Frames the seqlock writer stores before it yields, so the reader also gets to run on a single core
+static const uint32_t kWriterBurst = 256;
+
+// A frame filled from its sequence number
+typedef struct
+{
+    uint32_t sequence;
+    uint32_t words[kFrameWords];
+} stress_frame_t;
+
+//--------------------------------------------------------------------------------
+static void fillFrame(stress_frame_t &frame, uint32_t sequence)
+{
+    frame.sequence = sequence;
+    for (uint8_t i = 0; i < kFrameWords; i++)
+        frame.words[i] = sequence * 2654435761u + i;
+}
+
+//--------------------------------------------------------------------------------
+static bool frameIntact(const stress_frame_t &frame)
+{
+    for (uint8_t i = 0; i < kFrameWords; i++)
+    {
+        if (frame.words[i] != frame.sequence * 2654435761u + i)
+            return false;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------
+// Fills a full buffer with overwrite set. Reserving twice before a commit must drop one item only,
+// and a reserve without a commit none.
+static bool checkRingBuffer(void)
+{
+    sfDevXM125RingBuffer<stress_frame_t, kQueueLength> buffer;
+    buffer.setOverwrite(true);
+
+    stress_frame_t frame;
+    for (uint32_t sequence = 1; sequence <= kQueueLength; sequence++)
+    {
+        fillFrame(frame, sequence);
+        buffer.push(frame);
+    }
+
+    bool passed = buffer.full() && buffer.dropped() == 0;
+
+    // Reserved but never committed - nothing is dropped
+    buffer.reserve();
+    passed = passed && buffer.size() == kQueueLength && buffer.dropped() == 0 && buffer.front()->sequence == 1;
+
+    // Reserved twice, then committed - only the oldest item is dropped
+    buffer.reserve();
+    stress_frame_t *slot = buffer.reserve();
+    fillFrame(*slot, kQueueLength + 1);
+    buffer.commit();
+
+    passed = passed && buffer.size() == kQueueLength && buffer.dropped() == 1;
+    for (uint16_t i = 0; passed && i < buffer.size(); i++)
+        passed = buffer.at(i).sequence == i + 2u && frameIntact(buffer.at(i));
+
+    // Without overwrite, a full buffer refuses the item and a stray commit changes nothing
+    buffer.setOverwrite(false);
+    passed = passed && buffer.reserve() == nullptr && buffer.dropped() == 2;
+    buffer.commit();
+    passed = passed && buffer.size() == kQueueLength && buffer.front()->sequence == 2;
+
+    printf("buffer:  reserve / commit on a full buffer, %lu dropped - %s\n", (unsigned long)buffer.dropped(),
+           passed ? "ok" : "FAILED");
+
+    return passed;
+}
+
+//--------------------------------------------------------------------------------
+// The producer pushes frames 1 to count, retrying while the queue is full. The consumer takes them
+// alternately with pop() and with peek() / consume().
+static bool stressQueue(uint32_t count)
+{
+    sfDevXM125SpscRingBuffer<stress_frame_t, kQueueLength> queue;
+
+    std::thread producer([&queue, count] {
+        stress_frame_t frame;
+
+        for (uint32_t sequence = 1; sequence <= count; sequence++)
+        {
+            fillFrame(frame, sequence);
+            while (!queue.push(frame))
+                std::this_thread::yield();
+        }
+    });
+
+    uint32_t expected = 1;
+    uint32_t received = 0;
+    unsigned long lost = 0;
+    unsigned long torn = 0;
+    bool usePeek = false;
+
+    // Count the frames taken rather than follow their sequence numbers, so a broken queue still ends
+    while (received < count)
+    {
+        stress_frame_t frame;
+        uint8_t taken = 0;
+
+        if (usePeek)
+        {
+            sfDevXM125Span<const stress_frame_t> span = queue.peek();
+            for (uint16_t i = 0; i < span.size; i++)
+            {
+                const stress_frame_t &peeked = span.data[i];
+                lost += peeked.sequence != expected ? 1 : 0;
+                torn += frameIntact(peeked) ? 0 : 1;
+                expected = peeked.sequence + 1;
+            }
+            taken = (uint8_t)span.size;
+            queue.consume(taken);
+            received += taken;
+        }
+        else if (queue.pop(frame))
+        {
+            lost += frame.sequence != expected ? 1 : 0;
+            torn += frameIntact(frame) ? 0 : 1;
+            expected = frame.sequence + 1;
+            taken = 1;
+            received++;
+        }
+
+        if (taken == 0)
+            std::this_thread::yield();
+        usePeek = !usePeek;
+    }
+
+    producer.join();
+
+    bool passed = lost == 0 && torn == 0 && queue.empty();
+    printf("queue:   %lu frames, %lu out of order, %lu torn, %lu left, %lu pushes on a full queue - %s\n",
+           (unsigned long)count, lost, torn, (unsigned long)queue.size(), (unsigned long)queue.dropped(),
+           passed ? "ok" : "FAILED");
+
+    return passed;
+}
+
+//--------------------------------------------------------------------------------
+// The writer stores frames 1 to count as fast as it can, the reader copies the latest until the
+// writer is done. Once the writer is done, the reader must see the last frame.
+static bool stressSeqlock(uint32_t count)
+{
+    sfDevXM125Seqlock<stress_frame_t> latest;
+    sfDevXM125Atomic<uint8_t> done;
+
+    std::thread writer([&latest, &done, count] {
+        stress_frame_t frame;
+
+        for (uint32_t sequence = 1; sequence <= count; sequence++)
+        {
+            fillFrame(frame, sequence);
+            latest.write(frame);
+
+            if (sequence % kWriterBurst == 0)
+                std::this_thread::yield();
+        }
+        done.store(1);
+    });
+
+    uint32_t last = 0;
+    unsigned long reads = 0;
+    unsigned long busy = 0;
+    unsigned long torn = 0;
+    unsigned long backwards = 0;
+    stress_frame_t frame;
+
+    while (done.load() == 0)
+    {
+        // Nothing written yet - the version does not wrap around within the run
+        if (latest.version() == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // On a single core the writer may have been preempted mid-write - let it finish
+        if (!latest.read(frame))
+        {
+            busy++;
+            std::this_thread::yield();
+            continue;
+        }
+
+        reads++;
+        torn += frameIntact(frame) ? 0 : 1;
+        backwards += frame.sequence < last ? 1 : 0;
+        last = frame.sequence;
+    }
+
+    writer.join();
+
+    bool final = latest.read(frame) && frame.sequence == count && frameIntact(frame);
+
+    bool passed = reads > 0 && torn == 0 && backwards == 0 && final;
+    printf("seqlock: %lu frames, %lu reads, %lu torn, %lu older, %lu retried out, last frame %s - %s\n",
+           (unsigned long)count, reads, torn, backwards, busy, final ? "seen" : "missing",
+           passed ? "ok" : "FAILED");
+
+    return passed;
+}
+
+//--------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    unsigned long frames = argc > 1 ? strtoul(argv[1], nullptr, 10) : kFramesDefault;
+    if (frames == 0 || frames > UINT32_MAX)
+    {
+        fprintf(stderr, "usage: %s [frames]\n", argv[0]);
+        return 2;
+    }
+
+    bool passed = checkRingBuffer();
+    passed = stressQueue((uint32_t)frames) && passed;
+    passed = stressSeqlock((uint32_t)frames) && passed;
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file xm125_track.cpp
+ * @brief Host replay and benchmark of the SparkFun Qwiic XM125  Library peak tracker.
+ *
+ * Reads a recorded packet stream written by sfDevXM125PacketEncoder (see Example12_DistanceBinaryStream)
+ * from stdin, runs the distance frames through sfDevXM125PeakTracker and prints one CSV line per
+ * confirmed track and frame to stdout. At the end of the stream the recorded frames are replayed
+ * through a fresh tracker a number of times, and the time per frame is printed to stderr.
+ *
+ * Build on the host from this directory:
+ *
+ *     g++ -O2 -I../../src/sfTk -o xm125_track xm125_track.cpp ../../src/sfTk/sfDevXM125Packet.cpp \
+ *         ../../src/sfTk/sfDevXM125PeakTracker.cpp
+ *
+ * Usage - record the stream once, then replay it:
+ *
+ *     stty -F /dev/ttyACM0 921600 raw && cat /dev/ttyACM0 > frames.bin
+ *     ./xm125_track [replays] < frames.bin
+ *
+ * @author SparkFun Electronics
+ * @date 2024-2025
+ * @copyright Copyright (c) 2024-2025, SparkFun Electronics Inc. This project is released under the MIT License.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "sfDevXM125Packet.h"
+#include "sfDevXM125PeakTracker.h"
+
+// Default number of replays of the recorded frames for the benchmark
+static const unsigned long kReplaysDefault = 1000;
+
+//--------------------------------------------------------------------------------
+static void printTracks(const sfe_xm125_packet_frame_t &frame, sfDevXM125PeakTracker &tracker)
+{
+    for (uint8_t i = 0; i < tracker.numTracks(); i++)
+    {
+        const sfe_xm125_track_t &track = tracker.track(i);
+        if (!track.confirmed)
+            continue;
+
+        printf("track,%lu,%lu,%u,%u,%d,%.2f,%u\n", (unsigned long)frame.measure_counter,
+               (unsigned long)frame.timestamp, track.id, track.distance, track.velocity, track.strength / 100.0,
+               track.misses);
+    }
+}
+
+//--------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    unsigned long replays = argc > 1 ? strtoul(argv[1], nullptr, 10) : kReplaysDefault;
+
+    sfDevXM125PacketDecoder decoder;
+    sfDevXM125PeakTracker tracker;
+    std::vector<sfe_xm125_packet_frame_t> frames;
+    int c;
+
+    while ((c = getchar()) != EOF)
+    {
+        if (!decoder.feed((uint8_t)c))
+            continue;
+
+        const sfe_xm125_packet_frame_t &frame = decoder.frame();
+        if (frame.type != SFE_XM125_PACKET_TYPE_DISTANCE)
+            continue;
+
+        frames.push_back(frame);
+        tracker.update(frame);
+        printTracks(frame, tracker);
+    }
+
+    fprintf(stderr, "frames: %lu, crc errors: %lu, format errors: %lu\n", (unsigned long)frames.size(),
+            (unsigned long)decoder.crcErrors(), (unsigned long)decoder.formatErrors());
+
+    if (frames.empty() || replays == 0)
+        return 0;
+
+    // Replay the recording, with the timestamps of a single pass
+    unsigned long updates = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned long r = 0; r < replays; r++)
+    {
+        tracker.reset();
+        for (size_t i = 0; i < frames.size(); i++)
+            updates += tracker.update(frames[i]);
+    }
+
+    double elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    fprintf(stderr, "replays: %lu, %.3f us per frame, %.2f confirmed tracks per frame\n", replays,
+            elapsedUs / ((double)replays * frames.size()), (double)updates / ((double)replays * frames.size()));
+
+    return 0;
+}